@@ -0,0 +1,119 @@
+#include <simd/bit_vector.h>
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <vector>
+
+namespace {
+
+// the reduction every accumulation kernel used to end with
+inline float hadd_permute_reduce(simd::f32x8 v) {
+    // [01, 23, 01, 23, 45, 67, 45, 67]
+    auto pairs = simd::hadd(v, v);
+    // [0123 x4, 4567 x4]
+    auto quads = simd::hadd(pairs, pairs);
+    auto total
+            = quads + simd::permute4x64(quads, simd::control4<2, 3, 0, 1>());
+    return _mm256_cvtss_f32(total.data);
+}
+
+inline int32_t hadd_permute_reduce(simd::i32x8 v) {
+    auto pairs = simd::hadd(v, v);
+    auto quads = simd::hadd(pairs, pairs);
+    auto total
+            = quads + simd::permute4x64(quads, simd::control4<2, 3, 0, 1>());
+    return _mm256_cvtsi256_si32(total.data);
+}
+
+inline float hadd_reduce(simd::f32x4 v) {
+    auto pairs = simd::hadd(v, v);
+    return _mm_cvtss_f32(simd::hadd(pairs, pairs).data);
+}
+
+inline int32_t hadd_reduce(simd::i32x4 v) {
+    auto pairs = simd::hadd(v, v);
+    return _mm_cvtsi128_si32(simd::hadd(pairs, pairs).data);
+}
+
+// reduces every register of a 16 KiB buffer
+template <typename T, typename Reduce>
+void reduce_buffer(benchmark::State& state, Reduce reduce) {
+    using SourceT = decltype(reduce(T{}));
+
+    std::vector<SourceT> values(4096);
+    std::iota(values.begin(), values.end(), SourceT(0));
+
+    while (state.KeepRunning()) {
+        SourceT sum = 0;
+        for (size_t i = 0; i < values.size(); i += T::size) {
+            sum += reduce(T::load(simd::as_unaligned_view(&values[i])));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * values.size() / T::size);
+}
+
+}  // namespace
+
+static void BM_reduce_add_f32x8(benchmark::State& state) {
+    reduce_buffer<simd::f32x8>(
+            state, [](simd::f32x8 v) { return simd::reduce_add(v); });
+}
+BENCHMARK(BM_reduce_add_f32x8);
+
+static void BM_hadd_permute_f32x8(benchmark::State& state) {
+    reduce_buffer<simd::f32x8>(
+            state, [](simd::f32x8 v) { return hadd_permute_reduce(v); });
+}
+BENCHMARK(BM_hadd_permute_f32x8);
+
+static void BM_reduce_add_i32x8(benchmark::State& state) {
+    reduce_buffer<simd::i32x8>(
+            state, [](simd::i32x8 v) { return simd::reduce_add(v); });
+}
+BENCHMARK(BM_reduce_add_i32x8);
+
+static void BM_hadd_permute_i32x8(benchmark::State& state) {
+    reduce_buffer<simd::i32x8>(
+            state, [](simd::i32x8 v) { return hadd_permute_reduce(v); });
+}
+BENCHMARK(BM_hadd_permute_i32x8);
+
+static void BM_reduce_add_f32x4(benchmark::State& state) {
+    reduce_buffer<simd::f32x4>(
+            state, [](simd::f32x4 v) { return simd::reduce_add(v); });
+}
+BENCHMARK(BM_reduce_add_f32x4);
+
+static void BM_hadd_f32x4(benchmark::State& state) {
+    reduce_buffer<simd::f32x4>(
+            state, [](simd::f32x4 v) { return hadd_reduce(v); });
+}
+BENCHMARK(BM_hadd_f32x4);
+
+static void BM_reduce_add_i32x4(benchmark::State& state) {
+    reduce_buffer<simd::i32x4>(
+            state, [](simd::i32x4 v) { return simd::reduce_add(v); });
+}
+BENCHMARK(BM_reduce_add_i32x4);
+
+static void BM_hadd_i32x4(benchmark::State& state) {
+    reduce_buffer<simd::i32x4>(
+            state, [](simd::i32x4 v) { return hadd_reduce(v); });
+}
+BENCHMARK(BM_hadd_i32x4);
+
+static void BM_reduce_max_f32x8(benchmark::State& state) {
+    reduce_buffer<simd::f32x8>(
+            state, [](simd::f32x8 v) { return simd::reduce_max(v); });
+}
+BENCHMARK(BM_reduce_max_f32x8);
+
+static void BM_reduce_min_i32x8(benchmark::State& state) {
+    reduce_buffer<simd::i32x8>(
+            state, [](simd::i32x8 v) { return simd::reduce_min(v); });
+}
+BENCHMARK(BM_reduce_min_i32x8);
+
+BENCHMARK_MAIN();
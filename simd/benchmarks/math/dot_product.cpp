@@ -1,3 +1,5 @@
+#include <simd/dispatch.h>
+#include <simd/math/dispatch.h>
 #include <simd/math/dot_product.h>
 #include <simd/math/vector2.h>
 #include <simd/memory.h>
@@ -5,44 +7,55 @@
 #include <benchmark/benchmark.h>
 
 #include <cstdlib>
+#include <map>
+#include <memory>
+#include <numeric>
 #include <random>
+#include <string>
+#include <thread>
+#include <vector>
 
-void gen_vectors(simd::math::vector2f* vectors, size_t n) {
+template <typename T>
+void gen_vectors(simd::math::vector2<T>* vectors, size_t n) {
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> dis(-10000.0f, 10000.0f);
+    std::uniform_real_distribution<T> dis(-10000.0, 10000.0);
     for (size_t i = 0; i < n; ++i) {
         vectors[i].x = dis(gen);
         vectors[i].y = dis(gen);
     }
 }
 
+template <typename T = float>
 struct test_data {
-    simd::math::vector2f* a = nullptr;
-    simd::math::vector2f* b = nullptr;
-    float* out              = nullptr;
-
-    test_data(size_t n) {
-        a = simd::aligned_alloc<simd::math::vector2f>(
-                32, sizeof(simd::math::vector2f) * n);
-        b = simd::aligned_alloc<simd::math::vector2f>(
-                32, sizeof(simd::math::vector2f) * n);
-        out = simd::aligned_alloc<float>(32, sizeof(float) * n);
+    simd::aligned_buffer<char, 32> a_storage;
+    simd::aligned_buffer<char, 32> b_storage;
+    simd::aligned_buffer<char, 32> out_storage;
+
+    simd::math::vector2<T>* a = nullptr;
+    simd::math::vector2<T>* b = nullptr;
+    T* out                    = nullptr;
+
+    // offset shifts every buffer by the given number of bytes past a 32-byte
+    // boundary
+    test_data(size_t n, size_t offset = 0)
+            : a_storage(sizeof(simd::math::vector2<T>) * n + offset)
+            , b_storage(sizeof(simd::math::vector2<T>) * n + offset)
+            , out_storage(sizeof(T) * n + offset) {
+        a   = reinterpret_cast<simd::math::vector2<T>*>(
+                a_storage.data() + offset);
+        b   = reinterpret_cast<simd::math::vector2<T>*>(
+                b_storage.data() + offset);
+        out = reinterpret_cast<T*>(out_storage.data() + offset);
         gen_vectors(a, n);
         gen_vectors(b, n);
     }
-
-    ~test_data() {
-        free(a);
-        free(b);
-        free(out);
-    }
 };
 
 static void BM_dot_product_n_aligned(benchmark::State& state) {
     const size_t n = state.range(0);
 
-    test_data data{n};
+    test_data<> data{n};
 
     while (state.KeepRunning()) {
         dot_product_n(
@@ -63,7 +76,7 @@ BENCHMARK(BM_dot_product_n_aligned)->Range(2, 16192);
 
 template <size_t I>
 static void BM_dot_product_impl(benchmark::State& state) {
-    test_data data{I};
+    test_data<> data{I};
 
     while (state.KeepRunning()) {
         dot_product_n(
@@ -113,7 +126,7 @@ BENCHMARK(BM_dot_product_n_aligned_static_16192);
 static void BM_dot_product_n_unaligned(benchmark::State& state) {
     const size_t n = state.range(0);
 
-    test_data data{n};
+    test_data<> data{n};
 
     while (state.KeepRunning()) {
         dot_product_n(
@@ -132,10 +145,41 @@ static void BM_dot_product_n_unaligned(benchmark::State& state) {
 
 BENCHMARK(BM_dot_product_n_unaligned)->Range(2, 16192);
 
+static void BM_dot_product_n_unaligned_offset(benchmark::State& state) {
+    const size_t n      = state.range(0);
+    const size_t offset = state.range(1);
+
+    test_data<> data{n, offset};
+
+    while (state.KeepRunning()) {
+        dot_product_n(
+                simd::as_unaligned_view(data.a),
+                simd::as_unaligned_view(data.b),
+                simd::as_unaligned_view(data.out),
+                n);
+
+        benchmark::DoNotOptimize(data.a);
+        benchmark::DoNotOptimize(data.b);
+        benchmark::DoNotOptimize(data.out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void unaligned_offsets(benchmark::internal::Benchmark* b) {
+    for (int offset : {4, 8, 12, 16}) {
+        for (int n : {8, 64, 512, 4096, 16192}) {
+            b->Args({n, offset});
+        }
+    }
+}
+
+BENCHMARK(BM_dot_product_n_unaligned_offset)->Apply(unaligned_offsets);
+
 static void BM_dot_product_naive(benchmark::State& state) {
     const size_t n = state.range(0);
 
-    test_data data{n};
+    test_data<> data{n};
 
     while (state.KeepRunning()) {
         for (size_t i = 0; i < n; ++i) {
@@ -152,4 +196,529 @@ static void BM_dot_product_naive(benchmark::State& state) {
 
 BENCHMARK(BM_dot_product_naive)->Range(2, 16192);
 
+static void BM_dot_product_n_aligned_double(benchmark::State& state) {
+    const size_t n = state.range(0);
+
+    test_data<double> data{n};
+
+    while (state.KeepRunning()) {
+        dot_product_n(
+                simd::as_aligned_view<32>(data.a),
+                simd::as_aligned_view<32>(data.b),
+                simd::as_aligned_view<32>(data.out),
+                n);
+
+        benchmark::DoNotOptimize(data.a);
+        benchmark::DoNotOptimize(data.b);
+        benchmark::DoNotOptimize(data.out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_dot_product_n_aligned_double)->Range(2, 16192);
+
+static void BM_dot_product_n_unaligned_double(benchmark::State& state) {
+    const size_t n = state.range(0);
+
+    test_data<double> data{n, 8};
+
+    while (state.KeepRunning()) {
+        dot_product_n(
+                simd::as_unaligned_view(data.a),
+                simd::as_unaligned_view(data.b),
+                simd::as_unaligned_view(data.out),
+                n);
+
+        benchmark::DoNotOptimize(data.a);
+        benchmark::DoNotOptimize(data.b);
+        benchmark::DoNotOptimize(data.out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_dot_product_n_unaligned_double)->Range(2, 16192);
+
+static void BM_dot_product_naive_double(benchmark::State& state) {
+    const size_t n = state.range(0);
+
+    test_data<double> data{n};
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            data.out[i] = data.a[i].dot(data.b[i]);
+        }
+
+        benchmark::DoNotOptimize(data.a);
+        benchmark::DoNotOptimize(data.b);
+        benchmark::DoNotOptimize(data.out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_dot_product_naive_double)->Range(2, 16192);
+
+#ifdef __AVX2__
+template <typename Kernel>
+static void BM_dot_product_kernel(benchmark::State& state, Kernel kernel) {
+    const size_t n = state.range(0);
+
+    test_data<> data{n};
+
+    while (state.KeepRunning()) {
+        kernel(simd::as_unaligned_view(data.a),
+               simd::as_unaligned_view(data.b),
+               simd::as_unaligned_view(data.out),
+               n);
+
+        benchmark::DoNotOptimize(data.a);
+        benchmark::DoNotOptimize(data.b);
+        benchmark::DoNotOptimize(data.out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_dot_product_n_avx2(benchmark::State& state) {
+    BM_dot_product_kernel(state, simd::math::detail::dot_product_n_avx<float>);
+}
+
+BENCHMARK(BM_dot_product_n_avx2)->Range(2, 16192);
+#endif
+
+#ifdef __AVX512F__
+static void BM_dot_product_n_avx512(benchmark::State& state) {
+    BM_dot_product_kernel(state, simd::math::detail::dot_product_n_avx512<>);
+}
+
+BENCHMARK(BM_dot_product_n_avx512)->Range(2, 16192);
+#endif
+
+static void BM_dot_product_n_soa(benchmark::State& state) {
+    const size_t n = state.range(0);
+
+    test_data<> data{n};
+    auto a = simd::math::to_soa(simd::as_unaligned_view(data.a), n);
+    auto b = simd::math::to_soa(simd::as_unaligned_view(data.b), n);
+
+    while (state.KeepRunning()) {
+        dot_product_n(
+                a.view(),
+                b.view(),
+                simd::as_aligned_view<32>(data.out),
+                n);
+
+        benchmark::DoNotOptimize(a.x());
+        benchmark::DoNotOptimize(b.x());
+        benchmark::DoNotOptimize(data.out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_dot_product_n_soa)->Range(2, 16192);
+
+// what dot_product_sum replaces: every result goes through memory
+static void BM_dot_product_n_accumulate(benchmark::State& state) {
+    const size_t n = state.range(0);
+
+    test_data<> data{n};
+
+    while (state.KeepRunning()) {
+        dot_product_n(
+                simd::as_unaligned_view(data.a),
+                simd::as_unaligned_view(data.b),
+                simd::as_unaligned_view(data.out),
+                n);
+        float sum = std::accumulate(data.out, data.out + n, 0.f);
+
+        benchmark::DoNotOptimize(sum);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_dot_product_n_accumulate)->Range(8, 1 << 20);
+
+template <typename... Summation>
+static void BM_dot_product_sum_impl(
+        benchmark::State& state, Summation... summation) {
+    const size_t n = state.range(0);
+
+    test_data<> data{n};
+
+    while (state.KeepRunning()) {
+        float sum = dot_product_sum(
+                simd::as_unaligned_view(data.a),
+                simd::as_unaligned_view(data.b),
+                n,
+                summation...);
+
+        benchmark::DoNotOptimize(sum);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_dot_product_sum(benchmark::State& state) {
+    BM_dot_product_sum_impl(state);
+}
+BENCHMARK(BM_dot_product_sum)->Range(8, 1 << 20);
+
+static void BM_dot_product_sum_kahan(benchmark::State& state) {
+    BM_dot_product_sum_impl(state, simd::math::kahan);
+}
+BENCHMARK(BM_dot_product_sum_kahan)->Range(8, 1 << 20);
+
+static void BM_dot_product_sum_pairwise(benchmark::State& state) {
+    BM_dot_product_sum_impl(state, simd::math::pairwise);
+}
+BENCHMARK(BM_dot_product_sum_pairwise)->Range(8, 1 << 20);
+
+static void BM_dot_product_n_dispatch(benchmark::State& state) {
+    const size_t n    = state.range(0);
+    const auto target = static_cast<simd::isa>(state.range(1));
+
+    if (simd::force_isa(target) != target) {
+        state.SkipWithError("isa not supported by this cpu");
+        return;
+    }
+    state.SetLabel(simd::isa_name(target));
+
+    test_data<> data{n};
+
+    while (state.KeepRunning()) {
+        simd::math::dispatch::dot_product_n(
+                simd::as_unaligned_view(data.a),
+                simd::as_unaligned_view(data.b),
+                simd::as_unaligned_view(data.out),
+                n);
+
+        benchmark::DoNotOptimize(data.a);
+        benchmark::DoNotOptimize(data.b);
+        benchmark::DoNotOptimize(data.out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    simd::force_isa(simd::detect_isa());
+}
+
+static void dispatch_isas(benchmark::internal::Benchmark* b) {
+    for (auto target : {simd::isa::generic,
+                        simd::isa::sse4_2,
+                        simd::isa::avx2,
+                        simd::isa::avx512}) {
+        for (int n : {8, 512, 16192}) {
+            b->Args({n, static_cast<int>(target)});
+        }
+    }
+}
+
+BENCHMARK(BM_dot_product_n_dispatch)->Apply(dispatch_isas);
+
+// large arrays backed by each page size, optionally bound to a numa node
+static void BM_dot_product_n_pages(benchmark::State& state) {
+    using vector2f     = simd::math::vector2<float>;
+    const size_t n     = state.range(0);
+    const auto options = simd::page_options{
+            static_cast<simd::page_size>(state.range(1)),
+            static_cast<int>(state.range(2))};
+
+    simd::aligned_buffer<vector2f> a{n, options};
+    simd::aligned_buffer<vector2f> b{n, options};
+    simd::aligned_buffer<float> out{n, options};
+    gen_vectors(a.data(), n);
+    gen_vectors(b.data(), n);
+    simd::first_touch(simd::unaligned_view<float>(out), n, 1);
+
+    const char* names[] = {"standard", "transparent", "huge_2m", "huge_1g"};
+    state.SetLabel(
+            std::string(names[static_cast<int>(a.pages())])
+            + (options.numa_node < 0
+                       ? ""
+                       : " node " + std::to_string(options.numa_node)));
+
+    while (state.KeepRunning()) {
+        dot_product_n(a.view(), b.view(), out.view(), n);
+
+        benchmark::DoNotOptimize(a.data());
+        benchmark::DoNotOptimize(b.data());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(
+            state.iterations() * n * (2 * sizeof(vector2f) + sizeof(float)));
+}
+
+static void page_sizes(benchmark::internal::Benchmark* b) {
+    const int last_node = simd::numa_node_count() - 1;
+    for (int n : {1 << 20, 1 << 24}) {
+        for (auto pages :
+             {simd::page_size::standard,
+              simd::page_size::transparent,
+              simd::page_size::huge_2m,
+              simd::page_size::huge_1g}) {
+            b->Args({n, static_cast<int>(pages), -1});
+        }
+        // local and, on multi socket machines, remote placement
+        b->Args({n, static_cast<int>(simd::page_size::transparent), 0});
+        if (last_node > 0) {
+            b->Args({n,
+                     static_cast<int>(simd::page_size::transparent),
+                     last_node});
+        }
+    }
+}
+
+BENCHMARK(BM_dot_product_n_pages)->Apply(page_sizes);
+
+// arg 1 is the pool's concurrency; 1 runs the serial kernel
+static void BM_dot_product_n_parallel(benchmark::State& state) {
+    const size_t n           = state.range(0);
+    const size_t concurrency = state.range(1);
+
+    static std::map<size_t, std::unique_ptr<simd::thread_pool>> pools;
+    auto& pool = pools[concurrency];
+    if (!pool) {
+        pool = std::make_unique<simd::thread_pool>(concurrency);
+    }
+
+    simd::aligned_buffer<simd::math::vector2f> a{n};
+    simd::aligned_buffer<simd::math::vector2f> b{n};
+    simd::aligned_buffer<float> out{n};
+    gen_vectors(a.data(), n);
+    gen_vectors(b.data(), n);
+
+    while (state.KeepRunning()) {
+        dot_product_n(
+                a.view(),
+                b.view(),
+                out.view(),
+                n,
+                simd::math::parallel,
+                *pool);
+
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(
+            state.iterations() * n
+            * (2 * sizeof(simd::math::vector2f) + sizeof(float)));
+}
+
+static void parallel_scaling(benchmark::internal::Benchmark* b) {
+    const int hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (int n : {1 << 14, 1 << 16, 1 << 20, 1 << 24}) {
+        for (int threads = 1; threads < hardware; threads *= 2) {
+            b->Args({n, threads});
+        }
+        b->Args({n, hardware});
+    }
+}
+
+BENCHMARK(BM_dot_product_n_parallel)->Apply(parallel_scaling)->UseRealTime();
+
+// arg 1 selects regular (0) or streaming (1) stores; sizes run well past the
+// last level cache, where streaming saves the read for ownership of out
+static void BM_dot_product_n_streaming(benchmark::State& state) {
+    const size_t n     = state.range(0);
+    const bool stream  = state.range(1);
+    const auto options = simd::page_options{simd::page_size::transparent};
+
+    simd::aligned_buffer<simd::math::vector2f> a{n, options};
+    simd::aligned_buffer<simd::math::vector2f> b{n, options};
+    simd::aligned_buffer<float> out{n, options};
+    gen_vectors(a.data(), n);
+    gen_vectors(b.data(), n);
+    simd::first_touch(simd::unaligned_view<float>(out), n, 1);
+    state.SetLabel(stream ? "stream" : "store");
+
+    const size_t threshold = simd::streaming_threshold();
+    simd::set_streaming_threshold(SIZE_MAX);
+    while (state.KeepRunning()) {
+        if (stream) {
+            dot_product_n(
+                    a.view(), b.view(), out.view(), n, simd::math::streaming);
+        } else {
+            dot_product_n(a.view(), b.view(), out.view(), n);
+        }
+
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    simd::set_streaming_threshold(threshold);
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(
+            state.iterations() * n
+            * (2 * sizeof(simd::math::vector2f) + sizeof(float)));
+}
+
+static void streaming_stores(benchmark::internal::Benchmark* b) {
+    for (int n : {1 << 16, 1 << 20, 1 << 23, 1 << 25}) {
+        for (int stream : {0, 1}) {
+            b->Args({n, stream});
+        }
+    }
+}
+
+BENCHMARK(BM_dot_product_n_streaming)->Apply(streaming_stores);
+
+// arg 1 is the prefetch distance in elements, 0 leaving it to the hardware
+template <typename Kernel>
+static void BM_prefetch_sweep(benchmark::State& state, Kernel kernel) {
+    const size_t n = state.range(0);
+
+    test_data<> data{n};
+
+    const size_t distance = simd::prefetch_distance();
+    simd::set_prefetch_distance(state.range(1));
+    while (state.KeepRunning()) {
+        kernel(simd::as_unaligned_view(data.a),
+               simd::as_unaligned_view(data.b),
+               simd::as_unaligned_view(data.out),
+               n);
+
+        benchmark::ClobberMemory();
+    }
+    simd::set_prefetch_distance(distance);
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_dot_product_n_prefetch(benchmark::State& state) {
+    BM_prefetch_sweep(
+            state,
+            [](auto a, auto b, auto out, size_t n) {
+                dot_product_n(a, b, out, n);
+                benchmark::DoNotOptimize(out.get());
+            });
+}
+
+static void BM_dot_product_sum_prefetch(benchmark::State& state) {
+    BM_prefetch_sweep(state, [](auto a, auto b, auto, size_t n) {
+        benchmark::DoNotOptimize(dot_product_sum(a, b, n));
+    });
+}
+
+static void prefetch_distances(benchmark::internal::Benchmark* b) {
+    for (int n : {1 << 16, 1 << 22}) {
+        for (int distance : {0, 16, 32, 64, 128, 256, 512, 1024, 4096}) {
+            b->Args({n, distance});
+        }
+    }
+}
+
+BENCHMARK(BM_dot_product_n_prefetch)->Apply(prefetch_distances);
+BENCHMARK(BM_dot_product_sum_prefetch)->Apply(prefetch_distances);
+
+// position at offset 16 of a 48-byte record
+struct entity {
+    char header[16];
+    simd::math::vector2f position;
+    char tag[24];
+};
+
+struct gather_data {
+    std::vector<entity> entities;
+    std::vector<simd::math::vector2f> dense;
+    std::vector<int32_t> indices;
+    std::vector<float> out;
+
+    explicit gather_data(size_t n)
+            : entities(n), dense(n), indices(n), out(n) {
+        std::mt19937 gen(3);
+        gen_vectors(dense.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            entities[i].position = dense[n - 1 - i];
+            indices[i]           = gen() % n;
+        }
+    }
+};
+
+// arg 1 selects the gather kernel (0), a scalar loop (1) or copying into a
+// dense array for the contiguous kernel (2)
+static void BM_dot_product_n_strided(benchmark::State& state) {
+    const size_t n   = state.range(0);
+    const int method = state.range(1);
+    state.SetLabel(method == 0 ? "gather" : method == 1 ? "scalar" : "copy");
+
+    gather_data data{n};
+    auto positions = simd::as_strided_view(
+            data.entities.data(), &entity::position);
+    std::vector<simd::math::vector2f> copy(n);
+
+    while (state.KeepRunning()) {
+        if (method == 0) {
+            dot_product_n(
+                    positions,
+                    simd::as_strided_view(data.dense.data()),
+                    simd::as_unaligned_view(data.out.data()),
+                    n);
+        } else if (method == 1) {
+            for (size_t i = 0; i < n; ++i) {
+                data.out[i] = positions[i].dot(data.dense[i]);
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                copy[i] = positions[i];
+            }
+            dot_product_n(
+                    simd::as_unaligned_view(copy.data()),
+                    simd::as_unaligned_view(data.dense.data()),
+                    simd::as_unaligned_view(data.out.data()),
+                    n);
+        }
+
+        benchmark::DoNotOptimize(data.out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// sizes crossed with the Methods ways a benchmark computes the same products
+template <int Methods>
+static void gather_methods(benchmark::internal::Benchmark* b) {
+    for (int n : {64, 4096, 1 << 18}) {
+        for (int method = 0; method < Methods; ++method) {
+            b->Args({n, method});
+        }
+    }
+}
+
+BENCHMARK(BM_dot_product_n_strided)->Apply(gather_methods<3>);
+
+// arg 1 selects the gather kernel (0) or a scalar loop (1)
+static void BM_dot_product_n_indexed(benchmark::State& state) {
+    const size_t n   = state.range(0);
+    const int method = state.range(1);
+    state.SetLabel(method == 0 ? "gather" : "scalar");
+
+    gather_data data{n};
+    auto selected = simd::as_indexed_view(
+            data.dense.data(), data.indices.data());
+
+    while (state.KeepRunning()) {
+        if (method == 0) {
+            dot_product_n(
+                    selected,
+                    selected,
+                    simd::as_unaligned_view(data.out.data()),
+                    n);
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                data.out[i] = selected[i].dot(selected[i]);
+            }
+        }
+
+        benchmark::DoNotOptimize(data.out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_dot_product_n_indexed)->Apply(gather_methods<2>);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,81 @@
+#include <simd/math/filter.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+struct less_than {
+    float threshold;
+
+    bool operator()(float value) const { return value < threshold; }
+
+    template <typename SimdVector>
+    auto operator()(SimdVector v) const {
+        return simd::cmp_lt(v, SimdVector::broadcast(threshold));
+    }
+};
+
+// uniform in [0, 100), so keeping the values below range(1) keeps range(1)
+// percent of them
+std::vector<float> percentiles(size_t n) {
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> values{0.f, 100.f};
+    std::vector<float> in(n);
+    for (auto& value : in) {
+        value = values(rng);
+    }
+    return in;
+}
+
+}  // namespace
+
+static void BM_filter_n(benchmark::State& state) {
+    const size_t n       = state.range(0);
+    const auto in        = percentiles(n);
+    const less_than keep = {float(state.range(1))};
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(simd::math::filter_n(
+                simd::as_unaligned_view(const_cast<float*>(in.data())),
+                simd::as_unaligned_view(out.data()),
+                n,
+                keep));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// the loop filter_n replaces; its branch mispredicts most around 50%
+static void BM_filter_n_branchy(benchmark::State& state) {
+    const size_t n       = state.range(0);
+    const auto in        = percentiles(n);
+    const less_than keep = {float(state.range(1))};
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (keep(in[i])) {
+                out[count++] = in[i];
+            }
+        }
+        benchmark::DoNotOptimize(count);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void selectivities(benchmark::internal::Benchmark* benchmark) {
+    for (int percent : {1, 10, 25, 50, 75, 90, 99}) {
+        benchmark->Args({1 << 16, percent});
+    }
+}
+
+BENCHMARK(BM_filter_n)->Apply(selectivities);
+BENCHMARK(BM_filter_n_branchy)->Apply(selectivities);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+#include <simd/math/dot_product.h>
+#include <simd/math/matrix2_batch.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+using simd::math::affine2f;
+using simd::math::matrix2f;
+using simd::math::vector2f;
+
+static std::vector<vector2f> positions(size_t n) {
+    std::vector<vector2f> vectors(n);
+    for (size_t i = 0; i < n; ++i) {
+        vectors[i] = {float(i % 97) + 1.f, float(i % 89) - 44.f};
+    }
+    return vectors;
+}
+
+static std::vector<affine2f> transforms(size_t n) {
+    std::vector<affine2f> transforms(n);
+    for (size_t i = 0; i < n; ++i) {
+        transforms[i] = {
+                .linear      = matrix2f::rotation(float(i % 360)),
+                .translation = {float(i % 7), float(i % 5)}};
+    }
+    return transforms;
+}
+
+static const affine2f transform = {
+        .linear      = matrix2f::rotation(0.5f),
+        .translation = {3.f, -2.f}};
+
+// the same number of elements and the same traffic per element as
+// BM_transform_n, less the second vector2 written
+static void BM_dot_product_n(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = positions(n);
+    auto b         = positions(n);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        simd::math::dot_product_n(
+                simd::as_unaligned_view(a.data()),
+                simd::as_unaligned_view(b.data()),
+                simd::as_unaligned_view(out.data()),
+                n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_transform_n(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto in        = positions(n);
+    std::vector<vector2f> out(n);
+
+    while (state.KeepRunning()) {
+        simd::math::transform_n(
+                transform,
+                simd::as_unaligned_view(in.data()),
+                simd::as_unaligned_view(out.data()),
+                n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_transform_n_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const auto in  = positions(n);
+    std::vector<vector2f> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = transform * in[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_transform_n_each(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto in        = positions(n);
+    auto each      = transforms(n);
+    std::vector<vector2f> out(n);
+
+    while (state.KeepRunning()) {
+        simd::math::transform_n(
+                simd::as_unaligned_view(each.data()),
+                simd::as_unaligned_view(in.data()),
+                simd::as_unaligned_view(out.data()),
+                n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_transform_n_each_scalar(benchmark::State& state) {
+    const size_t n  = state.range(0);
+    const auto in   = positions(n);
+    const auto each = transforms(n);
+    std::vector<vector2f> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = each[i] * in[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_transform_n_soa(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const auto in  = positions(n);
+    auto soa       = simd::math::to_soa(
+            simd::as_unaligned_view(const_cast<vector2f*>(in.data())), n);
+    simd::math::vector2_soa<float> out{n};
+
+    while (state.KeepRunning()) {
+        simd::math::transform_n(transform, soa.view(), out.view(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_transform_n_soa_each(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const auto in  = positions(n);
+    auto each      = transforms(n);
+    auto soa       = simd::math::to_soa(
+            simd::as_unaligned_view(const_cast<vector2f*>(in.data())), n);
+    simd::math::vector2_soa<float> out{n};
+
+    while (state.KeepRunning()) {
+        simd::math::transform_n(
+                simd::as_unaligned_view(each.data()),
+                soa.view(),
+                out.view(),
+                n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_dot_product_n)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_transform_n)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_transform_n_scalar)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_transform_n_soa)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_transform_n_each)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_transform_n_each_scalar)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_transform_n_soa_each)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,166 @@
+#include <simd/math/matrix4_batch.h>
+#include <simd/memory.h>
+
+#include <benchmark/benchmark.h>
+
+using simd::math::matrix4f;
+using simd::math::vector4f;
+
+// 64 multiplies and 48 adds per matrix product, 16 and 12 per
+// matrix-vector product
+constexpr double matrix_flops = 112;
+constexpr double vector_flops = 28;
+
+static simd::aligned_buffer<matrix4f, 64> bones(size_t n) {
+    simd::aligned_buffer<matrix4f, 64> matrices{n};
+    for (size_t i = 0; i < n; ++i) {
+        const float s = 1.f + float(i % 7) / 8.f;
+        matrices[i]   = matrix4f::translation(float(i % 13), 1.f, -2.f)
+                      * matrix4f::scale(s, s, 1.f / s);
+        matrices[i].x_axis.y = float(i % 5) / 16.f;
+    }
+    return matrices;
+}
+
+static simd::aligned_buffer<vector4f, 64> vertices(size_t n) {
+    simd::aligned_buffer<vector4f, 64> vectors{n};
+    for (size_t i = 0; i < n; ++i) {
+        vectors[i] = {float(i % 97), float(i % 89) - 44.f, float(i % 7), 1.f};
+    }
+    return vectors;
+}
+
+static void report(benchmark::State& state, size_t n, double flops) {
+    state.SetItemsProcessed(state.iterations() * n);
+    state.counters["flops"] = benchmark::Counter(
+            double(state.iterations()) * n * flops,
+            benchmark::Counter::kIsRate);
+}
+
+// out[i] = a[i] * b[i], e.g. bone transforms times inverse bind poses
+static void BM_multiply_n(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = bones(n);
+    auto b         = bones(n);
+    simd::aligned_buffer<matrix4f, 64> out{n};
+
+    while (state.KeepRunning()) {
+        simd::math::multiply_n(a.view(), b.view(), out.view(), n);
+        benchmark::ClobberMemory();
+    }
+    report(state, n, matrix_flops);
+}
+
+// the scalar operators, left to the autovectorizer
+static void BM_multiply_n_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = bones(n);
+    auto b         = bones(n);
+    simd::aligned_buffer<matrix4f, 64> out{n};
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i] * b[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    report(state, n, matrix_flops);
+}
+
+BENCHMARK(BM_multiply_n)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_multiply_n_scalar)->Range(1 << 6, 1 << 16);
+
+// out[i] = m * in[i]
+static void BM_transform_n(benchmark::State& state) {
+    const size_t n      = state.range(0);
+    const matrix4f m    = bones(1)[0];
+    auto in             = vertices(n);
+    simd::aligned_buffer<vector4f, 64> out{n};
+
+    while (state.KeepRunning()) {
+        simd::math::transform_n(m, in.view(), out.view(), n);
+        benchmark::ClobberMemory();
+    }
+    report(state, n, vector_flops);
+}
+
+static void BM_transform_n_scalar(benchmark::State& state) {
+    const size_t n   = state.range(0);
+    const matrix4f m = bones(1)[0];
+    auto in          = vertices(n);
+    simd::aligned_buffer<vector4f, 64> out{n};
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = m * in[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    report(state, n, vector_flops);
+}
+
+BENCHMARK(BM_transform_n)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_transform_n_scalar)->Range(1 << 10, 1 << 20);
+
+// out[i] = m[i] * in[i], every vertex with its own skinning matrix
+static void BM_transform_each_n(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto m         = bones(n);
+    auto in        = vertices(n);
+    simd::aligned_buffer<vector4f, 64> out{n};
+
+    while (state.KeepRunning()) {
+        simd::math::transform_n(m.view(), in.view(), out.view(), n);
+        benchmark::ClobberMemory();
+    }
+    report(state, n, vector_flops);
+}
+
+static void BM_transform_each_n_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto m         = bones(n);
+    auto in        = vertices(n);
+    simd::aligned_buffer<vector4f, 64> out{n};
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = m[i] * in[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    report(state, n, vector_flops);
+}
+
+BENCHMARK(BM_transform_each_n)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_transform_each_n_scalar)->Range(1 << 6, 1 << 16);
+
+static void BM_transpose_n(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto in        = bones(n);
+    simd::aligned_buffer<matrix4f, 64> out{n};
+
+    while (state.KeepRunning()) {
+        simd::math::transpose_n(in.view(), out.view(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_transpose_n_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto in        = bones(n);
+    simd::aligned_buffer<matrix4f, 64> out{n};
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = in[i].transposed();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_transpose_n)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_transpose_n_scalar)->Range(1 << 6, 1 << 16);
+
+BENCHMARK_MAIN();
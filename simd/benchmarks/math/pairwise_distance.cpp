@@ -0,0 +1,149 @@
+#include <simd/math/pairwise_distance.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using simd::math::vector2f;
+
+// n points spread uniformly over a square of area n, so that a radius
+// squared of 10 holds about 31 neighbours of every point
+static std::vector<vector2f> points(size_t n, unsigned seed) {
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<float> component{
+            0.f, std::sqrt(float(n))};
+    std::vector<vector2f> vectors(n);
+    for (auto& v : vectors) {
+        v = {component(rng), component(rng)};
+    }
+    return vectors;
+}
+
+constexpr float radius_squared = 10.f;
+
+// the full n x n matrix; 64K x 64K would take 16 GiB, so the dense
+// benchmarks stop at 16K
+static void BM_pairwise_distance_squared(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = points(n, 1);
+    auto b         = points(n, 2);
+    std::vector<float> out(n * n);
+
+    while (state.KeepRunning()) {
+        simd::math::pairwise_distance_squared(
+                simd::as_unaligned_view(a.data()),
+                n,
+                simd::as_unaligned_view(b.data()),
+                n,
+                simd::as_unaligned_view(out.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+static void BM_pairwise_distance_squared_streaming(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = points(n, 1);
+    auto b         = points(n, 2);
+    std::vector<float> out(n * n);
+
+    while (state.KeepRunning()) {
+        simd::math::pairwise_distance_squared(
+                simd::as_unaligned_view(a.data()),
+                n,
+                simd::as_unaligned_view(b.data()),
+                n,
+                simd::as_unaligned_view(out.data()),
+                simd::math::streaming);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+// the double loop over the scalar operators, left to the autovectorizer
+static void BM_pairwise_distance_squared_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = points(n, 1);
+    auto b         = points(n, 2);
+    std::vector<float> out(n * n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                const vector2f d = a[i] - b[j];
+                out[i * n + j]   = d.dot(d);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+BENCHMARK(BM_pairwise_distance_squared)
+        ->RangeMultiplier(4)
+        ->Range(1 << 10, 1 << 14);
+BENCHMARK(BM_pairwise_distance_squared_streaming)
+        ->RangeMultiplier(4)
+        ->Range(1 << 10, 1 << 14);
+BENCHMARK(BM_pairwise_distance_squared_scalar)
+        ->RangeMultiplier(4)
+        ->Range(1 << 10, 1 << 14);
+
+// the neighbour query the threshold mode is meant for
+static void BM_pairs_within(benchmark::State& state) {
+    const size_t n        = state.range(0);
+    auto a                = points(n, 1);
+    auto b                = points(n, 2);
+    const size_t capacity = n * 64;
+    std::vector<int32_t> rows(capacity), columns(capacity);
+
+    size_t pairs = 0;
+    while (state.KeepRunning()) {
+        pairs = simd::math::pairwise_distance_squared(
+                simd::as_unaligned_view(a.data()),
+                n,
+                simd::as_unaligned_view(b.data()),
+                n,
+                radius_squared,
+                simd::as_unaligned_view(rows.data()),
+                simd::as_unaligned_view(columns.data()),
+                capacity);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+    state.counters["pairs"] = double(pairs);
+}
+
+static void BM_pairs_within_scalar(benchmark::State& state) {
+    const size_t n        = state.range(0);
+    auto a                = points(n, 1);
+    auto b                = points(n, 2);
+    const size_t capacity = n * 64;
+    std::vector<int32_t> rows(capacity), columns(capacity);
+
+    size_t pairs = 0;
+    while (state.KeepRunning()) {
+        pairs = 0;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                const vector2f d = a[i] - b[j];
+                if (d.dot(d) < radius_squared && pairs < capacity) {
+                    rows[pairs]    = int32_t(i);
+                    columns[pairs] = int32_t(j);
+                    ++pairs;
+                }
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+    state.counters["pairs"] = double(pairs);
+}
+
+BENCHMARK(BM_pairs_within)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_pairs_within_scalar)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
+BENCHMARK_MAIN();
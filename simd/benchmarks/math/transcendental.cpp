@@ -0,0 +1,162 @@
+#include <simd/math/transcendental.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template <typename T>
+T broadcast(float value) {
+    if constexpr (std::is_same_v<T, float>) {
+        return value;
+    } else {
+        return T::broadcast(value);
+    }
+}
+
+// arguments in the range the functions usually see, where sin and cos take
+// no slow path
+std::vector<float> arguments(size_t n, float low, float high) {
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> values{low, high};
+    std::vector<float> in(n);
+    for (auto& value : in) {
+        value = values(rng);
+    }
+    return in;
+}
+
+struct exp_function {
+    static constexpr float low  = -80.f;
+    static constexpr float high = 80.f;
+    template <typename T>
+    T operator()(T x) const {
+        using simd::math::exp;
+        using std::exp;
+        return exp(x);
+    }
+};
+
+struct log_function {
+    static constexpr float low  = 1e-30f;
+    static constexpr float high = 1e30f;
+    template <typename T>
+    T operator()(T x) const {
+        using simd::math::log;
+        using std::log;
+        return log(x);
+    }
+};
+
+struct sin_function {
+    static constexpr float low  = -100.f;
+    static constexpr float high = 100.f;
+    template <typename T>
+    T operator()(T x) const {
+        using simd::math::sin;
+        using std::sin;
+        return sin(x);
+    }
+};
+
+struct cos_function {
+    static constexpr float low  = -100.f;
+    static constexpr float high = 100.f;
+    template <typename T>
+    T operator()(T x) const {
+        using simd::math::cos;
+        using std::cos;
+        return cos(x);
+    }
+};
+
+// atan2(x, 1 - x), which sweeps every octant of the half plane
+struct atan2_function {
+    static constexpr float low  = -100.f;
+    static constexpr float high = 100.f;
+    template <typename T>
+    T operator()(T x) const {
+        using simd::math::atan2;
+        using std::atan2;
+        return atan2(x, broadcast<T>(1.f) - x);
+    }
+};
+
+}  // namespace
+
+template <typename Function>
+static void BM_f32x8(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto in        = arguments(n, Function::low, Function::high);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; i += 8) {
+            const auto x
+                    = simd::f32x8::load(simd::as_unaligned_view(&in[i]));
+            Function{}(x).store(simd::as_unaligned_view(&out[i]));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Function>
+static void BM_f32x4(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto in        = arguments(n, Function::low, Function::high);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; i += 4) {
+            const auto x
+                    = simd::f32x4::load(simd::as_unaligned_view(&in[i]));
+            Function{}(x).store(simd::as_unaligned_view(&out[i]));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// libm, one call per element
+template <typename Function>
+static void BM_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const auto in  = arguments(n, Function::low, Function::high);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = Function{}(in[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+
+BENCHMARK_TEMPLATE(BM_f32x8, exp_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_f32x4, exp_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_scalar, exp_function)->Arg(1 << 12);
+
+BENCHMARK_TEMPLATE(BM_f32x8, log_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_f32x4, log_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_scalar, log_function)->Arg(1 << 12);
+
+BENCHMARK_TEMPLATE(BM_f32x8, sin_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_f32x4, sin_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_scalar, sin_function)->Arg(1 << 12);
+
+BENCHMARK_TEMPLATE(BM_f32x8, cos_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_f32x4, cos_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_scalar, cos_function)->Arg(1 << 12);
+
+BENCHMARK_TEMPLATE(BM_f32x8, atan2_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_f32x4, atan2_function)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_scalar, atan2_function)->Arg(1 << 12);
+
+BENCHMARK_MAIN();
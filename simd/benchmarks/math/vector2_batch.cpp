@@ -0,0 +1,141 @@
+#include <simd/math/vector2_batch.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+using simd::math::vector2f;
+
+static std::vector<vector2f> positions(size_t n) {
+    std::vector<vector2f> vectors(n);
+    for (size_t i = 0; i < n; ++i) {
+        vectors[i] = {float(i % 97) + 1.f, float(i % 89) - 44.f};
+    }
+    return vectors;
+}
+
+// position += velocity * dt, the per tick update the kernels are meant for
+static void BM_update_positions(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto position  = positions(n);
+    auto velocity  = positions(n);
+    std::vector<vector2f> step(n);
+    const auto to = simd::as_unaligned_view(position.data());
+
+    while (state.KeepRunning()) {
+        simd::math::scale_n(
+                simd::as_unaligned_view(velocity.data()),
+                1.f / 60.f,
+                simd::as_unaligned_view(step.data()),
+                n);
+        simd::math::add_n(to, simd::as_unaligned_view(step.data()), to, n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_update_positions_lerp(benchmark::State& state) {
+    const size_t n  = state.range(0);
+    auto position   = positions(n);
+    auto target     = positions(n);
+    const auto from = simd::as_unaligned_view(target.data());
+    const auto to   = simd::as_unaligned_view(position.data());
+
+    while (state.KeepRunning()) {
+        simd::math::lerp_n(to, from, 1.f / 60.f, to, n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// the scalar operators, left to the autovectorizer
+static void BM_update_positions_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto position  = positions(n);
+    auto velocity  = positions(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            position[i] += velocity[i] * (1.f / 60.f);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_update_positions)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_update_positions_lerp)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_update_positions_scalar)->Range(1 << 10, 1 << 20);
+
+template <bool Approximate>
+static void BM_normalize_n(benchmark::State& state) {
+    const size_t n  = state.range(0);
+    auto in         = positions(n);
+    std::vector<vector2f> out(n);
+    const auto from = simd::as_unaligned_view(in.data());
+    const auto to   = simd::as_unaligned_view(out.data());
+
+    while (state.KeepRunning()) {
+        if constexpr (Approximate) {
+            simd::math::normalize_n(from, to, n, simd::math::approximate);
+        } else {
+            simd::math::normalize_n(from, to, n);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_normalize_n_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const auto in  = positions(n);
+    std::vector<vector2f> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            const float length = std::sqrt(in[i].dot(in[i]));
+            out[i] = length > 0 ? in[i] / length : vector2f{};
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK_TEMPLATE(BM_normalize_n, false)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_normalize_n, true)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_normalize_n_scalar)->Range(1 << 10, 1 << 20);
+
+static void BM_length_n(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto in        = positions(n);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        simd::math::length_n(
+                simd::as_unaligned_view(in.data()),
+                simd::as_unaligned_view(out.data()),
+                n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_length_n_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const auto in  = positions(n);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::sqrt(in[i].dot(in[i]));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_length_n)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_length_n_scalar)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
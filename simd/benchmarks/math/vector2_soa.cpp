@@ -0,0 +1,68 @@
+#include <simd/math/vector2_soa.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+template <typename T>
+static void BM_aos_to_soa(benchmark::State& state) {
+    const size_t n = state.range(0);
+
+    std::vector<simd::math::vector2<T>> aos(n, {T(1), T(2)});
+    simd::math::vector2_soa<T> soa{n};
+
+    while (state.KeepRunning()) {
+        simd::math::aos_to_soa(
+                simd::as_unaligned_view(aos.data()),
+                simd::math::unaligned_soa_view<T>(soa.view()),
+                n);
+
+        benchmark::DoNotOptimize(soa.x());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK_TEMPLATE(BM_aos_to_soa, float)->Range(8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_aos_to_soa, double)->Range(8, 1 << 20);
+
+template <typename T>
+static void BM_soa_to_aos(benchmark::State& state) {
+    const size_t n = state.range(0);
+
+    std::vector<simd::math::vector2<T>> aos(n);
+    simd::math::vector2_soa<T> soa{n};
+
+    while (state.KeepRunning()) {
+        simd::math::to_aos(soa, simd::as_unaligned_view(aos.data()));
+
+        benchmark::DoNotOptimize(aos.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK_TEMPLATE(BM_soa_to_aos, float)->Range(8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_soa_to_aos, double)->Range(8, 1 << 20);
+
+// the scalar loop the transpose replaces
+static void BM_aos_to_soa_naive(benchmark::State& state) {
+    const size_t n = state.range(0);
+
+    std::vector<simd::math::vector2f> aos(n, {1.f, 2.f});
+    simd::math::vector2_soa<float> soa{n};
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            soa.set(i, aos[i]);
+        }
+
+        benchmark::DoNotOptimize(soa.x());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_aos_to_soa_naive)->Range(8, 1 << 20);
+
+BENCHMARK_MAIN();
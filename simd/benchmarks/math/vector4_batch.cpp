@@ -0,0 +1,129 @@
+#include <simd/math/vector4_batch.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+using simd::math::vector4f;
+
+static std::vector<vector4f> directions(size_t n, float offset) {
+    std::vector<vector4f> vectors(n);
+    for (size_t i = 0; i < n; ++i) {
+        vectors[i] = {
+                float(i % 97) + offset,
+                float(i % 89) - 44.f,
+                float(i % 83) * offset,
+                1.f};
+    }
+    return vectors;
+}
+
+// the scalar loops are the vector4 operators, left to the autovectorizer
+
+static void BM_dot_product_n(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = directions(n, 1.f);
+    auto b         = directions(n, 2.f);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        simd::math::dot_product_n(
+                simd::as_unaligned_view(a.data()),
+                simd::as_unaligned_view(b.data()),
+                simd::as_unaligned_view(out.data()),
+                n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_dot_product_n_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = directions(n, 1.f);
+    auto b         = directions(n, 2.f);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i].dot(b[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_dot_product_n)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_dot_product_n_scalar)->Range(1 << 10, 1 << 20);
+
+static void BM_length_n(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = directions(n, 1.f);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        simd::math::length_n(
+                simd::as_unaligned_view(a.data()),
+                simd::as_unaligned_view(out.data()),
+                n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_length_n_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a         = directions(n, 1.f);
+    std::vector<float> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::sqrt(a[i].dot(a[i]));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_length_n)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_length_n_scalar)->Range(1 << 10, 1 << 20);
+
+template <bool Approximate>
+static void BM_normalize_n(benchmark::State& state) {
+    const size_t n  = state.range(0);
+    auto in         = directions(n, 1.f);
+    std::vector<vector4f> out(n);
+    const auto from = simd::as_unaligned_view(in.data());
+    const auto to   = simd::as_unaligned_view(out.data());
+
+    while (state.KeepRunning()) {
+        if constexpr (Approximate) {
+            simd::math::normalize_n(from, to, n, simd::math::approximate);
+        } else {
+            simd::math::normalize_n(from, to, n);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_normalize_n_scalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto in        = directions(n, 1.f);
+    std::vector<vector4f> out(n);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            const float length = std::sqrt(in[i].dot(in[i]));
+            out[i] = length > 0 ? in[i] / length : vector4f{};
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK_TEMPLATE(BM_normalize_n, false)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_normalize_n, true)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_normalize_n_scalar)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,73 @@
+#include <simd/memory.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdlib>
+
+// the scratch buffers a typical batch of kernels asks for
+constexpr std::array<size_t, 16> scratch_sizes{
+        64, 256, 1024, 48, 4096, 100, 512, 2000,
+        16, 8192, 640, 128, 3000, 32, 1536, 256};
+
+static void BM_malloc_scratch(benchmark::State& state) {
+    std::array<float*, scratch_sizes.size()> buffers;
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < scratch_sizes.size(); ++i) {
+            buffers[i] = simd::aligned_alloc<float>(
+                    64, scratch_sizes[i] * sizeof(float));
+            buffers[i][0] = float(i);
+            benchmark::DoNotOptimize(buffers[i]);
+        }
+        for (auto* buffer : buffers) {
+            free(buffer);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * scratch_sizes.size());
+}
+
+static void BM_arena_scratch(benchmark::State& state) {
+    auto& scratch = simd::thread_arena();
+    while (state.KeepRunning()) {
+        simd::arena_scope scope{scratch};
+        for (size_t i = 0; i < scratch_sizes.size(); ++i) {
+            auto buffer = scratch.allocate<float>(scratch_sizes[i]);
+            buffer[0]   = float(i);
+            benchmark::DoNotOptimize(buffer.data);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * scratch_sizes.size());
+}
+
+// cost of faulting in a fresh 64 MiB mapping, arg 0 is the page_size and
+// arg 1 the number of threads touching it
+static void BM_map_pages_first_touch(benchmark::State& state) {
+    const size_t size  = size_t(64) << 20;
+    const auto options = simd::page_options{
+            static_cast<simd::page_size>(state.range(0))};
+    while (state.KeepRunning()) {
+        auto mapping = simd::map_pages(size, options);
+        simd::first_touch(
+                simd::unaligned_view<char>{static_cast<char*>(mapping.data)},
+                size,
+                state.range(1));
+        simd::unmap_pages(mapping.data, mapping.size);
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+BENCHMARK(BM_malloc_scratch)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_arena_scratch)->ThreadRange(1, 32)->UseRealTime();
+static void page_sizes_and_threads(benchmark::internal::Benchmark* b) {
+    for (int pages : {0, 1, 2, 3}) {
+        for (int threads : {1, 4}) {
+            b->Args({pages, threads});
+        }
+    }
+}
+
+BENCHMARK(BM_map_pages_first_touch)
+        ->Apply(page_sizes_and_threads)
+        ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <simd/isa.h>
 #include <simd/view.h>
 
 #include <immintrin.h>
 
 #include <cstdint>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace simd {
+inline namespace SIMD_ISA_NAMESPACE {
 
 template <unsigned i0, unsigned i1, unsigned i2, unsigned i3>
 struct control4 : std::integral_constant<
@@ -19,6 +23,142 @@ struct control4 : std::integral_constant<
     static_assert(i3 < 4);
 };
 
+namespace detail {
+
+// the integer register of a Bits wide mask. std::conditional_t would pass
+// the vector types as template arguments, which drops their attributes
+template <size_t Bits>
+struct mask_register;
+
+template <>
+struct mask_register<128> {
+    using type = __m128i;
+};
+
+template <>
+struct mask_register<256> {
+    using type = __m256i;
+};
+
+}  // namespace detail
+
+// lane-wise mask for a bit_vector<Rep, Bits>, produced by comparisons and
+// consumed by select and the masked loads and stores; every lane has either
+// all bits set or all bits clear
+template <typename Rep, size_t Bits>
+struct bit_mask {
+    static_assert(Bits == 128 || Bits == 256);
+    static_assert(sizeof(Rep) == 4 || sizeof(Rep) == 8);
+
+    using register_type = typename detail::mask_register<Bits>::type;
+    register_type data;
+
+    static constexpr size_t size = Bits / 8 / sizeof(Rep);
+
+    // lanes [0, n) are set and the remaining lanes are clear
+    static bit_mask<Rep, Bits> first_n(size_t n) {
+        if constexpr (Bits == 128 && sizeof(Rep) == 4) {
+            return {_mm_cmpgt_epi32(
+                    _mm_set1_epi32(static_cast<int32_t>(n)),
+                    _mm_setr_epi32(0, 1, 2, 3))};
+        } else if constexpr (Bits == 128) {
+            return {_mm_cmpgt_epi64(
+                    _mm_set1_epi64x(static_cast<int64_t>(n)),
+                    _mm_set_epi64x(1, 0))};
+        } else if constexpr (sizeof(Rep) == 4) {
+            return {_mm256_cmpgt_epi32(
+                    _mm256_set1_epi32(static_cast<int32_t>(n)),
+                    _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))};
+        } else {
+            return {_mm256_cmpgt_epi64(
+                    _mm256_set1_epi64x(static_cast<int64_t>(n)),
+                    _mm256_set_epi64x(3, 2, 1, 0))};
+        }
+    }
+
+    friend bit_mask<Rep, Bits>
+    operator&(bit_mask<Rep, Bits> lhs, bit_mask<Rep, Bits> rhs) {
+        if constexpr (Bits == 128) {
+            return {_mm_and_si128(lhs.data, rhs.data)};
+        } else {
+            return {_mm256_and_si256(lhs.data, rhs.data)};
+        }
+    }
+
+    friend bit_mask<Rep, Bits>
+    operator|(bit_mask<Rep, Bits> lhs, bit_mask<Rep, Bits> rhs) {
+        if constexpr (Bits == 128) {
+            return {_mm_or_si128(lhs.data, rhs.data)};
+        } else {
+            return {_mm256_or_si256(lhs.data, rhs.data)};
+        }
+    }
+
+    friend bit_mask<Rep, Bits>
+    operator^(bit_mask<Rep, Bits> lhs, bit_mask<Rep, Bits> rhs) {
+        if constexpr (Bits == 128) {
+            return {_mm_xor_si128(lhs.data, rhs.data)};
+        } else {
+            return {_mm256_xor_si256(lhs.data, rhs.data)};
+        }
+    }
+
+    bit_mask<Rep, Bits> operator~() const {
+        if constexpr (Bits == 128) {
+            return {_mm_xor_si128(data, _mm_set1_epi32(-1))};
+        } else {
+            return {_mm256_xor_si256(data, _mm256_set1_epi32(-1))};
+        }
+    }
+
+    bool operator==(bit_mask<Rep, Bits> rhs) const {
+        return movemask(*this) == movemask(rhs);
+    }
+
+    // the same lanes for another Rep of the same width, e.g. to select
+    // int32_t indices by a float comparison
+    template <typename Other>
+    explicit operator bit_mask<Other, Bits>() const {
+        static_assert(sizeof(Other) == sizeof(Rep));
+        return {data};
+    }
+};
+
+// bit i is set when lane i is set
+template <typename Rep, size_t Bits>
+int movemask(bit_mask<Rep, Bits> mask) {
+    if constexpr (Bits == 128 && sizeof(Rep) == 4) {
+        return _mm_movemask_ps(_mm_castsi128_ps(mask.data));
+    } else if constexpr (Bits == 128) {
+        return _mm_movemask_pd(_mm_castsi128_pd(mask.data));
+    } else if constexpr (sizeof(Rep) == 4) {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(mask.data));
+    } else {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(mask.data));
+    }
+}
+
+template <typename Rep, size_t Bits>
+bool any(bit_mask<Rep, Bits> mask) {
+    return movemask(mask) != 0;
+}
+
+template <typename Rep, size_t Bits>
+bool all(bit_mask<Rep, Bits> mask) {
+    return movemask(mask) == (1 << bit_mask<Rep, Bits>::size) - 1;
+}
+
+template <typename Rep, size_t Bits>
+bool none(bit_mask<Rep, Bits> mask) {
+    return movemask(mask) == 0;
+}
+
+// number of set lanes
+template <typename Rep, size_t Bits>
+int popcount(bit_mask<Rep, Bits> mask) {
+    return __builtin_popcount(movemask(mask));
+}
+
 template <typename Rep, size_t Bits>
 struct bit_vector;
 
@@ -27,14 +167,22 @@ struct bit_vector<float, 128>;
 template <>
 struct bit_vector<float, 256>;
 template <>
+struct bit_vector<double, 128>;
+template <>
+struct bit_vector<double, 256>;
+template <>
 struct bit_vector<int32_t, 128>;
 template <>
 struct bit_vector<int32_t, 256>;
+template <>
+struct bit_vector<int64_t, 256>;
 
 template <>
 struct bit_vector<int32_t, 128> {
     __m128i data;
 
+    using mask_type = bit_mask<int32_t, 128>;
+
     static constexpr size_t width_bytes = 32;
     static constexpr size_t size        = 4;
 
@@ -43,6 +191,10 @@ struct bit_vector<int32_t, 128> {
         return {_mm_set_epi32(i0, i1, i2, i3)};
     }
 
+    static bit_vector<int32_t, 128> broadcast(int32_t value) {
+        return {_mm_set1_epi32(value)};
+    }
+
     static bit_vector<int32_t, 128> load(aligned_view<int32_t, 16> ptr) {
         return {_mm_load_si128(reinterpret_cast<__m128i*>(ptr.get()))};
     }
@@ -51,6 +203,12 @@ struct bit_vector<int32_t, 128> {
         return {_mm_loadu_si128(reinterpret_cast<__m128i*>(ptr.get()))};
     }
 
+    // masked out lanes are zeroed and never read
+    static bit_vector<int32_t, 128>
+    load(unaligned_view<int32_t> ptr, mask_type mask) {
+        return {_mm_maskload_epi32(ptr.get(), mask.data)};
+    }
+
     void store(aligned_view<int32_t, 16> ptr) const {
         _mm_store_si128(reinterpret_cast<__m128i*>(ptr.get()), data);
     }
@@ -59,8 +217,119 @@ struct bit_vector<int32_t, 128> {
         _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr.get()), data);
     }
 
+    void store(unaligned_view<int32_t> ptr, mask_type mask) const {
+        _mm_maskstore_epi32(ptr.get(), mask.data, data);
+    }
+
+    // non-temporal store that bypasses the caches; order it against later
+    // stores with stream_fence()
+    void stream(aligned_view<int32_t, 16> ptr) const {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(ptr.get()), data);
+    }
+
+    static mask_type first_n_mask(size_t n) {
+        return mask_type::first_n(n);
+    }
+
     explicit operator bit_vector<float, 128>() const;
 
+    // keeps the low 32 bits of each product
+    friend bit_vector<int32_t, 128>
+    operator*(bit_vector<int32_t, 128> lhs, bit_vector<int32_t, 128> rhs) {
+        return {_mm_mullo_epi32(lhs.data, rhs.data)};
+    }
+
+    bit_vector<int32_t, 128>& operator*=(bit_vector<int32_t, 128> rhs) {
+        data = _mm_mullo_epi32(data, rhs.data);
+        return *this;
+    }
+
+    friend bit_vector<int32_t, 128>
+    operator+(bit_vector<int32_t, 128> lhs, bit_vector<int32_t, 128> rhs) {
+        return {_mm_add_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 128>
+    operator-(bit_vector<int32_t, 128> lhs, bit_vector<int32_t, 128> rhs) {
+        return {_mm_sub_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 128>
+    operator&(bit_vector<int32_t, 128> lhs, bit_vector<int32_t, 128> rhs) {
+        return {_mm_and_si128(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 128>
+    operator|(bit_vector<int32_t, 128> lhs, bit_vector<int32_t, 128> rhs) {
+        return {_mm_or_si128(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 128>
+    operator^(bit_vector<int32_t, 128> lhs, bit_vector<int32_t, 128> rhs) {
+        return {_mm_xor_si128(lhs.data, rhs.data)};
+    }
+
+    bit_vector<int32_t, 128> operator-() const {
+        return {_mm_sub_epi32(_mm_setzero_si128(), data)};
+    }
+
+    // shifts every lane by the same number of bits; >> is arithmetic
+    friend bit_vector<int32_t, 128>
+    operator<<(bit_vector<int32_t, 128> lhs, int count) {
+        return {_mm_sll_epi32(lhs.data, _mm_cvtsi32_si128(count))};
+    }
+
+    friend bit_vector<int32_t, 128>
+    operator>>(bit_vector<int32_t, 128> lhs, int count) {
+        return {_mm_sra_epi32(lhs.data, _mm_cvtsi32_si128(count))};
+    }
+
+    // shifts each lane by the count in the matching lane of rhs
+    friend bit_vector<int32_t, 128>
+    operator<<(bit_vector<int32_t, 128> lhs, bit_vector<int32_t, 128> rhs) {
+        return {_mm_sllv_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 128>
+    operator>>(bit_vector<int32_t, 128> lhs, bit_vector<int32_t, 128> rhs) {
+        return {_mm_srav_epi32(lhs.data, rhs.data)};
+    }
+
+    bit_vector<int32_t, 128>& operator+=(bit_vector<int32_t, 128> rhs) {
+        data = _mm_add_epi32(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 128>& operator-=(bit_vector<int32_t, 128> rhs) {
+        data = _mm_sub_epi32(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 128>& operator&=(bit_vector<int32_t, 128> rhs) {
+        data = _mm_and_si128(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 128>& operator|=(bit_vector<int32_t, 128> rhs) {
+        data = _mm_or_si128(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 128>& operator^=(bit_vector<int32_t, 128> rhs) {
+        data = _mm_xor_si128(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 128>& operator<<=(int count) {
+        data = _mm_sll_epi32(data, _mm_cvtsi32_si128(count));
+        return *this;
+    }
+
+    bit_vector<int32_t, 128>& operator>>=(int count) {
+        data = _mm_sra_epi32(data, _mm_cvtsi32_si128(count));
+        return *this;
+    }
+
     bool operator==(bit_vector<int32_t, 128> rhs) const {
         __m128i result = _mm_xor_si128(data, rhs.data);
         return _mm_test_all_zeros(result, result);
@@ -71,6 +340,8 @@ template <>
 struct bit_vector<int32_t, 256> {
     __m256i data;
 
+    using mask_type = bit_mask<int32_t, 256>;
+
     static constexpr size_t width_bytes = 32;
     static constexpr size_t size        = 8;
 
@@ -86,6 +357,10 @@ struct bit_vector<int32_t, 256> {
         return {_mm256_set_epi32(i0, i1, i2, i3, i4, i5, i6, i7)};
     }
 
+    static bit_vector<int32_t, 256> broadcast(int32_t value) {
+        return {_mm256_set1_epi32(value)};
+    }
+
     static bit_vector<int32_t, 256> load(aligned_view<int32_t, 32> ptr) {
         return {_mm256_load_si256(reinterpret_cast<__m256i*>(ptr.get()))};
     }
@@ -94,6 +369,20 @@ struct bit_vector<int32_t, 256> {
         return {_mm256_loadu_si256(reinterpret_cast<__m256i*>(ptr.get()))};
     }
 
+    // masked out lanes are zeroed and never read
+    static bit_vector<int32_t, 256>
+    load(unaligned_view<int32_t> ptr, mask_type mask) {
+        return {_mm256_maskload_epi32(ptr.get(), mask.data)};
+    }
+
+    // lane i reads the int32_t at base + offsets[i] * Scale bytes; Scale is
+    // 1, 2, 4 or 8
+    template <int Scale = sizeof(int32_t)>
+    static bit_vector<int32_t, 256>
+    gather(unaligned_view<int32_t> base, bit_vector<int32_t, 256> offsets) {
+        return {_mm256_i32gather_epi32(base.get(), offsets.data, Scale)};
+    }
+
     void store(aligned_view<int32_t, 32> ptr) const {
         _mm256_store_si256(reinterpret_cast<__m256i*>(ptr.get()), data);
     }
@@ -102,13 +391,120 @@ struct bit_vector<int32_t, 256> {
         _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr.get()), data);
     }
 
+    void store(unaligned_view<int32_t> ptr, mask_type mask) const {
+        _mm256_maskstore_epi32(ptr.get(), mask.data, data);
+    }
+
+    void stream(aligned_view<int32_t, 32> ptr) const {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(ptr.get()), data);
+    }
+
+    static mask_type first_n_mask(size_t n) {
+        return mask_type::first_n(n);
+    }
+
     explicit operator bit_vector<float, 256>() const;
 
+    // keeps the low 32 bits of each product
+    friend bit_vector<int32_t, 256>
+    operator*(bit_vector<int32_t, 256> lhs, bit_vector<int32_t, 256> rhs) {
+        return {_mm256_mullo_epi32(lhs.data, rhs.data)};
+    }
+
+    bit_vector<int32_t, 256>& operator*=(bit_vector<int32_t, 256> rhs) {
+        data = _mm256_mullo_epi32(data, rhs.data);
+        return *this;
+    }
+
+    friend bit_vector<int32_t, 256>
+    operator+(bit_vector<int32_t, 256> lhs, bit_vector<int32_t, 256> rhs) {
+        return {_mm256_add_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 256>
+    operator-(bit_vector<int32_t, 256> lhs, bit_vector<int32_t, 256> rhs) {
+        return {_mm256_sub_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 256>
+    operator&(bit_vector<int32_t, 256> lhs, bit_vector<int32_t, 256> rhs) {
+        return {_mm256_and_si256(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 256>
+    operator|(bit_vector<int32_t, 256> lhs, bit_vector<int32_t, 256> rhs) {
+        return {_mm256_or_si256(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 256>
+    operator^(bit_vector<int32_t, 256> lhs, bit_vector<int32_t, 256> rhs) {
+        return {_mm256_xor_si256(lhs.data, rhs.data)};
+    }
+
+    bit_vector<int32_t, 256> operator-() const {
+        return {_mm256_sub_epi32(_mm256_setzero_si256(), data)};
+    }
+
+    // shifts every lane by the same number of bits; >> is arithmetic
+    friend bit_vector<int32_t, 256>
+    operator<<(bit_vector<int32_t, 256> lhs, int count) {
+        return {_mm256_sll_epi32(lhs.data, _mm_cvtsi32_si128(count))};
+    }
+
+    friend bit_vector<int32_t, 256>
+    operator>>(bit_vector<int32_t, 256> lhs, int count) {
+        return {_mm256_sra_epi32(lhs.data, _mm_cvtsi32_si128(count))};
+    }
+
+    // shifts each lane by the count in the matching lane of rhs
+    friend bit_vector<int32_t, 256>
+    operator<<(bit_vector<int32_t, 256> lhs, bit_vector<int32_t, 256> rhs) {
+        return {_mm256_sllv_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 256>
+    operator>>(bit_vector<int32_t, 256> lhs, bit_vector<int32_t, 256> rhs) {
+        return {_mm256_srav_epi32(lhs.data, rhs.data)};
+    }
+
+    bit_vector<int32_t, 256>& operator+=(bit_vector<int32_t, 256> rhs) {
+        data = _mm256_add_epi32(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 256>& operator-=(bit_vector<int32_t, 256> rhs) {
+        data = _mm256_sub_epi32(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 256>& operator&=(bit_vector<int32_t, 256> rhs) {
+        data = _mm256_and_si256(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 256>& operator|=(bit_vector<int32_t, 256> rhs) {
+        data = _mm256_or_si256(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 256>& operator^=(bit_vector<int32_t, 256> rhs) {
+        data = _mm256_xor_si256(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 256>& operator<<=(int count) {
+        data = _mm256_sll_epi32(data, _mm_cvtsi32_si128(count));
+        return *this;
+    }
+
+    bit_vector<int32_t, 256>& operator>>=(int count) {
+        data = _mm256_sra_epi32(data, _mm_cvtsi32_si128(count));
+        return *this;
+    }
+
     bool operator==(bit_vector<int32_t, 256> rhs) const {
-        __m256i result    = _mm256_xor_si256(data, rhs.data);
-        __m128  result_lo = _mm256_castps256_ps128(result);
-        __m128  result_hi = _mm256_extractf128_ps(result, 1);
-        return _mm_test_all_zeros(result_hi, result_lo);
+        __m256i result = _mm256_xor_si256(data, rhs.data);
+        return _mm256_testz_si256(result, result);
     }
 
     bit_vector<int32_t, 128> low_bits() const {
@@ -123,6 +519,8 @@ template <>
 struct bit_vector<float, 128> {
     __m128 data;
 
+    using mask_type = bit_mask<float, 128>;
+
     static constexpr size_t width_bytes = 32;
     static constexpr size_t size        = 4;
 
@@ -130,6 +528,10 @@ struct bit_vector<float, 128> {
         return {_mm_set_ps(f0, f1, f2, f3)};
     }
 
+    static bit_vector<float, 128> broadcast(float value) {
+        return {_mm_set1_ps(value)};
+    }
+
     static bit_vector<float, 128> load(aligned_view<float, 16> ptr) {
         return {_mm_load_ps(ptr.get())};
     }
@@ -138,9 +540,33 @@ struct bit_vector<float, 128> {
         return {_mm_loadu_ps(ptr.get())};
     }
 
+    // masked out lanes are zeroed and never read
+    static bit_vector<float, 128>
+    load(unaligned_view<float> ptr, mask_type mask) {
+        return {_mm_maskload_ps(ptr.get(), mask.data)};
+    }
+
+    template <int Scale = sizeof(float)>
+    static bit_vector<float, 128>
+    gather(unaligned_view<float> base, bit_vector<int32_t, 128> offsets) {
+        return {_mm_i32gather_ps(base.get(), offsets.data, Scale)};
+    }
+
     void store(aligned_view<float, 16> ptr) { _mm_store_ps(ptr.get(), data); }
     void store(unaligned_view<float> ptr) { _mm_storeu_ps(ptr.get(), data); }
 
+    void store(unaligned_view<float> ptr, mask_type mask) const {
+        _mm_maskstore_ps(ptr.get(), mask.data, data);
+    }
+
+    void stream(aligned_view<float, 16> ptr) const {
+        _mm_stream_ps(ptr.get(), data);
+    }
+
+    static mask_type first_n_mask(size_t n) {
+        return mask_type::first_n(n);
+    }
+
     explicit operator bit_vector<int32_t, 128>() const;
 
     friend bit_vector<float, 128>
@@ -153,10 +579,75 @@ struct bit_vector<float, 128> {
         return *this;
     }
 
+    friend bit_vector<float, 128>
+    operator+(bit_vector<float, 128> lhs, bit_vector<float, 128> rhs) {
+        return {_mm_add_ps(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<float, 128>
+    operator-(bit_vector<float, 128> lhs, bit_vector<float, 128> rhs) {
+        return {_mm_sub_ps(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<float, 128>
+    operator/(bit_vector<float, 128> lhs, bit_vector<float, 128> rhs) {
+        return {_mm_div_ps(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<float, 128>
+    operator&(bit_vector<float, 128> lhs, bit_vector<float, 128> rhs) {
+        return {_mm_and_ps(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<float, 128>
+    operator|(bit_vector<float, 128> lhs, bit_vector<float, 128> rhs) {
+        return {_mm_or_ps(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<float, 128>
+    operator^(bit_vector<float, 128> lhs, bit_vector<float, 128> rhs) {
+        return {_mm_xor_ps(lhs.data, rhs.data)};
+    }
+
+    // flips the sign bit, so -0.0 and NaN payloads are preserved
+    bit_vector<float, 128> operator-() const {
+        return {_mm_xor_ps(data, _mm_set1_ps(-0.0f))};
+    }
+
+    bit_vector<float, 128>& operator+=(bit_vector<float, 128> rhs) {
+        data = _mm_add_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 128>& operator-=(bit_vector<float, 128> rhs) {
+        data = _mm_sub_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 128>& operator/=(bit_vector<float, 128> rhs) {
+        data = _mm_div_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 128>& operator&=(bit_vector<float, 128> rhs) {
+        data = _mm_and_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 128>& operator|=(bit_vector<float, 128> rhs) {
+        data = _mm_or_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 128>& operator^=(bit_vector<float, 128> rhs) {
+        data = _mm_xor_ps(data, rhs.data);
+        return *this;
+    }
+
     bool operator==(bit_vector<float, 128> rhs) const {
         // compare not equal, unordered, non-signaling
         __m128 result_neq = _mm_cmp_ps(data, rhs.data, _CMP_NEQ_UQ);
-        return _mm_test_all_zeros(result_neq, result_neq);
+        return _mm_testz_ps(result_neq, result_neq);
     }
 };
 
@@ -164,6 +655,8 @@ template <>
 struct bit_vector<float, 256> {
     __m256 data;
 
+    using mask_type = bit_mask<float, 256>;
+
     static constexpr size_t width_bytes = 32;
     static constexpr size_t size        = 8;
 
@@ -179,6 +672,10 @@ struct bit_vector<float, 256> {
         return {_mm256_set_ps(f0, f1, f2, f3, f4, f5, f6, f7)};
     }
 
+    static bit_vector<float, 256> broadcast(float value) {
+        return {_mm256_set1_ps(value)};
+    }
+
     static bit_vector<float, 256> load(aligned_view<float, 32> ptr) {
         return {_mm256_load_ps(ptr.get())};
     }
@@ -187,6 +684,38 @@ struct bit_vector<float, 256> {
         return {_mm256_loadu_ps(ptr.get())};
     }
 
+    // the four floats at ptr in both 128-bit lanes
+    static bit_vector<float, 256> broadcast_lanes(unaligned_view<float> ptr) {
+        return {_mm256_broadcast_ps(
+                reinterpret_cast<const __m128*>(ptr.get()))};
+    }
+
+    // masked out lanes are zeroed and never read
+    static bit_vector<float, 256>
+    load(unaligned_view<float> ptr, mask_type mask) {
+        return {_mm256_maskload_ps(ptr.get(), mask.data)};
+    }
+
+    template <int Scale = sizeof(float)>
+    static bit_vector<float, 256>
+    gather(unaligned_view<float> base, bit_vector<int32_t, 256> offsets) {
+        return {_mm256_i32gather_ps(base.get(), offsets.data, Scale)};
+    }
+
+    // masked out lanes are zeroed and never read
+    template <int Scale = sizeof(float)>
+    static bit_vector<float, 256> gather(
+            unaligned_view<float> base,
+            bit_vector<int32_t, 256> offsets,
+            mask_type mask) {
+        return {_mm256_mask_i32gather_ps(
+                _mm256_setzero_ps(),
+                base.get(),
+                offsets.data,
+                _mm256_castsi256_ps(mask.data),
+                Scale)};
+    }
+
     void store(aligned_view<float, 32> ptr) const {
         _mm256_store_ps(ptr.get(), data);
     }
@@ -195,6 +724,18 @@ struct bit_vector<float, 256> {
         _mm256_storeu_ps(ptr.get(), data);
     }
 
+    void store(unaligned_view<float> ptr, mask_type mask) const {
+        _mm256_maskstore_ps(ptr.get(), mask.data, data);
+    }
+
+    void stream(aligned_view<float, 32> ptr) const {
+        _mm256_stream_ps(ptr.get(), data);
+    }
+
+    static mask_type first_n_mask(size_t n) {
+        return mask_type::first_n(n);
+    }
+
     explicit operator bit_vector<int32_t, 256>() const;
 
     friend bit_vector<float, 256>
@@ -207,30 +748,466 @@ struct bit_vector<float, 256> {
         return *this;
     }
 
-    bool operator==(bit_vector<float, 256> rhs) const {
-        // compare not equal, unordered, non-signaling
-        __m256 result_neq    = _mm256_cmp_ps(data, rhs.data, _CMP_NEQ_UQ);
-        __m128 result_neq_lo = _mm256_castps256_ps128(result_neq);
-        __m128 result_neq_hi = _mm256_extractf128_ps(result_neq, 1);
-        return _mm_test_all_zeros(result_neq_hi, result_neq_lo);
+    friend bit_vector<float, 256>
+    operator+(bit_vector<float, 256> lhs, bit_vector<float, 256> rhs) {
+        return {_mm256_add_ps(lhs.data, rhs.data)};
     }
 
-    bit_vector<float, 128> low_bits() const {
-        return {_mm256_castps256_ps128(data)};
+    friend bit_vector<float, 256>
+    operator-(bit_vector<float, 256> lhs, bit_vector<float, 256> rhs) {
+        return {_mm256_sub_ps(lhs.data, rhs.data)};
     }
-    bit_vector<float, 128> high_bits() const {
-        return {_mm256_extractf128_ps(data, 1)};
+
+    friend bit_vector<float, 256>
+    operator/(bit_vector<float, 256> lhs, bit_vector<float, 256> rhs) {
+        return {_mm256_div_ps(lhs.data, rhs.data)};
     }
-};
 
-using i32x8 = bit_vector<int32_t, 256>;
-using i32x4 = bit_vector<int32_t, 128>;
-using f32x8 = bit_vector<float, 256>;
-using f32x4 = bit_vector<float, 128>;
+    friend bit_vector<float, 256>
+    operator&(bit_vector<float, 256> lhs, bit_vector<float, 256> rhs) {
+        return {_mm256_and_ps(lhs.data, rhs.data)};
+    }
 
-inline bit_vector<int32_t, 128>::operator bit_vector<float, 128>() const {
-    return {_mm_castsi128_ps(data)};
-}
+    friend bit_vector<float, 256>
+    operator|(bit_vector<float, 256> lhs, bit_vector<float, 256> rhs) {
+        return {_mm256_or_ps(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<float, 256>
+    operator^(bit_vector<float, 256> lhs, bit_vector<float, 256> rhs) {
+        return {_mm256_xor_ps(lhs.data, rhs.data)};
+    }
+
+    // flips the sign bit, so -0.0 and NaN payloads are preserved
+    bit_vector<float, 256> operator-() const {
+        return {_mm256_xor_ps(data, _mm256_set1_ps(-0.0f))};
+    }
+
+    bit_vector<float, 256>& operator+=(bit_vector<float, 256> rhs) {
+        data = _mm256_add_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 256>& operator-=(bit_vector<float, 256> rhs) {
+        data = _mm256_sub_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 256>& operator/=(bit_vector<float, 256> rhs) {
+        data = _mm256_div_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 256>& operator&=(bit_vector<float, 256> rhs) {
+        data = _mm256_and_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 256>& operator|=(bit_vector<float, 256> rhs) {
+        data = _mm256_or_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 256>& operator^=(bit_vector<float, 256> rhs) {
+        data = _mm256_xor_ps(data, rhs.data);
+        return *this;
+    }
+
+    bool operator==(bit_vector<float, 256> rhs) const {
+        // compare not equal, unordered, non-signaling
+        __m256 result_neq = _mm256_cmp_ps(data, rhs.data, _CMP_NEQ_UQ);
+        return _mm256_testz_ps(result_neq, result_neq);
+    }
+
+    bit_vector<float, 128> low_bits() const {
+        return {_mm256_castps256_ps128(data)};
+    }
+    bit_vector<float, 128> high_bits() const {
+        return {_mm256_extractf128_ps(data, 1)};
+    }
+};
+
+template <>
+struct bit_vector<double, 128> {
+    __m128d data;
+
+    using mask_type = bit_mask<double, 128>;
+
+    static constexpr size_t width_bytes = 16;
+    static constexpr size_t size        = 2;
+
+    static bit_vector<double, 128> from(double d1, double d0) {
+        return {_mm_set_pd(d0, d1)};
+    }
+
+    static bit_vector<double, 128> broadcast(double value) {
+        return {_mm_set1_pd(value)};
+    }
+
+    static bit_vector<double, 128> load(aligned_view<double, 16> ptr) {
+        return {_mm_load_pd(ptr.get())};
+    }
+
+    static bit_vector<double, 128> load(unaligned_view<double> ptr) {
+        return {_mm_loadu_pd(ptr.get())};
+    }
+
+    // masked out lanes are zeroed and never read
+    static bit_vector<double, 128>
+    load(unaligned_view<double> ptr, mask_type mask) {
+        return {_mm_maskload_pd(ptr.get(), mask.data)};
+    }
+
+    void store(aligned_view<double, 16> ptr) const {
+        _mm_store_pd(ptr.get(), data);
+    }
+
+    void store(unaligned_view<double> ptr) const {
+        _mm_storeu_pd(ptr.get(), data);
+    }
+
+    void store(unaligned_view<double> ptr, mask_type mask) const {
+        _mm_maskstore_pd(ptr.get(), mask.data, data);
+    }
+
+    void stream(aligned_view<double, 16> ptr) const {
+        _mm_stream_pd(ptr.get(), data);
+    }
+
+    static mask_type first_n_mask(size_t n) {
+        return mask_type::first_n(n);
+    }
+
+    friend bit_vector<double, 128>
+    operator*(bit_vector<double, 128> lhs, bit_vector<double, 128> rhs) {
+        return {_mm_mul_pd(lhs.data, rhs.data)};
+    }
+
+    bit_vector<double, 128>& operator*=(bit_vector<double, 128> rhs) {
+        data = _mm_mul_pd(data, rhs.data);
+        return *this;
+    }
+
+    friend bit_vector<double, 128>
+    operator+(bit_vector<double, 128> lhs, bit_vector<double, 128> rhs) {
+        return {_mm_add_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 128>
+    operator-(bit_vector<double, 128> lhs, bit_vector<double, 128> rhs) {
+        return {_mm_sub_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 128>
+    operator/(bit_vector<double, 128> lhs, bit_vector<double, 128> rhs) {
+        return {_mm_div_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 128>
+    operator&(bit_vector<double, 128> lhs, bit_vector<double, 128> rhs) {
+        return {_mm_and_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 128>
+    operator|(bit_vector<double, 128> lhs, bit_vector<double, 128> rhs) {
+        return {_mm_or_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 128>
+    operator^(bit_vector<double, 128> lhs, bit_vector<double, 128> rhs) {
+        return {_mm_xor_pd(lhs.data, rhs.data)};
+    }
+
+    // flips the sign bit, so -0.0 and NaN payloads are preserved
+    bit_vector<double, 128> operator-() const {
+        return {_mm_xor_pd(data, _mm_set1_pd(-0.0))};
+    }
+
+    bit_vector<double, 128>& operator+=(bit_vector<double, 128> rhs) {
+        data = _mm_add_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 128>& operator-=(bit_vector<double, 128> rhs) {
+        data = _mm_sub_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 128>& operator/=(bit_vector<double, 128> rhs) {
+        data = _mm_div_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 128>& operator&=(bit_vector<double, 128> rhs) {
+        data = _mm_and_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 128>& operator|=(bit_vector<double, 128> rhs) {
+        data = _mm_or_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 128>& operator^=(bit_vector<double, 128> rhs) {
+        data = _mm_xor_pd(data, rhs.data);
+        return *this;
+    }
+
+    bool operator==(bit_vector<double, 128> rhs) const {
+        // compare not equal, unordered, non-signaling
+        __m128d result_neq = _mm_cmp_pd(data, rhs.data, _CMP_NEQ_UQ);
+        return _mm_testz_pd(result_neq, result_neq);
+    }
+};
+
+template <>
+struct bit_vector<double, 256> {
+    __m256d data;
+
+    using mask_type = bit_mask<double, 256>;
+
+    static constexpr size_t width_bytes = 32;
+    static constexpr size_t size        = 4;
+
+    static bit_vector<double, 256>
+    from(double d3, double d2, double d1, double d0) {
+        return {_mm256_set_pd(d0, d1, d2, d3)};
+    }
+
+    static bit_vector<double, 256> broadcast(double value) {
+        return {_mm256_set1_pd(value)};
+    }
+
+    static bit_vector<double, 256> load(aligned_view<double, 32> ptr) {
+        return {_mm256_load_pd(ptr.get())};
+    }
+
+    static bit_vector<double, 256> load(unaligned_view<double> ptr) {
+        return {_mm256_loadu_pd(ptr.get())};
+    }
+
+    // masked out lanes are zeroed and never read
+    static bit_vector<double, 256>
+    load(unaligned_view<double> ptr, mask_type mask) {
+        return {_mm256_maskload_pd(ptr.get(), mask.data)};
+    }
+
+    template <int Scale = sizeof(double)>
+    static bit_vector<double, 256>
+    gather(unaligned_view<double> base, bit_vector<int32_t, 128> offsets) {
+        return {_mm256_i32gather_pd(base.get(), offsets.data, Scale)};
+    }
+
+    template <int Scale = sizeof(double)>
+    static bit_vector<double, 256> gather(
+            unaligned_view<double> base,
+            bit_vector<int32_t, 128> offsets,
+            mask_type mask) {
+        return {_mm256_mask_i32gather_pd(
+                _mm256_setzero_pd(),
+                base.get(),
+                offsets.data,
+                _mm256_castsi256_pd(mask.data),
+                Scale)};
+    }
+
+    void store(aligned_view<double, 32> ptr) const {
+        _mm256_store_pd(ptr.get(), data);
+    }
+
+    void store(unaligned_view<double> ptr) const {
+        _mm256_storeu_pd(ptr.get(), data);
+    }
+
+    void store(unaligned_view<double> ptr, mask_type mask) const {
+        _mm256_maskstore_pd(ptr.get(), mask.data, data);
+    }
+
+    void stream(aligned_view<double, 32> ptr) const {
+        _mm256_stream_pd(ptr.get(), data);
+    }
+
+    static mask_type first_n_mask(size_t n) {
+        return mask_type::first_n(n);
+    }
+
+    // reinterprets the bits, e.g. four gathered vector2f as eight floats
+    explicit operator bit_vector<float, 256>() const {
+        return {_mm256_castpd_ps(data)};
+    }
+
+    friend bit_vector<double, 256>
+    operator*(bit_vector<double, 256> lhs, bit_vector<double, 256> rhs) {
+        return {_mm256_mul_pd(lhs.data, rhs.data)};
+    }
+
+    bit_vector<double, 256>& operator*=(bit_vector<double, 256> rhs) {
+        data = _mm256_mul_pd(data, rhs.data);
+        return *this;
+    }
+
+    friend bit_vector<double, 256>
+    operator+(bit_vector<double, 256> lhs, bit_vector<double, 256> rhs) {
+        return {_mm256_add_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 256>
+    operator-(bit_vector<double, 256> lhs, bit_vector<double, 256> rhs) {
+        return {_mm256_sub_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 256>
+    operator/(bit_vector<double, 256> lhs, bit_vector<double, 256> rhs) {
+        return {_mm256_div_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 256>
+    operator&(bit_vector<double, 256> lhs, bit_vector<double, 256> rhs) {
+        return {_mm256_and_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 256>
+    operator|(bit_vector<double, 256> lhs, bit_vector<double, 256> rhs) {
+        return {_mm256_or_pd(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<double, 256>
+    operator^(bit_vector<double, 256> lhs, bit_vector<double, 256> rhs) {
+        return {_mm256_xor_pd(lhs.data, rhs.data)};
+    }
+
+    // flips the sign bit, so -0.0 and NaN payloads are preserved
+    bit_vector<double, 256> operator-() const {
+        return {_mm256_xor_pd(data, _mm256_set1_pd(-0.0))};
+    }
+
+    bit_vector<double, 256>& operator+=(bit_vector<double, 256> rhs) {
+        data = _mm256_add_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 256>& operator-=(bit_vector<double, 256> rhs) {
+        data = _mm256_sub_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 256>& operator/=(bit_vector<double, 256> rhs) {
+        data = _mm256_div_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 256>& operator&=(bit_vector<double, 256> rhs) {
+        data = _mm256_and_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 256>& operator|=(bit_vector<double, 256> rhs) {
+        data = _mm256_or_pd(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<double, 256>& operator^=(bit_vector<double, 256> rhs) {
+        data = _mm256_xor_pd(data, rhs.data);
+        return *this;
+    }
+
+    bool operator==(bit_vector<double, 256> rhs) const {
+        // compare not equal, unordered, non-signaling
+        __m256d result_neq = _mm256_cmp_pd(data, rhs.data, _CMP_NEQ_UQ);
+        return _mm256_testz_pd(result_neq, result_neq);
+    }
+
+    bit_vector<double, 128> low_bits() const {
+        return {_mm256_castpd256_pd128(data)};
+    }
+    bit_vector<double, 128> high_bits() const {
+        return {_mm256_extractf128_pd(data, 1)};
+    }
+};
+
+template <>
+struct bit_vector<int64_t, 256> {
+    __m256i data;
+
+    using mask_type = bit_mask<int64_t, 256>;
+
+    static constexpr size_t width_bytes = 32;
+    static constexpr size_t size        = 4;
+
+    static bit_vector<int64_t, 256>
+    from(int64_t i3, int64_t i2, int64_t i1, int64_t i0) {
+        return {_mm256_set_epi64x(i0, i1, i2, i3)};
+    }
+
+    static bit_vector<int64_t, 256> broadcast(int64_t value) {
+        return {_mm256_set1_epi64x(value)};
+    }
+
+    static bit_vector<int64_t, 256> load(aligned_view<int64_t, 32> ptr) {
+        return {_mm256_load_si256(reinterpret_cast<__m256i*>(ptr.get()))};
+    }
+
+    static bit_vector<int64_t, 256> load(unaligned_view<int64_t> ptr) {
+        return {_mm256_loadu_si256(reinterpret_cast<__m256i*>(ptr.get()))};
+    }
+
+    // masked out lanes are zeroed and never read
+    static bit_vector<int64_t, 256>
+    load(unaligned_view<int64_t> ptr, mask_type mask) {
+        return {_mm256_maskload_epi64(
+                reinterpret_cast<long long*>(ptr.get()), mask.data)};
+    }
+
+    void store(aligned_view<int64_t, 32> ptr) const {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(ptr.get()), data);
+    }
+
+    void store(unaligned_view<int64_t> ptr) const {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr.get()), data);
+    }
+
+    void store(unaligned_view<int64_t> ptr, mask_type mask) const {
+        _mm256_maskstore_epi64(
+                reinterpret_cast<long long*>(ptr.get()), mask.data, data);
+    }
+
+    void stream(aligned_view<int64_t, 32> ptr) const {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(ptr.get()), data);
+    }
+
+    static mask_type first_n_mask(size_t n) {
+        return mask_type::first_n(n);
+    }
+
+    explicit operator bit_vector<int32_t, 256>() const { return {data}; }
+
+    friend bit_vector<int64_t, 256>
+    operator+(bit_vector<int64_t, 256> lhs, bit_vector<int64_t, 256> rhs) {
+        return {_mm256_add_epi64(lhs.data, rhs.data)};
+    }
+
+    bit_vector<int64_t, 256>& operator+=(bit_vector<int64_t, 256> rhs) {
+        data = _mm256_add_epi64(data, rhs.data);
+        return *this;
+    }
+
+    bool operator==(bit_vector<int64_t, 256> rhs) const {
+        __m256i result = _mm256_xor_si256(data, rhs.data);
+        return _mm256_testz_si256(result, result);
+    }
+};
+
+using i32x8 = bit_vector<int32_t, 256>;
+using i32x4 = bit_vector<int32_t, 128>;
+using i64x4 = bit_vector<int64_t, 256>;
+using f32x8 = bit_vector<float, 256>;
+using f32x4 = bit_vector<float, 128>;
+using f64x4 = bit_vector<double, 256>;
+using f64x2 = bit_vector<double, 128>;
+
+inline bit_vector<int32_t, 128>::operator bit_vector<float, 128>() const {
+    return {_mm_castsi128_ps(data)};
+}
 
 inline bit_vector<int32_t, 256>::operator bit_vector<float, 256>() const {
     return {_mm256_castsi256_ps(data)};
@@ -244,6 +1221,13 @@ inline bit_vector<float, 256>::operator bit_vector<int32_t, 256>() const {
     return {_mm256_castps_si256(data)};
 }
 
+///// stream /////
+
+// makes every preceding stream() store visible before any later store
+inline void stream_fence() {
+    _mm_sfence();
+}
+
 ///// hadd /////
 
 inline i32x8 hadd(i32x8 v1, i32x8 v2) {
@@ -262,17 +1246,1513 @@ inline f32x4 hadd(f32x4 v1, f32x4 v2) {
     return {_mm_hadd_ps(v1.data, v2.data)};
 }
 
-///// permute /////
+inline f64x4 hadd(f64x4 v1, f64x4 v2) {
+    return {_mm256_hadd_pd(v1.data, v2.data)};
+}
 
-template <unsigned... flags>
-inline i32x8 permute4x64(i32x8 v, control4<flags...>) {
-    return {_mm256_permute4x64_epi64(v.data, control4<flags...>::value)};
+inline f64x2 hadd(f64x2 v1, f64x2 v2) {
+    return {_mm_hadd_pd(v1.data, v2.data)};
 }
 
-template <unsigned... flags>
-inline f32x8 permute4x64(f32x8 v, control4<flags...>) {
-    return {_mm256_permute4x64_epi64(
-            static_cast<i32x8>(v).data, control4<flags...>::value)};
+///// min / max /////
+
+inline f32x4 min(f32x4 v1, f32x4 v2) {
+    return {_mm_min_ps(v1.data, v2.data)};
+}
+
+inline f32x4 max(f32x4 v1, f32x4 v2) {
+    return {_mm_max_ps(v1.data, v2.data)};
+}
+
+inline f32x8 min(f32x8 v1, f32x8 v2) {
+    return {_mm256_min_ps(v1.data, v2.data)};
+}
+
+inline f32x8 max(f32x8 v1, f32x8 v2) {
+    return {_mm256_max_ps(v1.data, v2.data)};
+}
+
+inline f64x2 min(f64x2 v1, f64x2 v2) {
+    return {_mm_min_pd(v1.data, v2.data)};
+}
+
+inline f64x2 max(f64x2 v1, f64x2 v2) {
+    return {_mm_max_pd(v1.data, v2.data)};
+}
+
+inline f64x4 min(f64x4 v1, f64x4 v2) {
+    return {_mm256_min_pd(v1.data, v2.data)};
+}
+
+inline f64x4 max(f64x4 v1, f64x4 v2) {
+    return {_mm256_max_pd(v1.data, v2.data)};
+}
+
+inline i32x4 min(i32x4 v1, i32x4 v2) {
+    return {_mm_min_epi32(v1.data, v2.data)};
+}
+
+inline i32x4 max(i32x4 v1, i32x4 v2) {
+    return {_mm_max_epi32(v1.data, v2.data)};
+}
+
+inline i32x8 min(i32x8 v1, i32x8 v2) {
+    return {_mm256_min_epi32(v1.data, v2.data)};
+}
+
+inline i32x8 max(i32x8 v1, i32x8 v2) {
+    return {_mm256_max_epi32(v1.data, v2.data)};
+}
+
+///// abs /////
+
+inline f32x4 abs(f32x4 v) {
+    return {_mm_andnot_ps(_mm_set1_ps(-0.0f), v.data)};
+}
+
+inline f32x8 abs(f32x8 v) {
+    return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), v.data)};
+}
+
+inline f64x2 abs(f64x2 v) {
+    return {_mm_andnot_pd(_mm_set1_pd(-0.0), v.data)};
+}
+
+inline f64x4 abs(f64x4 v) {
+    return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), v.data)};
+}
+
+inline i32x4 abs(i32x4 v) {
+    return {_mm_abs_epi32(v.data)};
+}
+
+inline i32x8 abs(i32x8 v) {
+    return {_mm256_abs_epi32(v.data)};
+}
+
+///// sqrt /////
+
+// correctly rounded
+inline f32x4 sqrt(f32x4 v) {
+    return {_mm_sqrt_ps(v.data)};
+}
+
+inline f32x8 sqrt(f32x8 v) {
+    return {_mm256_sqrt_ps(v.data)};
+}
+
+inline f64x2 sqrt(f64x2 v) {
+    return {_mm_sqrt_pd(v.data)};
+}
+
+inline f64x4 sqrt(f64x4 v) {
+    return {_mm256_sqrt_pd(v.data)};
+}
+
+// estimate of 1 / sqrt(v) with a relative error of at most 1.5 * 2^-12
+inline f32x4 rsqrt(f32x4 v) {
+    return {_mm_rsqrt_ps(v.data)};
+}
+
+inline f32x8 rsqrt(f32x8 v) {
+    return {_mm256_rsqrt_ps(v.data)};
+}
+
+///// andnot /////
+
+// (~v1) & v2, matching the operand order of the andnot instructions
+
+inline f32x4 andnot(f32x4 v1, f32x4 v2) {
+    return {_mm_andnot_ps(v1.data, v2.data)};
+}
+
+inline f32x8 andnot(f32x8 v1, f32x8 v2) {
+    return {_mm256_andnot_ps(v1.data, v2.data)};
+}
+
+inline f64x2 andnot(f64x2 v1, f64x2 v2) {
+    return {_mm_andnot_pd(v1.data, v2.data)};
+}
+
+inline f64x4 andnot(f64x4 v1, f64x4 v2) {
+    return {_mm256_andnot_pd(v1.data, v2.data)};
+}
+
+inline i32x4 andnot(i32x4 v1, i32x4 v2) {
+    return {_mm_andnot_si128(v1.data, v2.data)};
+}
+
+inline i32x8 andnot(i32x8 v1, i32x8 v2) {
+    return {_mm256_andnot_si256(v1.data, v2.data)};
+}
+
+///// fma /////
+
+// fmadd: a * b + c, fmsub: a * b - c, fnmadd: c - a * b
+//
+// the floating point versions round once when FMA is available and twice
+// otherwise; the int32 versions keep the low 32 bits like operator*
+
+inline f32x4 fmadd(f32x4 a, f32x4 b, f32x4 c) {
+#ifdef __FMA__
+    return {_mm_fmadd_ps(a.data, b.data, c.data)};
+#else
+    return a * b + c;
+#endif
+}
+
+inline f32x4 fmsub(f32x4 a, f32x4 b, f32x4 c) {
+#ifdef __FMA__
+    return {_mm_fmsub_ps(a.data, b.data, c.data)};
+#else
+    return a * b - c;
+#endif
+}
+
+inline f32x4 fnmadd(f32x4 a, f32x4 b, f32x4 c) {
+#ifdef __FMA__
+    return {_mm_fnmadd_ps(a.data, b.data, c.data)};
+#else
+    return c - a * b;
+#endif
+}
+
+inline f32x8 fmadd(f32x8 a, f32x8 b, f32x8 c) {
+#ifdef __FMA__
+    return {_mm256_fmadd_ps(a.data, b.data, c.data)};
+#else
+    return a * b + c;
+#endif
+}
+
+inline f32x8 fmsub(f32x8 a, f32x8 b, f32x8 c) {
+#ifdef __FMA__
+    return {_mm256_fmsub_ps(a.data, b.data, c.data)};
+#else
+    return a * b - c;
+#endif
+}
+
+inline f32x8 fnmadd(f32x8 a, f32x8 b, f32x8 c) {
+#ifdef __FMA__
+    return {_mm256_fnmadd_ps(a.data, b.data, c.data)};
+#else
+    return c - a * b;
+#endif
+}
+
+inline f64x2 fmadd(f64x2 a, f64x2 b, f64x2 c) {
+#ifdef __FMA__
+    return {_mm_fmadd_pd(a.data, b.data, c.data)};
+#else
+    return a * b + c;
+#endif
+}
+
+inline f64x2 fmsub(f64x2 a, f64x2 b, f64x2 c) {
+#ifdef __FMA__
+    return {_mm_fmsub_pd(a.data, b.data, c.data)};
+#else
+    return a * b - c;
+#endif
+}
+
+inline f64x2 fnmadd(f64x2 a, f64x2 b, f64x2 c) {
+#ifdef __FMA__
+    return {_mm_fnmadd_pd(a.data, b.data, c.data)};
+#else
+    return c - a * b;
+#endif
+}
+
+inline f64x4 fmadd(f64x4 a, f64x4 b, f64x4 c) {
+#ifdef __FMA__
+    return {_mm256_fmadd_pd(a.data, b.data, c.data)};
+#else
+    return a * b + c;
+#endif
+}
+
+inline f64x4 fmsub(f64x4 a, f64x4 b, f64x4 c) {
+#ifdef __FMA__
+    return {_mm256_fmsub_pd(a.data, b.data, c.data)};
+#else
+    return a * b - c;
+#endif
+}
+
+inline f64x4 fnmadd(f64x4 a, f64x4 b, f64x4 c) {
+#ifdef __FMA__
+    return {_mm256_fnmadd_pd(a.data, b.data, c.data)};
+#else
+    return c - a * b;
+#endif
+}
+
+inline i32x4 fmadd(i32x4 a, i32x4 b, i32x4 c) {
+    return a * b + c;
+}
+
+inline i32x4 fmsub(i32x4 a, i32x4 b, i32x4 c) {
+    return a * b - c;
+}
+
+inline i32x4 fnmadd(i32x4 a, i32x4 b, i32x4 c) {
+    return c - a * b;
+}
+
+inline i32x8 fmadd(i32x8 a, i32x8 b, i32x8 c) {
+    return a * b + c;
+}
+
+inline i32x8 fmsub(i32x8 a, i32x8 b, i32x8 c) {
+    return a * b - c;
+}
+
+inline i32x8 fnmadd(i32x8 a, i32x8 b, i32x8 c) {
+    return c - a * b;
+}
+
+///// compare /////
+
+// lane-wise comparisons; ordered and non-signaling for floating point, so
+// every comparison except cmp_ne is false for NaN lanes
+
+inline f32x4::mask_type cmp_lt(f32x4 v1, f32x4 v2) {
+    return {_mm_castps_si128(_mm_cmp_ps(v1.data, v2.data, _CMP_LT_OQ))};
+}
+
+inline f32x4::mask_type cmp_le(f32x4 v1, f32x4 v2) {
+    return {_mm_castps_si128(_mm_cmp_ps(v1.data, v2.data, _CMP_LE_OQ))};
+}
+
+inline f32x4::mask_type cmp_gt(f32x4 v1, f32x4 v2) {
+    return {_mm_castps_si128(_mm_cmp_ps(v1.data, v2.data, _CMP_GT_OQ))};
+}
+
+inline f32x4::mask_type cmp_ge(f32x4 v1, f32x4 v2) {
+    return {_mm_castps_si128(_mm_cmp_ps(v1.data, v2.data, _CMP_GE_OQ))};
+}
+
+inline f32x4::mask_type cmp_eq(f32x4 v1, f32x4 v2) {
+    return {_mm_castps_si128(_mm_cmp_ps(v1.data, v2.data, _CMP_EQ_OQ))};
+}
+
+inline f32x4::mask_type cmp_ne(f32x4 v1, f32x4 v2) {
+    return {_mm_castps_si128(_mm_cmp_ps(v1.data, v2.data, _CMP_NEQ_UQ))};
+}
+
+inline f32x8::mask_type cmp_lt(f32x8 v1, f32x8 v2) {
+    return {_mm256_castps_si256(_mm256_cmp_ps(v1.data, v2.data, _CMP_LT_OQ))};
+}
+
+inline f32x8::mask_type cmp_le(f32x8 v1, f32x8 v2) {
+    return {_mm256_castps_si256(_mm256_cmp_ps(v1.data, v2.data, _CMP_LE_OQ))};
+}
+
+inline f32x8::mask_type cmp_gt(f32x8 v1, f32x8 v2) {
+    return {_mm256_castps_si256(_mm256_cmp_ps(v1.data, v2.data, _CMP_GT_OQ))};
+}
+
+inline f32x8::mask_type cmp_ge(f32x8 v1, f32x8 v2) {
+    return {_mm256_castps_si256(_mm256_cmp_ps(v1.data, v2.data, _CMP_GE_OQ))};
+}
+
+inline f32x8::mask_type cmp_eq(f32x8 v1, f32x8 v2) {
+    return {_mm256_castps_si256(_mm256_cmp_ps(v1.data, v2.data, _CMP_EQ_OQ))};
+}
+
+inline f32x8::mask_type cmp_ne(f32x8 v1, f32x8 v2) {
+    return {_mm256_castps_si256(_mm256_cmp_ps(v1.data, v2.data, _CMP_NEQ_UQ))};
+}
+
+inline f64x2::mask_type cmp_lt(f64x2 v1, f64x2 v2) {
+    return {_mm_castpd_si128(_mm_cmp_pd(v1.data, v2.data, _CMP_LT_OQ))};
+}
+
+inline f64x2::mask_type cmp_le(f64x2 v1, f64x2 v2) {
+    return {_mm_castpd_si128(_mm_cmp_pd(v1.data, v2.data, _CMP_LE_OQ))};
+}
+
+inline f64x2::mask_type cmp_gt(f64x2 v1, f64x2 v2) {
+    return {_mm_castpd_si128(_mm_cmp_pd(v1.data, v2.data, _CMP_GT_OQ))};
+}
+
+inline f64x2::mask_type cmp_ge(f64x2 v1, f64x2 v2) {
+    return {_mm_castpd_si128(_mm_cmp_pd(v1.data, v2.data, _CMP_GE_OQ))};
+}
+
+inline f64x2::mask_type cmp_eq(f64x2 v1, f64x2 v2) {
+    return {_mm_castpd_si128(_mm_cmp_pd(v1.data, v2.data, _CMP_EQ_OQ))};
+}
+
+inline f64x2::mask_type cmp_ne(f64x2 v1, f64x2 v2) {
+    return {_mm_castpd_si128(_mm_cmp_pd(v1.data, v2.data, _CMP_NEQ_UQ))};
+}
+
+inline f64x4::mask_type cmp_lt(f64x4 v1, f64x4 v2) {
+    return {_mm256_castpd_si256(_mm256_cmp_pd(v1.data, v2.data, _CMP_LT_OQ))};
+}
+
+inline f64x4::mask_type cmp_le(f64x4 v1, f64x4 v2) {
+    return {_mm256_castpd_si256(_mm256_cmp_pd(v1.data, v2.data, _CMP_LE_OQ))};
+}
+
+inline f64x4::mask_type cmp_gt(f64x4 v1, f64x4 v2) {
+    return {_mm256_castpd_si256(_mm256_cmp_pd(v1.data, v2.data, _CMP_GT_OQ))};
+}
+
+inline f64x4::mask_type cmp_ge(f64x4 v1, f64x4 v2) {
+    return {_mm256_castpd_si256(_mm256_cmp_pd(v1.data, v2.data, _CMP_GE_OQ))};
+}
+
+inline f64x4::mask_type cmp_eq(f64x4 v1, f64x4 v2) {
+    return {_mm256_castpd_si256(_mm256_cmp_pd(v1.data, v2.data, _CMP_EQ_OQ))};
+}
+
+inline f64x4::mask_type cmp_ne(f64x4 v1, f64x4 v2) {
+    return {_mm256_castpd_si256(_mm256_cmp_pd(v1.data, v2.data, _CMP_NEQ_UQ))};
+}
+
+inline i32x4::mask_type cmp_eq(i32x4 v1, i32x4 v2) {
+    return {_mm_cmpeq_epi32(v1.data, v2.data)};
+}
+
+inline i32x4::mask_type cmp_gt(i32x4 v1, i32x4 v2) {
+    return {_mm_cmpgt_epi32(v1.data, v2.data)};
+}
+
+inline i32x4::mask_type cmp_lt(i32x4 v1, i32x4 v2) {
+    return cmp_gt(v2, v1);
+}
+
+inline i32x4::mask_type cmp_ne(i32x4 v1, i32x4 v2) {
+    return ~cmp_eq(v1, v2);
+}
+
+inline i32x4::mask_type cmp_le(i32x4 v1, i32x4 v2) {
+    return ~cmp_gt(v1, v2);
+}
+
+inline i32x4::mask_type cmp_ge(i32x4 v1, i32x4 v2) {
+    return ~cmp_gt(v2, v1);
+}
+
+inline i32x8::mask_type cmp_eq(i32x8 v1, i32x8 v2) {
+    return {_mm256_cmpeq_epi32(v1.data, v2.data)};
+}
+
+inline i32x8::mask_type cmp_gt(i32x8 v1, i32x8 v2) {
+    return {_mm256_cmpgt_epi32(v1.data, v2.data)};
+}
+
+inline i32x8::mask_type cmp_lt(i32x8 v1, i32x8 v2) {
+    return cmp_gt(v2, v1);
+}
+
+inline i32x8::mask_type cmp_ne(i32x8 v1, i32x8 v2) {
+    return ~cmp_eq(v1, v2);
+}
+
+inline i32x8::mask_type cmp_le(i32x8 v1, i32x8 v2) {
+    return ~cmp_gt(v1, v2);
+}
+
+inline i32x8::mask_type cmp_ge(i32x8 v1, i32x8 v2) {
+    return ~cmp_gt(v2, v1);
+}
+
+///// select /////
+
+// lanes set in mask are taken from v1, the others from v2
+
+inline f32x4 select(f32x4::mask_type mask, f32x4 v1, f32x4 v2) {
+    return {_mm_blendv_ps(v2.data, v1.data, _mm_castsi128_ps(mask.data))};
+}
+
+inline f32x8 select(f32x8::mask_type mask, f32x8 v1, f32x8 v2) {
+    return {_mm256_blendv_ps(v2.data, v1.data, _mm256_castsi256_ps(mask.data))};
+}
+
+inline f64x2 select(f64x2::mask_type mask, f64x2 v1, f64x2 v2) {
+    return {_mm_blendv_pd(v2.data, v1.data, _mm_castsi128_pd(mask.data))};
+}
+
+inline f64x4 select(f64x4::mask_type mask, f64x4 v1, f64x4 v2) {
+    return {_mm256_blendv_pd(v2.data, v1.data, _mm256_castsi256_pd(mask.data))};
+}
+
+inline i32x4 select(i32x4::mask_type mask, i32x4 v1, i32x4 v2) {
+    return {_mm_blendv_epi8(v2.data, v1.data, mask.data)};
+}
+
+inline i32x8 select(i32x8::mask_type mask, i32x8 v1, i32x8 v2) {
+    return {_mm256_blendv_epi8(v2.data, v1.data, mask.data)};
+}
+
+inline i64x4 select(i64x4::mask_type mask, i64x4 v1, i64x4 v2) {
+    return {_mm256_blendv_epi8(v2.data, v1.data, mask.data)};
+}
+
+///// convert /////
+
+// numeric conversions, unlike the bitcasting conversion operators. Rounds
+// to nearest with ties to even; out of range lanes become INT32_MIN
+
+inline i32x4 round_to_int(f32x4 v) {
+    return {_mm_cvtps_epi32(v.data)};
+}
+
+inline i32x8 round_to_int(f32x8 v) {
+    return {_mm256_cvtps_epi32(v.data)};
+}
+
+inline f32x4 to_float(i32x4 v) {
+    return {_mm_cvtepi32_ps(v.data)};
+}
+
+inline f32x8 to_float(i32x8 v) {
+    return {_mm256_cvtepi32_ps(v.data)};
+}
+
+///// mul_wide /////
+
+// signed 64-bit products of the even int32 lanes; odd lanes are ignored
+inline i64x4 mul_wide(i32x8 v1, i32x8 v2) {
+    return {_mm256_mul_epi32(v1.data, v2.data)};
+}
+
+///// pack_saturate /////
+
+// narrows [lo0, lo1, lo2, lo3] and [hi0, hi1, hi2, hi3] to
+// [lo0, lo1, lo2, lo3, hi0, hi1, hi2, hi3], clamping to the int32 range
+inline i32x8 pack_saturate(i64x4 lo, i64x4 hi) {
+    const __m256i max = _mm256_set1_epi64x(INT32_MAX);
+    const __m256i min = _mm256_set1_epi64x(INT32_MIN);
+
+    __m256i lo_clamped = lo.data;
+    __m256i hi_clamped = hi.data;
+
+    lo_clamped = _mm256_blendv_epi8(
+            lo_clamped, max, _mm256_cmpgt_epi64(lo_clamped, max));
+    lo_clamped = _mm256_blendv_epi8(
+            lo_clamped, min, _mm256_cmpgt_epi64(min, lo_clamped));
+    hi_clamped = _mm256_blendv_epi8(
+            hi_clamped, max, _mm256_cmpgt_epi64(hi_clamped, max));
+    hi_clamped = _mm256_blendv_epi8(
+            hi_clamped, min, _mm256_cmpgt_epi64(min, hi_clamped));
+
+    // the intrinsics may be macros, which would split a template argument
+    // list at its commas, so the controls are hoisted
+    constexpr int low_halves = control4<0, 2, 0, 2>::value;
+    constexpr int lane_order = control4<0, 2, 1, 3>::value;
+
+    // [lo0, lo1, hi0, hi1, lo2, lo3, hi2, hi3]
+    __m256 interleaved = _mm256_shuffle_ps(
+            _mm256_castsi256_ps(lo_clamped),
+            _mm256_castsi256_ps(hi_clamped),
+            low_halves);
+    return {_mm256_permute4x64_epi64(
+            _mm256_castps_si256(interleaved), lane_order)};
+}
+
+///// shuffle /////
+
+// permutes the int32 lanes within each 128-bit half
+template <unsigned... flags>
+inline i32x8 shuffle(i32x8 v, control4<flags...>) {
+    return {_mm256_shuffle_epi32(v.data, control4<flags...>::value)};
+}
+
+template <unsigned... flags>
+inline f32x8 shuffle(f32x8 v, control4<flags...>) {
+    return {_mm256_permute_ps(v.data, control4<flags...>::value)};
+}
+
+///// permute /////
+
+template <unsigned... flags>
+inline i32x8 permute4x64(i32x8 v, control4<flags...>) {
+    return {_mm256_permute4x64_epi64(v.data, control4<flags...>::value)};
+}
+
+template <unsigned... flags>
+inline f32x8 permute4x64(f32x8 v, control4<flags...>) {
+    return static_cast<f32x8>(
+            permute4x64(static_cast<i32x8>(v), control4<flags...>()));
+}
+
+template <unsigned... flags>
+inline f64x4 permute4x64(f64x4 v, control4<flags...>) {
+    return {_mm256_permute4x64_pd(v.data, control4<flags...>::value)};
+}
+
+// lane k of the result is lane indices[k] of v
+inline f32x8 permutevar(f32x8 v, i32x8 indices) {
+    return {_mm256_permutevar8x32_ps(v.data, indices.data)};
+}
+
+// exchanges lanes 2k and 2k + 1, e.g. the x and y of packed vector2
+inline f32x8 swap_pairs(f32x8 v) {
+    constexpr int swap = control4<1, 0, 3, 2>::value;
+    return {_mm256_permute_ps(v.data, swap)};
+}
+
+inline f64x4 swap_pairs(f64x4 v) {
+    return {_mm256_permute_pd(v.data, 0b0101)};
+}
+
+// copies lane 2k over lane 2k + 1, e.g. the x of packed vector2 into both
+// lanes
+inline f32x8 duplicate_even(f32x8 v) {
+    return {_mm256_moveldup_ps(v.data)};
+}
+
+inline f64x4 duplicate_even(f64x4 v) {
+    return {_mm256_movedup_pd(v.data)};
+}
+
+// copies lane 2k + 1 over lane 2k
+inline f32x8 duplicate_odd(f32x8 v) {
+    return {_mm256_movehdup_ps(v.data)};
+}
+
+inline f64x4 duplicate_odd(f64x4 v) {
+    return {_mm256_permute_pd(v.data, 0b1111)};
+}
+
+///// interleave /////
+
+// splits [e0, o0, e1, o1, ...] spread over lo and hi into the even lanes
+// [e0, e1, ...] and the odd lanes [o0, o1, ...]
+inline std::pair<f32x8, f32x8> deinterleave(f32x8 lo, f32x8 hi) {
+    constexpr int even_lanes = control4<0, 2, 0, 2>::value;
+    constexpr int odd_lanes  = control4<1, 3, 1, 3>::value;
+
+    // [e0, e1, e4, e5, e2, e3, e6, e7]
+    f32x8 even{_mm256_shuffle_ps(lo.data, hi.data, even_lanes)};
+    f32x8 odd{_mm256_shuffle_ps(lo.data, hi.data, odd_lanes)};
+    return {permute4x64(even, control4<0, 2, 1, 3>()),
+            permute4x64(odd, control4<0, 2, 1, 3>())};
+}
+
+inline std::pair<f64x4, f64x4> deinterleave(f64x4 lo, f64x4 hi) {
+    // [e0, e2, e1, e3]
+    f64x4 even{_mm256_unpacklo_pd(lo.data, hi.data)};
+    f64x4 odd{_mm256_unpackhi_pd(lo.data, hi.data)};
+    return {permute4x64(even, control4<0, 2, 1, 3>()),
+            permute4x64(odd, control4<0, 2, 1, 3>())};
+}
+
+// splits [a0, b0, c0, a1, b1, c1, a2, b2, c2, a3, b3, c3] spread over v0, v1
+// and v2 into [a0, a1, a2, a3], [b0, b1, b2, b3] and [c0, c1, c2, c3]
+inline std::tuple<f64x4, f64x4, f64x4>
+deinterleave3(f64x4 v0, f64x4 v1, f64x4 v2) {
+    // [a0, b0, a2, b2], [c0, a1, c2, a3] and [b1, c1, b3, c3]
+    const __m256d ab = _mm256_blend_pd(v0.data, v1.data, 0b1100);
+    const __m256d ca = _mm256_permute2f128_pd(v0.data, v2.data, 0x21);
+    const __m256d bc = _mm256_blend_pd(v1.data, v2.data, 0b1100);
+    return {f64x4{_mm256_shuffle_pd(ab, ca, 0b1010)},
+            f64x4{_mm256_shuffle_pd(ab, bc, 0b0101)},
+            f64x4{_mm256_blend_pd(ca, bc, 0b1010)}};
+}
+
+inline std::tuple<f32x8, f32x8, f32x8>
+deinterleave3(f32x8 v0, f32x8 v1, f32x8 v2) {
+    // every a, b and c gathered into one register, e.g.
+    // [a0, a3, a6, a1, a4, a7, a2, a5], then put in order
+    const __m256 a = _mm256_blend_ps(
+            _mm256_blend_ps(v0.data, v1.data, 0x92), v2.data, 0x24);
+    const __m256 b = _mm256_blend_ps(
+            _mm256_blend_ps(v0.data, v1.data, 0x24), v2.data, 0x49);
+    const __m256 c = _mm256_blend_ps(
+            _mm256_blend_ps(v0.data, v1.data, 0x49), v2.data, 0x92);
+    return {permutevar(f32x8{a}, i32x8::from(0, 3, 6, 1, 4, 7, 2, 5)),
+            permutevar(f32x8{b}, i32x8::from(1, 4, 7, 2, 5, 0, 3, 6)),
+            permutevar(f32x8{c}, i32x8::from(2, 5, 0, 3, 6, 1, 4, 7))};
+}
+
+// the inverse of deinterleave3
+inline std::tuple<f64x4, f64x4, f64x4> interleave3(f64x4 a, f64x4 b, f64x4 c) {
+    // [a0, b0, a2, b2], [c0, a1, c2, a3] and [b1, c1, b3, c3]
+    const __m256d ab = _mm256_unpacklo_pd(a.data, b.data);
+    const __m256d ca = _mm256_blend_pd(c.data, a.data, 0b1010);
+    const __m256d bc = _mm256_unpackhi_pd(b.data, c.data);
+    return {f64x4{_mm256_permute2f128_pd(ab, ca, 0x20)},
+            f64x4{_mm256_blend_pd(bc, ab, 0b1100)},
+            f64x4{_mm256_permute2f128_pd(ca, bc, 0x31)}};
+}
+
+inline std::tuple<f32x8, f32x8, f32x8> interleave3(f32x8 a, f32x8 b, f32x8 c) {
+    const __m256 pa
+            = permutevar(a, i32x8::from(0, 3, 6, 1, 4, 7, 2, 5)).data;
+    const __m256 pb
+            = permutevar(b, i32x8::from(5, 0, 3, 6, 1, 4, 7, 2)).data;
+    const __m256 pc
+            = permutevar(c, i32x8::from(2, 5, 0, 3, 6, 1, 4, 7)).data;
+    return {f32x8{_mm256_blend_ps(_mm256_blend_ps(pa, pb, 0x92), pc, 0x24)},
+            f32x8{_mm256_blend_ps(_mm256_blend_ps(pc, pa, 0x92), pb, 0x24)},
+            f32x8{_mm256_blend_ps(_mm256_blend_ps(pb, pc, 0x92), pa, 0x24)}};
+}
+
+// the inverse of deinterleave: [e0, o0, e1, o1, ...] spread over the
+// returned lo and hi
+inline std::pair<f32x8, f32x8> interleave(f32x8 even, f32x8 odd) {
+    // [e0, o0, e1, o1, e4, o4, e5, o5] and [e2, o2, e3, o3, e6, o6, e7, o7]
+    __m256 lo = _mm256_unpacklo_ps(even.data, odd.data);
+    __m256 hi = _mm256_unpackhi_ps(even.data, odd.data);
+    return {f32x8{_mm256_permute2f128_ps(lo, hi, 0x20)},
+            f32x8{_mm256_permute2f128_ps(lo, hi, 0x31)}};
+}
+
+inline std::pair<f64x4, f64x4> interleave(f64x4 even, f64x4 odd) {
+    // [e0, o0, e2, o2] and [e1, o1, e3, o3]
+    __m256d lo = _mm256_unpacklo_pd(even.data, odd.data);
+    __m256d hi = _mm256_unpackhi_pd(even.data, odd.data);
+    return {f64x4{_mm256_permute2f128_pd(lo, hi, 0x20)},
+            f64x4{_mm256_permute2f128_pd(lo, hi, 0x31)}};
+}
+
+///// transpose /////
+
+// the 4x4 matrix with rows [r0, r1] in lo and [r2, r3] in hi, transposed into
+// the same layout
+inline std::pair<f32x8, f32x8> transpose4x4(f32x8 lo, f32x8 hi) {
+    // [r0[0], r2[0], r0[1], r2[1], r1[0], r3[0], r1[1], r3[1]] and the same
+    // for columns 2 and 3
+    const f32x8 even{_mm256_unpacklo_ps(lo.data, hi.data)};
+    const f32x8 odd{_mm256_unpackhi_ps(lo.data, hi.data)};
+    const auto order = i32x8::from(0, 4, 1, 5, 2, 6, 3, 7);
+    return {permutevar(even, order), permutevar(odd, order)};
+}
+
+// the 4x4 matrix with rows r0, ..., r3, transposed
+inline std::tuple<f64x4, f64x4, f64x4, f64x4>
+transpose4x4(f64x4 r0, f64x4 r1, f64x4 r2, f64x4 r3) {
+    // [r0[0], r1[0], r0[2], r1[2]] and so on
+    const __m256d t0 = _mm256_unpacklo_pd(r0.data, r1.data);
+    const __m256d t1 = _mm256_unpackhi_pd(r0.data, r1.data);
+    const __m256d t2 = _mm256_unpacklo_pd(r2.data, r3.data);
+    const __m256d t3 = _mm256_unpackhi_pd(r2.data, r3.data);
+    return {f64x4{_mm256_permute2f128_pd(t0, t2, 0x20)},
+            f64x4{_mm256_permute2f128_pd(t1, t3, 0x20)},
+            f64x4{_mm256_permute2f128_pd(t0, t2, 0x31)},
+            f64x4{_mm256_permute2f128_pd(t1, t3, 0x31)}};
+}
+
+///// compress /////
+
+namespace detail {
+
+// entry m packs the indices of the lanes set in the 8 bit mask m into
+// nibbles, first lane lowest, followed by zero nibbles
+struct compress_table {
+    uint32_t entries[256];
+
+    constexpr compress_table() : entries() {
+        for (unsigned m = 0; m < 256; ++m) {
+            unsigned shift = 0;
+            for (unsigned lane = 0; lane < 8; ++lane) {
+                if (m & (1u << lane)) {
+                    entries[m] |= lane << shift;
+                    shift += 4;
+                }
+            }
+        }
+    }
+};
+
+inline constexpr compress_table compress_lut{};
+
+// the _mm256_permutevar8x32 indices for the lanes set in bits. Nibbles keep
+// the table at 1 KiB, where whole index vectors would take 8 KiB of L1
+inline i32x8 compress_indices(int bits) {
+    const __m256i packed
+            = _mm256_set1_epi32(int32_t(compress_lut.entries[bits]));
+    const __m256i shifted = _mm256_srlv_epi32(
+            packed, _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+    return {_mm256_and_si256(shifted, _mm256_set1_epi32(0xf))};
+}
+
+// the mask of the 32-bit halves of the 64-bit lanes set in bits
+inline int widen_mask_bits(int bits) {
+    return (bits & 1) * 0x3 | (bits & 2) * 0x6 | (bits & 4) * 0xc
+           | (bits & 8) * 0x18;
+}
+
+}  // namespace detail
+
+// moves the lanes set in mask to the front, keeping their order; the lanes
+// past popcount(mask) are unspecified
+
+inline f32x8 compress(f32x8::mask_type mask, f32x8 v) {
+    return {_mm256_permutevar8x32_ps(
+            v.data, detail::compress_indices(movemask(mask)).data)};
+}
+
+inline i32x8 compress(i32x8::mask_type mask, i32x8 v) {
+    return {_mm256_permutevar8x32_epi32(
+            v.data, detail::compress_indices(movemask(mask)).data)};
+}
+
+inline f64x4 compress(f64x4::mask_type mask, f64x4 v) {
+    const i32x8 indices = detail::compress_indices(
+            detail::widen_mask_bits(movemask(mask)));
+    return {_mm256_castps_pd(_mm256_permutevar8x32_ps(
+            _mm256_castpd_ps(v.data), indices.data))};
+}
+
+// writes the lanes set in mask to out[0, popcount(mask)) in lane order and
+// returns their number; nothing past them is written
+
+template <typename Rep, size_t Bits>
+inline size_t compress_store(
+        typename bit_vector<Rep, Bits>::mask_type mask,
+        bit_vector<Rep, Bits> v,
+        unaligned_view<Rep> out) {
+    const int n = popcount(mask);
+    compress(mask, v).store(out, bit_vector<Rep, Bits>::first_n_mask(n));
+    return n;
+}
+
+///// reduce /////
+
+namespace detail {
+
+// each step folds the upper half of the register onto the lower half with op,
+// so a register of n lanes takes log2(n) shuffles and ops and every lane of a
+// step is valid, unlike chained hadd which spends half of its work on copies
+
+template <typename Op>
+inline float reduce(f32x4 v, Op op) {
+    v = op(v, f32x4{_mm_movehl_ps(v.data, v.data)});
+    v = op(v, f32x4{_mm_movehdup_ps(v.data)});
+    return _mm_cvtss_f32(v.data);
+}
+
+template <typename Op>
+inline float reduce(f32x8 v, Op op) {
+    return reduce(
+            op(f32x4{_mm256_castps256_ps128(v.data)},
+               f32x4{_mm256_extractf128_ps(v.data, 1)}),
+            op);
+}
+
+template <typename Op>
+inline int32_t reduce(i32x4 v, Op op) {
+    constexpr int swap = control4<1, 0, 3, 2>::value;
+    v = op(v, i32x4{_mm_unpackhi_epi64(v.data, v.data)});
+    v = op(v, i32x4{_mm_shuffle_epi32(v.data, swap)});
+    return _mm_cvtsi128_si32(v.data);
+}
+
+template <typename Op>
+inline int32_t reduce(i32x8 v, Op op) {
+    return reduce(
+            op(i32x4{_mm256_castsi256_si128(v.data)},
+               i32x4{_mm256_extracti128_si256(v.data, 1)}),
+            op);
+}
+
+template <typename Op>
+inline double reduce(f64x2 v, Op op) {
+    v = op(v, f64x2{_mm_unpackhi_pd(v.data, v.data)});
+    return _mm_cvtsd_f64(v.data);
+}
+
+template <typename Op>
+inline double reduce(f64x4 v, Op op) {
+    return reduce(
+            op(f64x2{_mm256_castpd256_pd128(v.data)},
+               f64x2{_mm256_extractf128_pd(v.data, 1)}),
+            op);
+}
+
+}  // namespace detail
+
+#ifdef __AVX512F__
+
+// AVX-512 masks live in the k registers, one bit per lane
+template <typename Rep>
+struct bit_mask<Rep, 512> {
+    static_assert(sizeof(Rep) == 4);
+
+    __mmask16 data;
+
+    static constexpr size_t size = 16;
+
+    // lanes [0, n) are set and the remaining lanes are clear
+    static bit_mask<Rep, 512> first_n(size_t n) {
+        return {static_cast<__mmask16>(n >= size ? 0xffff : (1u << n) - 1)};
+    }
+
+    friend bit_mask<Rep, 512>
+    operator&(bit_mask<Rep, 512> lhs, bit_mask<Rep, 512> rhs) {
+        return {static_cast<__mmask16>(lhs.data & rhs.data)};
+    }
+
+    friend bit_mask<Rep, 512>
+    operator|(bit_mask<Rep, 512> lhs, bit_mask<Rep, 512> rhs) {
+        return {static_cast<__mmask16>(lhs.data | rhs.data)};
+    }
+
+    friend bit_mask<Rep, 512>
+    operator^(bit_mask<Rep, 512> lhs, bit_mask<Rep, 512> rhs) {
+        return {static_cast<__mmask16>(lhs.data ^ rhs.data)};
+    }
+
+    bit_mask<Rep, 512> operator~() const {
+        return {static_cast<__mmask16>(~data)};
+    }
+
+    bool operator==(bit_mask<Rep, 512> rhs) const { return data == rhs.data; }
+
+    template <typename Other>
+    explicit operator bit_mask<Other, 512>() const {
+        return {data};
+    }
+};
+
+template <typename Rep>
+int movemask(bit_mask<Rep, 512> mask) {
+    return mask.data;
+}
+
+template <typename Rep>
+bool any(bit_mask<Rep, 512> mask) {
+    return mask.data != 0;
+}
+
+template <typename Rep>
+bool all(bit_mask<Rep, 512> mask) {
+    return mask.data == 0xffff;
+}
+
+template <typename Rep>
+bool none(bit_mask<Rep, 512> mask) {
+    return mask.data == 0;
+}
+
+template <typename Rep>
+int popcount(bit_mask<Rep, 512> mask) {
+    return __builtin_popcount(mask.data);
+}
+
+template <>
+struct bit_vector<float, 512>;
+template <>
+struct bit_vector<int32_t, 512>;
+
+template <>
+struct bit_vector<int32_t, 512> {
+    __m512i data;
+
+    using mask_type = bit_mask<int32_t, 512>;
+
+    static constexpr size_t width_bytes = 64;
+    static constexpr size_t size        = 16;
+
+    static bit_vector<int32_t, 512>
+    from(int32_t i15,
+         int32_t i14,
+         int32_t i13,
+         int32_t i12,
+         int32_t i11,
+         int32_t i10,
+         int32_t i9,
+         int32_t i8,
+         int32_t i7,
+         int32_t i6,
+         int32_t i5,
+         int32_t i4,
+         int32_t i3,
+         int32_t i2,
+         int32_t i1,
+         int32_t i0) {
+        return {_mm512_set_epi32(
+                i0,
+                i1,
+                i2,
+                i3,
+                i4,
+                i5,
+                i6,
+                i7,
+                i8,
+                i9,
+                i10,
+                i11,
+                i12,
+                i13,
+                i14,
+                i15)};
+    }
+
+    static bit_vector<int32_t, 512> broadcast(int32_t value) {
+        return {_mm512_set1_epi32(value)};
+    }
+
+    static bit_vector<int32_t, 512> load(aligned_view<int32_t, 64> ptr) {
+        return {_mm512_load_si512(ptr.get())};
+    }
+
+    static bit_vector<int32_t, 512> load(unaligned_view<int32_t> ptr) {
+        return {_mm512_loadu_si512(ptr.get())};
+    }
+
+    // masked out lanes are zeroed and never read
+    static bit_vector<int32_t, 512>
+    load(unaligned_view<int32_t> ptr, mask_type mask) {
+        return {_mm512_maskz_loadu_epi32(mask.data, ptr.get())};
+    }
+
+    void store(aligned_view<int32_t, 64> ptr) const {
+        _mm512_store_si512(ptr.get(), data);
+    }
+
+    void store(unaligned_view<int32_t> ptr) const {
+        _mm512_storeu_si512(ptr.get(), data);
+    }
+
+    void store(unaligned_view<int32_t> ptr, mask_type mask) const {
+        _mm512_mask_storeu_epi32(ptr.get(), mask.data, data);
+    }
+
+    void stream(aligned_view<int32_t, 64> ptr) const {
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(ptr.get()), data);
+    }
+
+    static mask_type first_n_mask(size_t n) {
+        return mask_type::first_n(n);
+    }
+
+    explicit operator bit_vector<float, 512>() const;
+
+    friend bit_vector<int32_t, 512>
+    operator+(bit_vector<int32_t, 512> lhs, bit_vector<int32_t, 512> rhs) {
+        return {_mm512_add_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 512>
+    operator-(bit_vector<int32_t, 512> lhs, bit_vector<int32_t, 512> rhs) {
+        return {_mm512_sub_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 512>
+    operator*(bit_vector<int32_t, 512> lhs, bit_vector<int32_t, 512> rhs) {
+        return {_mm512_mullo_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 512>
+    operator&(bit_vector<int32_t, 512> lhs, bit_vector<int32_t, 512> rhs) {
+        return {_mm512_and_si512(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 512>
+    operator|(bit_vector<int32_t, 512> lhs, bit_vector<int32_t, 512> rhs) {
+        return {_mm512_or_si512(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 512>
+    operator^(bit_vector<int32_t, 512> lhs, bit_vector<int32_t, 512> rhs) {
+        return {_mm512_xor_si512(lhs.data, rhs.data)};
+    }
+
+    bit_vector<int32_t, 512> operator-() const {
+        return {_mm512_sub_epi32(_mm512_setzero_si512(), data)};
+    }
+
+    // shifts every lane by the same number of bits; >> is arithmetic
+    friend bit_vector<int32_t, 512>
+    operator<<(bit_vector<int32_t, 512> lhs, int count) {
+        return {_mm512_sll_epi32(lhs.data, _mm_cvtsi32_si128(count))};
+    }
+
+    friend bit_vector<int32_t, 512>
+    operator>>(bit_vector<int32_t, 512> lhs, int count) {
+        return {_mm512_sra_epi32(lhs.data, _mm_cvtsi32_si128(count))};
+    }
+
+    // shifts each lane by the count in the matching lane of rhs
+    friend bit_vector<int32_t, 512>
+    operator<<(bit_vector<int32_t, 512> lhs, bit_vector<int32_t, 512> rhs) {
+        return {_mm512_sllv_epi32(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<int32_t, 512>
+    operator>>(bit_vector<int32_t, 512> lhs, bit_vector<int32_t, 512> rhs) {
+        return {_mm512_srav_epi32(lhs.data, rhs.data)};
+    }
+
+    bit_vector<int32_t, 512>& operator+=(bit_vector<int32_t, 512> rhs) {
+        data = _mm512_add_epi32(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 512>& operator-=(bit_vector<int32_t, 512> rhs) {
+        data = _mm512_sub_epi32(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 512>& operator*=(bit_vector<int32_t, 512> rhs) {
+        data = _mm512_mullo_epi32(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 512>& operator&=(bit_vector<int32_t, 512> rhs) {
+        data = _mm512_and_si512(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 512>& operator|=(bit_vector<int32_t, 512> rhs) {
+        data = _mm512_or_si512(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<int32_t, 512>& operator^=(bit_vector<int32_t, 512> rhs) {
+        data = _mm512_xor_si512(data, rhs.data);
+        return *this;
+    }
+
+    bool operator==(bit_vector<int32_t, 512> rhs) const {
+        return _mm512_cmpneq_epi32_mask(data, rhs.data) == 0;
+    }
+
+    bit_vector<int32_t, 256> low_bits() const {
+        return {_mm512_castsi512_si256(data)};
+    }
+    bit_vector<int32_t, 256> high_bits() const {
+        return {_mm512_extracti64x4_epi64(data, 1)};
+    }
+};
+
+template <>
+struct bit_vector<float, 512> {
+    __m512 data;
+
+    using mask_type = bit_mask<float, 512>;
+
+    static constexpr size_t width_bytes = 64;
+    static constexpr size_t size        = 16;
+
+    static bit_vector<float, 512>
+    from(float f15,
+         float f14,
+         float f13,
+         float f12,
+         float f11,
+         float f10,
+         float f9,
+         float f8,
+         float f7,
+         float f6,
+         float f5,
+         float f4,
+         float f3,
+         float f2,
+         float f1,
+         float f0) {
+        return {_mm512_set_ps(
+                f0,
+                f1,
+                f2,
+                f3,
+                f4,
+                f5,
+                f6,
+                f7,
+                f8,
+                f9,
+                f10,
+                f11,
+                f12,
+                f13,
+                f14,
+                f15)};
+    }
+
+    static bit_vector<float, 512> broadcast(float value) {
+        return {_mm512_set1_ps(value)};
+    }
+
+    static bit_vector<float, 512> load(aligned_view<float, 64> ptr) {
+        return {_mm512_load_ps(ptr.get())};
+    }
+
+    static bit_vector<float, 512> load(unaligned_view<float> ptr) {
+        return {_mm512_loadu_ps(ptr.get())};
+    }
+
+    // the four floats at ptr in every 128-bit lane
+    static bit_vector<float, 512> broadcast_lanes(unaligned_view<float> ptr) {
+        return {_mm512_broadcast_f32x4(_mm_loadu_ps(ptr.get()))};
+    }
+
+    // masked out lanes are zeroed and never read
+    static bit_vector<float, 512>
+    load(unaligned_view<float> ptr, mask_type mask) {
+        return {_mm512_maskz_loadu_ps(mask.data, ptr.get())};
+    }
+
+    template <int Scale = sizeof(float)>
+    static bit_vector<float, 512>
+    gather(unaligned_view<float> base, bit_vector<int32_t, 512> offsets) {
+        return {_mm512_i32gather_ps(offsets.data, base.get(), Scale)};
+    }
+
+    void store(aligned_view<float, 64> ptr) const {
+        _mm512_store_ps(ptr.get(), data);
+    }
+
+    void store(unaligned_view<float> ptr) const {
+        _mm512_storeu_ps(ptr.get(), data);
+    }
+
+    void store(unaligned_view<float> ptr, mask_type mask) const {
+        _mm512_mask_storeu_ps(ptr.get(), mask.data, data);
+    }
+
+    void stream(aligned_view<float, 64> ptr) const {
+        _mm512_stream_ps(ptr.get(), data);
+    }
+
+    static mask_type first_n_mask(size_t n) {
+        return mask_type::first_n(n);
+    }
+
+    explicit operator bit_vector<int32_t, 512>() const;
+
+    friend bit_vector<float, 512>
+    operator+(bit_vector<float, 512> lhs, bit_vector<float, 512> rhs) {
+        return {_mm512_add_ps(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<float, 512>
+    operator-(bit_vector<float, 512> lhs, bit_vector<float, 512> rhs) {
+        return {_mm512_sub_ps(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<float, 512>
+    operator*(bit_vector<float, 512> lhs, bit_vector<float, 512> rhs) {
+        return {_mm512_mul_ps(lhs.data, rhs.data)};
+    }
+
+    friend bit_vector<float, 512>
+    operator/(bit_vector<float, 512> lhs, bit_vector<float, 512> rhs) {
+        return {_mm512_div_ps(lhs.data, rhs.data)};
+    }
+
+    // flips the sign bit, so -0.0 and NaN payloads are preserved
+    bit_vector<float, 512> operator-() const {
+        return {_mm512_castsi512_ps(_mm512_xor_si512(
+                _mm512_castps_si512(data), _mm512_set1_epi32(INT32_MIN)))};
+    }
+
+    bit_vector<float, 512>& operator+=(bit_vector<float, 512> rhs) {
+        data = _mm512_add_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 512>& operator-=(bit_vector<float, 512> rhs) {
+        data = _mm512_sub_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 512>& operator*=(bit_vector<float, 512> rhs) {
+        data = _mm512_mul_ps(data, rhs.data);
+        return *this;
+    }
+
+    bit_vector<float, 512>& operator/=(bit_vector<float, 512> rhs) {
+        data = _mm512_div_ps(data, rhs.data);
+        return *this;
+    }
+
+    bool operator==(bit_vector<float, 512> rhs) const {
+        // compare not equal, unordered, non-signaling
+        return _mm512_cmp_ps_mask(data, rhs.data, _CMP_NEQ_UQ) == 0;
+    }
+
+    bit_vector<float, 256> low_bits() const {
+        return {_mm512_castps512_ps256(data)};
+    }
+    bit_vector<float, 256> high_bits() const {
+        return {_mm256_castsi256_ps(_mm512_extracti64x4_epi64(
+                _mm512_castps_si512(data), 1))};
+    }
+};
+
+using i32x16 = bit_vector<int32_t, 512>;
+using f32x16 = bit_vector<float, 512>;
+
+inline bit_vector<int32_t, 512>::operator bit_vector<float, 512>() const {
+    return {_mm512_castsi512_ps(data)};
+}
+
+inline bit_vector<float, 512>::operator bit_vector<int32_t, 512>() const {
+    return {_mm512_castps_si512(data)};
+}
+
+///// min / max /////
+
+inline f32x16 min(f32x16 v1, f32x16 v2) {
+    return {_mm512_min_ps(v1.data, v2.data)};
+}
+
+inline f32x16 max(f32x16 v1, f32x16 v2) {
+    return {_mm512_max_ps(v1.data, v2.data)};
+}
+
+inline i32x16 min(i32x16 v1, i32x16 v2) {
+    return {_mm512_min_epi32(v1.data, v2.data)};
+}
+
+inline i32x16 max(i32x16 v1, i32x16 v2) {
+    return {_mm512_max_epi32(v1.data, v2.data)};
+}
+
+///// abs /////
+
+inline f32x16 abs(f32x16 v) {
+    return {_mm512_abs_ps(v.data)};
+}
+
+inline i32x16 abs(i32x16 v) {
+    return {_mm512_abs_epi32(v.data)};
+}
+
+///// sqrt /////
+
+inline f32x16 sqrt(f32x16 v) {
+    return {_mm512_sqrt_ps(v.data)};
+}
+
+// relative error of at most 2^-14
+inline f32x16 rsqrt(f32x16 v) {
+    return {_mm512_rsqrt14_ps(v.data)};
+}
+
+///// andnot /////
+
+inline f32x16 andnot(f32x16 v1, f32x16 v2) {
+    return {_mm512_castsi512_ps(_mm512_andnot_si512(
+            _mm512_castps_si512(v1.data), _mm512_castps_si512(v2.data)))};
+}
+
+inline i32x16 andnot(i32x16 v1, i32x16 v2) {
+    return {_mm512_andnot_si512(v1.data, v2.data)};
+}
+
+///// fma /////
+
+inline f32x16 fmadd(f32x16 a, f32x16 b, f32x16 c) {
+    return {_mm512_fmadd_ps(a.data, b.data, c.data)};
+}
+
+inline f32x16 fmsub(f32x16 a, f32x16 b, f32x16 c) {
+    return {_mm512_fmsub_ps(a.data, b.data, c.data)};
+}
+
+inline f32x16 fnmadd(f32x16 a, f32x16 b, f32x16 c) {
+    return {_mm512_fnmadd_ps(a.data, b.data, c.data)};
+}
+
+inline i32x16 fmadd(i32x16 a, i32x16 b, i32x16 c) {
+    return a * b + c;
+}
+
+inline i32x16 fmsub(i32x16 a, i32x16 b, i32x16 c) {
+    return a * b - c;
+}
+
+inline i32x16 fnmadd(i32x16 a, i32x16 b, i32x16 c) {
+    return c - a * b;
+}
+
+///// compare /////
+
+inline f32x16::mask_type cmp_lt(f32x16 v1, f32x16 v2) {
+    return {_mm512_cmp_ps_mask(v1.data, v2.data, _CMP_LT_OQ)};
+}
+
+inline f32x16::mask_type cmp_le(f32x16 v1, f32x16 v2) {
+    return {_mm512_cmp_ps_mask(v1.data, v2.data, _CMP_LE_OQ)};
+}
+
+inline f32x16::mask_type cmp_gt(f32x16 v1, f32x16 v2) {
+    return {_mm512_cmp_ps_mask(v1.data, v2.data, _CMP_GT_OQ)};
+}
+
+inline f32x16::mask_type cmp_ge(f32x16 v1, f32x16 v2) {
+    return {_mm512_cmp_ps_mask(v1.data, v2.data, _CMP_GE_OQ)};
+}
+
+inline f32x16::mask_type cmp_eq(f32x16 v1, f32x16 v2) {
+    return {_mm512_cmp_ps_mask(v1.data, v2.data, _CMP_EQ_OQ)};
+}
+
+inline f32x16::mask_type cmp_ne(f32x16 v1, f32x16 v2) {
+    return {_mm512_cmp_ps_mask(v1.data, v2.data, _CMP_NEQ_UQ)};
+}
+
+inline i32x16::mask_type cmp_lt(i32x16 v1, i32x16 v2) {
+    return {_mm512_cmp_epi32_mask(v1.data, v2.data, _MM_CMPINT_LT)};
+}
+
+inline i32x16::mask_type cmp_le(i32x16 v1, i32x16 v2) {
+    return {_mm512_cmp_epi32_mask(v1.data, v2.data, _MM_CMPINT_LE)};
+}
+
+inline i32x16::mask_type cmp_gt(i32x16 v1, i32x16 v2) {
+    return {_mm512_cmp_epi32_mask(v1.data, v2.data, _MM_CMPINT_NLE)};
+}
+
+inline i32x16::mask_type cmp_ge(i32x16 v1, i32x16 v2) {
+    return {_mm512_cmp_epi32_mask(v1.data, v2.data, _MM_CMPINT_NLT)};
+}
+
+inline i32x16::mask_type cmp_eq(i32x16 v1, i32x16 v2) {
+    return {_mm512_cmp_epi32_mask(v1.data, v2.data, _MM_CMPINT_EQ)};
+}
+
+inline i32x16::mask_type cmp_ne(i32x16 v1, i32x16 v2) {
+    return {_mm512_cmp_epi32_mask(v1.data, v2.data, _MM_CMPINT_NE)};
+}
+
+///// select /////
+
+inline f32x16 select(f32x16::mask_type mask, f32x16 v1, f32x16 v2) {
+    return {_mm512_mask_blend_ps(mask.data, v2.data, v1.data)};
+}
+
+inline i32x16 select(i32x16::mask_type mask, i32x16 v1, i32x16 v2) {
+    return {_mm512_mask_blend_epi32(mask.data, v2.data, v1.data)};
+}
+
+///// permutex2var /////
+
+// lane i of the result is lane idx[i] of the 32 lane concatenation [v1, v2]
+inline f32x16 permutex2var(f32x16 v1, i32x16 idx, f32x16 v2) {
+    return {_mm512_permutex2var_ps(v1.data, idx.data, v2.data)};
+}
+
+inline i32x16 permutex2var(i32x16 v1, i32x16 idx, i32x16 v2) {
+    return {_mm512_permutex2var_epi32(v1.data, idx.data, v2.data)};
+}
+
+///// transpose /////
+
+// the 4x4 matrix with rows r0, r1, r2, r3 in m, transposed
+inline f32x16 transpose4x4(f32x16 m) {
+    const auto order = i32x16::from(
+            0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    return {_mm512_permutexvar_ps(order.data, m.data)};
+}
+
+///// shuffle /////
+
+// permutes the lanes within each 128-bit lane
+template <unsigned... flags>
+inline f32x16 shuffle(f32x16 v, control4<flags...>) {
+    return {_mm512_permute_ps(v.data, control4<flags...>::value)};
+}
+
+///// permute /////
+
+inline f32x16 swap_pairs(f32x16 v) {
+    constexpr int swap = control4<1, 0, 3, 2>::value;
+    return {_mm512_permute_ps(v.data, swap)};
+}
+
+inline f32x16 duplicate_even(f32x16 v) {
+    return {_mm512_moveldup_ps(v.data)};
+}
+
+inline f32x16 duplicate_odd(f32x16 v) {
+    return {_mm512_movehdup_ps(v.data)};
+}
+
+///// compress /////
+
+inline f32x16 compress(f32x16::mask_type mask, f32x16 v) {
+    return {_mm512_maskz_compress_ps(mask.data, v.data)};
+}
+
+inline i32x16 compress(i32x16::mask_type mask, i32x16 v) {
+    return {_mm512_maskz_compress_epi32(mask.data, v.data)};
+}
+
+inline size_t
+compress_store(f32x16::mask_type mask, f32x16 v, unaligned_view<float> out) {
+    _mm512_mask_compressstoreu_ps(out.get(), mask.data, v.data);
+    return popcount(mask);
+}
+
+inline size_t compress_store(
+        i32x16::mask_type mask, i32x16 v, unaligned_view<int32_t> out) {
+    _mm512_mask_compressstoreu_epi32(out.get(), mask.data, v.data);
+    return popcount(mask);
+}
+
+///// reduce /////
+
+namespace detail {
+
+template <typename Op>
+inline float reduce(f32x16 v, Op op) {
+    const __m512d bits = _mm512_castps_pd(v.data);
+    return reduce(
+            op(f32x8{_mm512_castps512_ps256(v.data)},
+               f32x8{_mm256_castpd_ps(_mm512_extractf64x4_pd(bits, 1))}),
+            op);
+}
+
+template <typename Op>
+inline int32_t reduce(i32x16 v, Op op) {
+    return reduce(
+            op(i32x8{_mm512_castsi512_si256(v.data)},
+               i32x8{_mm512_extracti64x4_epi64(v.data, 1)}),
+            op);
+}
+
+}  // namespace detail
+
+#endif
+
+///// reduce /////
+
+// combine every lane of a register into a single scalar
+
+template <typename Rep, size_t Bits>
+inline Rep reduce_add(bit_vector<Rep, Bits> v) {
+    return detail::reduce(v, [](auto a, auto b) { return a + b; });
+}
+
+template <typename Rep, size_t Bits>
+inline Rep reduce_mul(bit_vector<Rep, Bits> v) {
+    return detail::reduce(v, [](auto a, auto b) { return a * b; });
+}
+
+template <typename Rep, size_t Bits>
+inline Rep reduce_min(bit_vector<Rep, Bits> v) {
+    return detail::reduce(v, [](auto a, auto b) { return min(a, b); });
+}
+
+template <typename Rep, size_t Bits>
+inline Rep reduce_max(bit_vector<Rep, Bits> v) {
+    return detail::reduce(v, [](auto a, auto b) { return max(a, b); });
+}
+
+// bitwise reductions are only defined for integral lanes
+template <size_t Bits>
+inline int32_t reduce_and(bit_vector<int32_t, Bits> v) {
+    return detail::reduce(v, [](auto a, auto b) { return a & b; });
+}
+
+template <size_t Bits>
+inline int32_t reduce_or(bit_vector<int32_t, Bits> v) {
+    return detail::reduce(v, [](auto a, auto b) { return a | b; });
 }
 
+}  // namespace SIMD_ISA_NAMESPACE
 }  // namespace simd
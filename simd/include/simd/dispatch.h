@@ -0,0 +1,26 @@
+#pragma once
+
+#include <simd/isa.h>
+
+#include <optional>
+#include <string_view>
+
+namespace simd {
+
+// best instruction set the running cpu and operating system support; cpuid
+// is only queried the first time
+isa detect_isa();
+
+// instruction set the dispatched kernels currently use. Defaults to
+// detect_isa(), or to the value of the SIMD_ISA environment variable (one of
+// "generic", "sse4.2", "avx2" or "avx512") when it is set
+isa active_isa();
+
+// makes the dispatched kernels use `target`, or the best supported isa below
+// it if the cpu cannot run `target`; returns the isa actually selected
+isa force_isa(isa target);
+
+const char* isa_name(isa value);
+std::optional<isa> parse_isa(std::string_view name);
+
+}  // namespace simd
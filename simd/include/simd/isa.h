@@ -0,0 +1,39 @@
+#pragma once
+
+// everything whose code generation depends on the target flags lives in an
+// inline namespace named after the instruction set it was compiled for, so
+// that translation units built with different flags never share (and never
+// swap at link time) an inline function
+#if defined(__AVX512F__)
+#define SIMD_ISA_NAMESPACE isa_avx512
+#elif defined(__AVX2__)
+#define SIMD_ISA_NAMESPACE isa_avx2
+#elif defined(__AVX__)
+#define SIMD_ISA_NAMESPACE isa_avx
+#elif defined(__SSE4_2__)
+#define SIMD_ISA_NAMESPACE isa_sse4_2
+#else
+#define SIMD_ISA_NAMESPACE isa_generic
+#endif
+
+// the value types (vectors, matrices, views, buffers) are the same type for
+// every isa, so that code built with different flags can pass them to each
+// other, and stay outside the namespace. Their arithmetic members carry its
+// name as abi tag instead, which keeps their symbols apart the same way;
+// members that only move pointers compile alike everywhere and are untagged
+#define SIMD_ISA_STRING_(name) #name
+#define SIMD_ISA_STRING(name) SIMD_ISA_STRING_(name)
+#define SIMD_ISA_TAGGED [[gnu::abi_tag(SIMD_ISA_STRING(SIMD_ISA_NAMESPACE))]]
+
+namespace simd {
+
+// instruction sets with a runtime dispatched kernel variant, in ascending
+// order of preference
+enum class isa {
+    generic,
+    sse4_2,
+    avx2,
+    avx512,
+};
+
+}  // namespace simd
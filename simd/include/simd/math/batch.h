@@ -0,0 +1,87 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/view.h>
+
+#include <array>
+#include <limits>
+#include <type_traits>
+
+namespace simd::math {
+
+// selects a normalize_n that refines the hardware reciprocal square root
+// estimate with one Newton-Raphson step instead of dividing by a correctly
+// rounded square root; the result is within a few ulp. Only float is
+// approximated; double results stay exact with every instruction set
+struct approximate_t {};
+inline constexpr approximate_t approximate{};
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+// the pieces shared by the vector2, vector3 and vector4 batch kernels
+namespace detail {
+
+template <typename T>
+inline constexpr bool simd_components
+        = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+#ifdef __AVX2__
+// applies op lane-wise to the components behind the inputs, finishing with
+// one masked iteration whose masked out lanes are never read or written
+template <typename SimdVector, typename T, typename Op, typename... Inputs>
+void transform_components(
+        unaligned_view<T> out, size_t components, Op op, Inputs... in) {
+    size_t i = 0;
+#pragma unroll 4
+    for (; i + SimdVector::size <= components; i += SimdVector::size) {
+        op(SimdVector::load(in + i)...).store(out + i);
+    }
+    if (i < components) {
+        const auto mask = SimdVector::first_n_mask(components - i);
+        op(SimdVector::load(in + i, mask)...).store(out + i, mask);
+    }
+}
+
+// the masks of Registers consecutive registers of which the first components
+// lanes are set
+template <typename SimdVector, size_t Registers>
+std::array<typename SimdVector::mask_type, Registers>
+register_masks(size_t components) {
+    std::array<typename SimdVector::mask_type, Registers> masks;
+    for (size_t k = 0; k < Registers; ++k) {
+        const size_t offset = k * SimdVector::size;
+        masks[k]            = SimdVector::first_n_mask(
+                components > offset ? components - offset : 0);
+    }
+    return masks;
+}
+
+// 1 / sqrt(x), refined from the estimate when Approximate. The estimate
+// takes subnormal x as 0, so x below FLT_MIN is scaled by 2^64 first and the
+// result by 2^32
+template <bool Approximate, typename SimdVector>
+SimdVector inverse_sqrt(SimdVector x) {
+    if constexpr (Approximate && !std::is_same_v<SimdVector, f64x4>) {
+        const auto tiny = simd::cmp_lt(
+                x, SimdVector::broadcast(std::numeric_limits<float>::min()));
+        x = simd::select(tiny, x * SimdVector::broadcast(0x1p64f), x);
+        const auto estimate = simd::rsqrt(x);
+        const auto half_x   = x * SimdVector::broadcast(0.5f);
+        const auto result   = estimate
+                            * simd::fnmadd(
+                                    half_x * estimate,
+                                    estimate,
+                                    SimdVector::broadcast(1.5f));
+        return simd::select(
+                tiny, result * SimdVector::broadcast(0x1p32f), result);
+    } else {
+        return SimdVector::broadcast(1) / simd::sqrt(x);
+    }
+}
+#endif
+
+}  // namespace detail
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <simd/math/vector2.h>
+#include <simd/view.h>
+
+#include <cstddef>
+
+// kernels compiled once per supported instruction set and selected at
+// runtime through simd::active_isa(); unlike the templates in the other math
+// headers they do not depend on the flags the caller is built with.
+//
+// Only the float and double vector2 dot_product_n are dispatched. Every
+// other kernel, including the integral dot products, dot_product_sum, the
+// soa, strided, indexed, streaming and parallel variants, filter, the batch
+// kernels, the transcendentals and the pairwise distances, is compiled with
+// the caller's flags. Those kernels take their generic or sse paths unless
+// the caller enables avx2 or avx512, e.g. with -march=native
+namespace simd::math::dispatch {
+
+void dot_product_n(
+        unaligned_view<vector2f> a,
+        unaligned_view<vector2f> b,
+        unaligned_view<float> out,
+        size_t n);
+
+void dot_product_n(
+        unaligned_view<vector2d> a,
+        unaligned_view<vector2d> b,
+        unaligned_view<double> out,
+        size_t n);
+
+}  // namespace simd::math::dispatch
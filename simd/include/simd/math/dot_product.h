@@ -2,26 +2,355 @@
 
 #include <simd/bit_vector.h>
 #include <simd/math/vector2.h>
+#include <simd/math/vector2_soa.h>
+#include <simd/memory.h>
+#include <simd/thread_pool.h>
 #include <simd/view.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
 namespace simd::math {
 
+// selects an integral dot_product_n that writes the component type and
+// keeps the low bits of every result
+struct wrapping_t {};
+inline constexpr wrapping_t wrapping{};
+
+// selects an integral dot_product_n that writes int32_t and clamps every
+// result to the int32_t range
+struct saturating_t {};
+inline constexpr saturating_t saturating{};
+
+// selects a dot_product_sum that carries a Kahan compensation term in every
+// accumulator lane; the products themselves are still rounded
+struct kahan_t {};
+inline constexpr kahan_t kahan{};
+
+// selects a dot_product_sum that adds blocks of products in a binary tree, so
+// the rounding error grows with log(n) rather than n
+struct pairwise_t {};
+inline constexpr pairwise_t pairwise{};
+
+// selects a dot_product_n that splits the arrays across a thread_pool
+struct parallel_t {};
+inline constexpr parallel_t parallel{};
+
+// below this many elements a parallel dot_product_n stays on the calling
+// thread, where waking the pool would cost more than the work
+inline constexpr size_t parallel_threshold = size_t(1) << 15;
+
+// elements per chunk handed to a thread. Every chunk starts on a cache line
+// of a, b and out, so no simd block is split between two threads
+inline constexpr size_t parallel_grain = size_t(1) << 13;
+
+// selects a dot_product_n that writes out with non-temporal stores, which
+// skip the read for ownership and leave the caches to the inputs
+struct streaming_t {};
+inline constexpr streaming_t streaming{};
+
+// streaming never pays off for outputs that fit in the inner caches, so
+// dot_product_n only consults streaming_threshold() from this size on
+inline constexpr size_t min_streaming_bytes = size_t(1) << 18;
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+namespace detail {
+
+// whether dot_product_n streams an output of n elements by default
+template <typename T>
+bool streams_output(size_t n) {
+    const size_t bytes = n * sizeof(T);
+    return bytes >= min_streaming_bytes && bytes >= streaming_threshold();
+}
+
+// prefetches the Bytes of a and b that a loop iteration at component i
+// reads, `distance` components ahead; a no-op for distance 0
+template <size_t Bytes, typename T>
+void prefetch_ahead(const T* a, const T* b, size_t i, size_t distance) {
+    if (distance == 0) {
+        return;
+    }
+    for (size_t line = 0; line < Bytes; line += 64) {
+        const size_t ahead = i + distance + line / sizeof(T);
+        simd::prefetch(unaligned_view<const T>{a}, ahead);
+        simd::prefetch(unaligned_view<const T>{b}, ahead);
+    }
+}
+
+template <bool Stream, typename SimdVector, typename View>
+void store_block(SimdVector value, View out) {
+    if constexpr (Stream) {
+        value.stream(out);
+    } else {
+        value.store(out);
+    }
+}
+
+// dot products of SimdVector::size consecutive vector2 pairs, where lo holds
+// the first half of the pairs and hi the second
+template <typename SimdVector>
+SimdVector dot_product_block(
+        SimdVector a_lo, SimdVector a_hi, SimdVector b_lo, SimdVector b_hi) {
+    // [a0x*b0x, a0y*b0y, a1x*b1x, a1y*b1y, ...]
+    auto prod_lo = a_lo * b_lo;
+    auto prod_hi = a_hi * b_hi;
+
+    // [r0, r1, r4, r5, r2, r3, r6, r7] (if 32x8)
+    // [r0, r2, r1, r3] (if 64x4)
+    auto interleaved = simd::hadd(prod_lo, prod_hi);
+    return simd::permute4x64(interleaved, simd::control4<0, 2, 1, 3>());
+}
+
+#ifdef __AVX512F__
+// dot products of 16 consecutive vector2f pairs; AVX-512 has no hadd, so the
+// x and y products are gathered across both registers and added instead
+inline f32x16 dot_product_block(
+        f32x16 a_lo, f32x16 a_hi, f32x16 b_lo, f32x16 b_hi) {
+    const auto even = i32x16::from(
+            0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const auto odd = i32x16::from(
+            1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+
+    // [a0x*b0x, a0y*b0y, a1x*b1x, a1y*b1y, ...]
+    auto prod_lo = a_lo * b_lo;
+    auto prod_hi = a_hi * b_hi;
+
+    // [a0x*b0x, a1x*b1x, ...] + [a0y*b0y, a1y*b1y, ...]
+    return simd::permutex2var(prod_lo, even, prod_hi)
+           + simd::permutex2var(prod_lo, odd, prod_hi);
+}
+#endif
+
+// computes n < SimdVector::size dot products in a single masked iteration;
+// masked out lanes are never read or written
+template <typename SimdVector, typename T>
+void dot_product_masked_block(
+        unaligned_view<T> a,
+        unaligned_view<T> b,
+        unaligned_view<T> out,
+        size_t n) {
+    const size_t components = n * 2;
+    const auto mask_lo      = SimdVector::first_n_mask(components);
+    const auto mask_hi      = SimdVector::first_n_mask(
+            components > SimdVector::size ? components - SimdVector::size : 0);
+
+    auto result = dot_product_block(
+            SimdVector::load(a, mask_lo),
+            SimdVector::load(a + SimdVector::size, mask_hi),
+            SimdVector::load(b, mask_lo),
+            SimdVector::load(b + SimdVector::size, mask_hi));
+    result.store(out, SimdVector::first_n_mask(n));
+}
+
+#ifdef __SSE3__
+// 4 (float) or 2 (double) dot products per iteration; at 128 bits hadd
+// already yields the results in order. SSE has no masked loads, so the tail
+// is copied into zero padded registers rather than finished with scalar code,
+// which could contract into a differently rounded fma
+template <typename T>
+void dot_product_n_sse(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<T> out,
+        size_t n) {
+    using SimdVector = simd::bit_vector<T, 128>;
+
+    auto block = [](unaligned_view<T> a, unaligned_view<T> b) {
+        auto prod_lo = SimdVector::load(a) * SimdVector::load(b);
+        auto prod_hi = SimdVector::load(a + SimdVector::size)
+                       * SimdVector::load(b + SimdVector::size);
+        return simd::hadd(prod_lo, prod_hi);
+    };
+
+    auto af  = a.template as<T>();
+    auto bf  = b.template as<T>();
+    size_t i = 0;
+#pragma unroll 4
+    for (; i + SimdVector::size <= n; i += SimdVector::size) {
+        block(af + i * 2, bf + i * 2).store(out + i);
+    }
+    if (i < n) {
+        T a_tail[SimdVector::size * 2] = {};
+        T b_tail[SimdVector::size * 2] = {};
+        T result[SimdVector::size];
+        std::copy_n(af.get() + i * 2, (n - i) * 2, a_tail);
+        std::copy_n(bf.get() + i * 2, (n - i) * 2, b_tail);
+        block(unaligned_view<T>{a_tail}, unaligned_view<T>{b_tail})
+                .store(unaligned_view<T>{result});
+        std::copy_n(result, n - i, out.get() + i);
+    }
+}
+#endif
+
+#ifdef __AVX2__
+// 8 (float) or 4 (double) dot products per iteration; a masked head is
+// peeled so that every store in the steady state loop is aligned while the
+// loads stay unaligned, which also lets those stores stream. The head and
+// tail go through dot_product_block like the loop, so every result rounds
+// the same way whatever the alignment of out
+template <typename T, bool Stream = false>
+void dot_product_n_avx(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<T> out,
+        size_t n) {
+    using SimdVector   = simd::bit_vector<T, 256>;
+    using ByteViewType = aligned_view<T, SimdVector::width_bytes>;
+
+    auto af = a.template as<T>();
+    auto bf = b.template as<T>();
+
+    const size_t misalignment
+            = reinterpret_cast<uintptr_t>(out.get()) % SimdVector::width_bytes;
+    const size_t head = std::min<size_t>(
+            n,
+            misalignment == 0
+                    ? 0
+                    : (SimdVector::width_bytes - misalignment) / sizeof(T));
+    size_t i = 0;
+    if (head > 0) {
+        dot_product_masked_block<SimdVector>(af, bf, out, head);
+        i = head;
+    }
+
+    const size_t lookahead = simd::prefetch_distance() * 2;
+#pragma unroll 4
+    for (; i + SimdVector::size <= n; i += SimdVector::size) {
+        prefetch_ahead<SimdVector::width_bytes * 2>(
+                af.get(), bf.get(), i * 2, lookahead);
+        auto result = dot_product_block(
+                SimdVector::load(af + i * 2),
+                SimdVector::load(af + i * 2 + SimdVector::size),
+                SimdVector::load(bf + i * 2),
+                SimdVector::load(bf + i * 2 + SimdVector::size));
+        store_block<Stream>(result, ByteViewType{out.get() + i});
+    }
+    if constexpr (Stream) {
+        simd::stream_fence();
+    }
+    if (i < n) {
+        dot_product_masked_block<SimdVector>(
+                af + i * 2, bf + i * 2, out + i, n - i);
+    }
+}
+#endif
+
+#ifdef __AVX512F__
+// 16 dot products per iteration; the head up to the first 64-byte aligned
+// output is handled with one masked iteration rather than a scalar loop
+template <bool Stream = false>
+void dot_product_n_avx512(
+        unaligned_view<vector2f> a,
+        unaligned_view<vector2f> b,
+        unaligned_view<float> out,
+        size_t n) {
+    using ByteViewType = aligned_view<float, f32x16::width_bytes>;
+
+    auto af = a.as<float>();
+    auto bf = b.as<float>();
+
+    const size_t misalignment
+            = reinterpret_cast<uintptr_t>(out.get()) % f32x16::width_bytes;
+    const size_t head = std::min<size_t>(
+            n,
+            misalignment == 0
+                    ? 0
+                    : (f32x16::width_bytes - misalignment) / sizeof(float));
+    size_t i = 0;
+    if (head > 0) {
+        dot_product_masked_block<f32x16>(af, bf, out, head);
+        i = head;
+    }
+
+    const size_t lookahead = simd::prefetch_distance() * 2;
+#pragma unroll 4
+    for (; i + f32x16::size <= n; i += f32x16::size) {
+        prefetch_ahead<f32x16::width_bytes * 2>(
+                af.get(), bf.get(), i * 2, lookahead);
+        auto result = dot_product_block(
+                f32x16::load(af + i * 2),
+                f32x16::load(af + i * 2 + f32x16::size),
+                f32x16::load(bf + i * 2),
+                f32x16::load(bf + i * 2 + f32x16::size));
+        store_block<Stream>(result, ByteViewType{out.get() + i});
+    }
+    if constexpr (Stream) {
+        simd::stream_fence();
+    }
+    if (i < n) {
+        dot_product_masked_block<f32x16>(
+                af + i * 2, bf + i * 2, out + i, n - i);
+    }
+}
+#endif
+
+// Stream only takes effect with avx2 or avx512, where the steady state stores
+// are aligned
+template <bool Stream, typename T>
+void dot_product_n_unaligned(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<T> out,
+        size_t n) {
+#ifdef __AVX512F__
+    if constexpr (std::is_same_v<T, float>) {
+        dot_product_n_avx512<Stream>(a, b, out, n);
+        return;
+    }
+#endif
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        dot_product_n_avx<T, Stream>(a, b, out, n);
+        return;
+    }
+#endif
+#ifdef __SSE3__
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        dot_product_n_sse(a, b, out, n);
+        return;
+    }
+#endif
+#pragma unroll 4
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i].dot(b[i]);
+    }
+}
+
+}  // namespace detail
+
 template <typename ComponentType, typename IterationCountType, size_t Alignment>
 void dot_product_n(
         aligned_view<vector2<ComponentType>, Alignment> a,
         aligned_view<vector2<ComponentType>, Alignment> b,
         aligned_view<ComponentType, Alignment> out,
         IterationCountType n) {
-    // TODO: it currently only supports floating point types because integrals
-    // would require twice the number of output bits
+    // integral products need twice the number of output bits; narrow outputs
+    // must be requested with the wrapping or saturating tags
     static_assert(
             std::is_floating_point_v<ComponentType>,
-            "dot_product_n only supports floating point types");
-    auto af  = a.template as<ComponentType>();
-    auto bf  = b.template as<ComponentType>();
+            "integral dot_product_n requires a wider output type or an "
+            "explicit wrapping/saturating tag");
+    if (detail::streams_output<ComponentType>(n)) {
+        dot_product_n(a, b, out, n, streaming);
+        return;
+    }
+#ifdef __AVX512F__
+    if constexpr (std::is_same_v<ComponentType, float>) {
+        detail::dot_product_n_avx512(
+                unaligned_view<vector2f>{a.get()},
+                unaligned_view<vector2f>{b.get()},
+                unaligned_view<float>{out.get()},
+                n);
+        return;
+    }
+#endif
     size_t i = 0;
-#ifdef __AVX__
+#ifdef __AVX2__
     if constexpr (Alignment >= 32) {
+        auto af = a.template as<ComponentType>();
+        auto bf = b.template as<ComponentType>();
         using SimdVector = simd::bit_vector<ComponentType, 256>;
         using ByteViewType
                 = aligned_view<ComponentType, SimdVector::width_bytes>;
@@ -29,31 +358,41 @@ void dot_product_n(
         ByteViewType bf_view = bf;
         const size_t simd_iterations
                 = n / ByteViewType::size;  // intentionally truncates
+        const size_t lookahead = simd::prefetch_distance() * 2;
 #pragma unroll 4
-        for (; i + 2 <= simd_iterations; ++i) {
-            // [a1x*b1x, a1y*b1y, a2x*b2x, a2y*b2y, ...]
-            auto prod_0_3 = SimdVector::load(af_view + i * 2)
-                            * SimdVector::load(bf_view + i * 2);
-
-            // [a4x*b4x, a4y*b4y, a5x*b5x, a5y*b5y, ...]
-            auto prod_4_7 = SimdVector::load(af_view + 1 + i * 2)
-                            * SimdVector::load(bf_view + 1 + i * 2);
-
-            // [r0, r1, r4, r5, r2, r3, r6, r7] (if 32x8)
-            // [r0, r2, r1, r3] (if 64x4)
-            auto interleaved = simd::hadd(prod_0_3, prod_4_7);
-            auto result      = simd::permute4x64(
-                    interleaved, simd::control4<0, 2, 1, 3>());
-
-            result.store(out + i);
+        for (; i < simd_iterations; ++i) {
+            detail::prefetch_ahead<SimdVector::width_bytes * 2>(
+                    af.get(), bf.get(), i * SimdVector::size * 2, lookahead);
+            auto result = detail::dot_product_block(
+                    SimdVector::load(af_view + i * 2),
+                    SimdVector::load(af_view + 1 + i * 2),
+                    SimdVector::load(bf_view + i * 2),
+                    SimdVector::load(bf_view + 1 + i * 2));
+            result.store(ByteViewType{out.get() + i * SimdVector::size});
         }
         i *= ByteViewType::size;
+        if (i < n) {
+            detail::dot_product_masked_block<SimdVector>(
+                    unaligned_view<ComponentType>{af.get() + i * 2},
+                    unaligned_view<ComponentType>{bf.get() + i * 2},
+                    unaligned_view<ComponentType>{out.get() + i},
+                    n - i);
+            return;
+        }
     }
 #endif
+#ifdef __SSE3__
+    detail::dot_product_n_sse(
+            unaligned_view<vector2<ComponentType>>{a.get() + i},
+            unaligned_view<vector2<ComponentType>>{b.get() + i},
+            unaligned_view<ComponentType>{out.get() + i},
+            n - i);
+#else
 #pragma unroll 4
     for (; i < n; ++i) {
         out[i] = a[i].dot(b[i]);
     }
+#endif
 }
 
 template <typename T, typename IterationType>
@@ -62,10 +401,829 @@ inline void dot_product_n(
         unaligned_view<vector2<T>> b,
         unaligned_view<T> out,
         IterationType n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "integral dot_product_n requires a wider output type or an "
+            "explicit wrapping/saturating tag");
+    if (detail::streams_output<T>(n)) {
+        detail::dot_product_n_unaligned<true>(a, b, out, n);
+    } else {
+        detail::dot_product_n_unaligned<false>(a, b, out, n);
+    }
+}
+
+template <typename T, typename IterationType>
+void dot_product_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<T> out,
+        IterationType n,
+        streaming_t) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "streaming dot_product_n requires floating point components");
+    detail::dot_product_n_unaligned<true>(a, b, out, n);
+}
+
+template <typename T, typename IterationType, size_t Alignment>
+void dot_product_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<vector2<T>, Alignment> b,
+        aligned_view<T, Alignment> out,
+        IterationType n,
+        streaming_t) {
+    dot_product_n(
+            unaligned_view<vector2<T>>{a.get()},
+            unaligned_view<vector2<T>>{b.get()},
+            unaligned_view<T>{out.get()},
+            n,
+            streaming);
+}
+
+namespace detail {
+
+// with separate x and y arrays every lane holds a whole element, so a block
+// is one multiply and one fma with no horizontal step
+template <typename SimdVector>
+SimdVector dot_product_soa_block(
+        SimdVector ax, SimdVector ay, SimdVector bx, SimdVector by) {
+    return simd::fmadd(ay, by, ax * bx);
+}
+
+template <typename SimdVector, typename T>
+void dot_product_soa_n(
+        unaligned_soa_view<T> a,
+        unaligned_soa_view<T> b,
+        unaligned_view<T> out,
+        size_t n) {
+    const size_t lookahead = simd::prefetch_distance();
+    size_t i               = 0;
 #pragma unroll 4
+    for (; i + SimdVector::size <= n; i += SimdVector::size) {
+        prefetch_ahead<SimdVector::width_bytes>(
+                a.x.get(), b.x.get(), i, lookahead);
+        prefetch_ahead<SimdVector::width_bytes>(
+                a.y.get(), b.y.get(), i, lookahead);
+        dot_product_soa_block(
+                SimdVector::load(a.x + i),
+                SimdVector::load(a.y + i),
+                SimdVector::load(b.x + i),
+                SimdVector::load(b.y + i))
+                .store(out + i);
+    }
+    if (i < n) {
+        const auto mask = SimdVector::first_n_mask(n - i);
+        dot_product_soa_block(
+                SimdVector::load(a.x + i, mask),
+                SimdVector::load(a.y + i, mask),
+                SimdVector::load(b.x + i, mask),
+                SimdVector::load(b.y + i, mask))
+                .store(out + i, mask);
+    }
+}
+
+}  // namespace detail
+
+template <typename T, typename IterationType>
+void dot_product_n(
+        unaligned_soa_view<T> a,
+        unaligned_soa_view<T> b,
+        unaligned_view<T> out,
+        IterationType n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "SoA dot_product_n requires floating point components");
+#ifdef __AVX512F__
+    if constexpr (std::is_same_v<T, float>) {
+        detail::dot_product_soa_n<f32x16>(a, b, out, n);
+        return;
+    }
+#endif
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        detail::dot_product_soa_n<simd::bit_vector<T, 256>>(a, b, out, n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i].dot(b[i]);
+    }
+}
+
+template <
+        typename T,
+        typename IterationType,
+        size_t Alignment,
+        size_t OutAlignment>
+void dot_product_n(
+        aligned_soa_view<T, Alignment> a,
+        aligned_soa_view<T, Alignment> b,
+        aligned_view<T, OutAlignment> out,
+        IterationType n) {
+    dot_product_n(
+            unaligned_soa_view<T>(a),
+            unaligned_soa_view<T>(b),
+            unaligned_view<T>{out.get()},
+            n);
+}
+
+namespace detail {
+
+#ifdef __AVX2__
+// the byte offset of every lane's element from the first one
+template <typename IndexVector>
+IndexVector strided_lanes(size_t stride) {
+    int32_t lanes[IndexVector::size];
+    for (size_t k = 0; k < IndexVector::size; ++k) {
+        lanes[k] = static_cast<int32_t>(k * stride);
+    }
+    return IndexVector::load(unaligned_view<int32_t>{lanes});
+}
+
+// gathers the x and y components of SimdVector::size elements, whose x
+// components sit offsets * Scale bytes past a and b
+template <int Scale, typename SimdVector, typename IndexVector, typename T>
+SimdVector dot_product_gather_block(
+        T* a,
+        IndexVector a_offsets,
+        T* b,
+        IndexVector b_offsets,
+        typename SimdVector::mask_type mask) {
+    using View = unaligned_view<T>;
+    return dot_product_soa_block(
+            SimdVector::template gather<Scale>(View{a}, a_offsets, mask),
+            SimdVector::template gather<Scale>(View{a + 1}, a_offsets, mask),
+            SimdVector::template gather<Scale>(View{b}, b_offsets, mask),
+            SimdVector::template gather<Scale>(View{b + 1}, b_offsets, mask));
+}
+
+template <int Scale, typename SimdVector, typename IndexVector, typename T>
+SimdVector dot_product_gather_block(
+        T* a, IndexVector a_offsets, T* b, IndexVector b_offsets) {
+    using View = unaligned_view<T>;
+    return dot_product_soa_block(
+            SimdVector::template gather<Scale>(View{a}, a_offsets),
+            SimdVector::template gather<Scale>(View{a + 1}, a_offsets),
+            SimdVector::template gather<Scale>(View{b}, b_offsets),
+            SimdVector::template gather<Scale>(View{b + 1}, b_offsets));
+}
+
+// four vector2f as [x0, y0, x1, y1, x2, y2, x3, y3], each read with a single
+// 64-bit gather lane from offsets * Scale bytes past base
+template <int Scale>
+f32x8 gather_pairs(vector2f* base, i32x4 offsets) {
+    return f32x8(f64x4::gather<Scale>(
+            unaligned_view<double>{reinterpret_cast<double*>(base)}, offsets));
+}
+
+// the lane offsets stay fixed and every block moves the base pointers, so
+// the byte offsets never outgrow int32_t
+template <typename SimdVector, typename IndexVector, typename T>
+void dot_product_strided_n(
+        strided_view<vector2<T>> a,
+        strided_view<vector2<T>> b,
+        unaligned_view<T> out,
+        size_t n) {
+    const auto a_lanes = strided_lanes<IndexVector>(a.stride);
+    const auto b_lanes = strided_lanes<IndexVector>(b.stride);
+
+    size_t i = 0;
+    if constexpr (std::is_same_v<T, float>) {
+        // a vector2f is gathered whole as one 64-bit lane, which halves the
+        // number of elements gathered
+        const auto a_pairs = strided_lanes<i32x4>(a.stride);
+        const auto b_pairs = strided_lanes<i32x4>(b.stride);
+        for (; i + f32x8::size <= n; i += f32x8::size) {
+            dot_product_block(
+                    gather_pairs<1>(&a[i], a_pairs),
+                    gather_pairs<1>(&a[i + 4], a_pairs),
+                    gather_pairs<1>(&b[i], b_pairs),
+                    gather_pairs<1>(&b[i + 4], b_pairs))
+                    .store(out + i);
+        }
+    }
+    for (; i + SimdVector::size <= n; i += SimdVector::size) {
+        dot_product_gather_block<1, SimdVector>(
+                &a[i].x, a_lanes, &b[i].x, b_lanes)
+                .store(out + i);
+    }
+    if (i < n) {
+        const auto mask = SimdVector::first_n_mask(n - i);
+        dot_product_gather_block<1, SimdVector>(
+                &a[i].x, a_lanes, &b[i].x, b_lanes, mask)
+                .store(out + i, mask);
+    }
+}
+
+// the gathers take 32-bit offsets scaled by 8, the largest scale they
+// support. A vector2f is 8 bytes, so its offset is the index itself; a
+// vector2d is 16 bytes, so its offset is twice the index, which overflows
+// for indices of 2^30 and above
+template <typename SimdVector, typename IndexVector, typename T>
+void dot_product_indexed_n(
+        indexed_view<vector2<T>> a,
+        indexed_view<vector2<T>> b,
+        unaligned_view<T> out,
+        size_t n) {
+    constexpr int scale = 8;
+    static_assert(sizeof(vector2<T>) % scale == 0);
+
+    // the index lists are only read
+    auto a_indices = unaligned_view<int32_t>{const_cast<int32_t*>(a.indices)};
+    auto b_indices = unaligned_view<int32_t>{const_cast<int32_t*>(b.indices)};
+
+    const auto offsets = [](IndexVector indices) {
+        if constexpr (sizeof(vector2<T>) == 2 * scale) {
+            return indices + indices;
+        } else {
+            return indices;
+        }
+    };
+
+    size_t i = 0;
+    if constexpr (std::is_same_v<T, float>) {
+        for (; i + f32x8::size <= n; i += f32x8::size) {
+            dot_product_block(
+                    gather_pairs<scale>(a.data, i32x4::load(a_indices + i)),
+                    gather_pairs<scale>(
+                            a.data, i32x4::load(a_indices + i + 4)),
+                    gather_pairs<scale>(b.data, i32x4::load(b_indices + i)),
+                    gather_pairs<scale>(
+                            b.data, i32x4::load(b_indices + i + 4)))
+                    .store(out + i);
+        }
+    }
+    for (; i + SimdVector::size <= n; i += SimdVector::size) {
+        dot_product_gather_block<scale, SimdVector>(
+                &a.data->x,
+                offsets(IndexVector::load(a_indices + i)),
+                &b.data->x,
+                offsets(IndexVector::load(b_indices + i)))
+                .store(out + i);
+    }
+    if (i < n) {
+        const auto index_mask = IndexVector::first_n_mask(n - i);
+        const auto mask       = SimdVector::first_n_mask(n - i);
+        dot_product_gather_block<scale, SimdVector>(
+                &a.data->x,
+                offsets(IndexVector::load(a_indices + i, index_mask)),
+                &b.data->x,
+                offsets(IndexVector::load(b_indices + i, index_mask)),
+                mask)
+                .store(out + i, mask);
+    }
+}
+#endif
+
+}  // namespace detail
+
+// elements read in place from an array of structs
+template <typename T, typename IterationType>
+void dot_product_n(
+        strided_view<vector2<T>> a,
+        strided_view<vector2<T>> b,
+        unaligned_view<T> out,
+        IterationType n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "strided dot_product_n requires floating point components");
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float>) {
+        detail::dot_product_strided_n<f32x8, i32x8>(a, b, out, n);
+        return;
+    } else if constexpr (std::is_same_v<T, double>) {
+        detail::dot_product_strided_n<f64x4, i32x4>(a, b, out, n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i].dot(b[i]);
+    }
+}
+
+// elements selected by index lists; with avx2 the indices of vector2d must be
+// below 2^30
+template <typename T, typename IterationType>
+void dot_product_n(
+        indexed_view<vector2<T>> a,
+        indexed_view<vector2<T>> b,
+        unaligned_view<T> out,
+        IterationType n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "indexed dot_product_n requires floating point components");
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float>) {
+        detail::dot_product_indexed_n<f32x8, i32x8>(a, b, out, n);
+        return;
+    } else if constexpr (std::is_same_v<T, double>) {
+        detail::dot_product_indexed_n<f64x4, i32x4>(a, b, out, n);
+        return;
+    }
+#endif
     for (size_t i = 0; i < n; ++i) {
         out[i] = a[i].dot(b[i]);
     }
 }
 
+template <typename T, typename IterationType>
+void dot_product_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<T> out,
+        IterationType n,
+        parallel_t,
+        thread_pool& pool = default_thread_pool()) {
+    if (size_t(n) < parallel_threshold) {
+        dot_product_n(a, b, out, n);
+        return;
+    }
+    // decided for the whole output; a single chunk is too small to stream
+    const bool stream = detail::streams_output<T>(n);
+    pool.parallel_for(n, parallel_grain, [=](size_t begin, size_t end) {
+        if (stream) {
+            dot_product_n(
+                    a + begin, b + begin, out + begin, end - begin, streaming);
+        } else {
+            dot_product_n(a + begin, b + begin, out + begin, end - begin);
+        }
+    });
+}
+
+template <typename T, typename IterationType, size_t Alignment>
+void dot_product_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<vector2<T>, Alignment> b,
+        aligned_view<T, Alignment> out,
+        IterationType n,
+        parallel_t,
+        thread_pool& pool = default_thread_pool()) {
+    static_assert(parallel_grain * sizeof(T) % Alignment == 0);
+    if (size_t(n) < parallel_threshold) {
+        dot_product_n(a, b, out, n);
+        return;
+    }
+    const bool stream = detail::streams_output<T>(n);
+    pool.parallel_for(n, parallel_grain, [=](size_t begin, size_t end) {
+        using VectorView     = aligned_view<vector2<T>, Alignment>;
+        const auto a_chunk   = VectorView{a.data + begin};
+        const auto b_chunk   = VectorView{b.data + begin};
+        const auto out_chunk = aligned_view<T, Alignment>{out.data + begin};
+        if (stream) {
+            dot_product_n(a_chunk, b_chunk, out_chunk, end - begin, streaming);
+        } else {
+            dot_product_n(a_chunk, b_chunk, out_chunk, end - begin);
+        }
+    });
+}
+
+namespace detail {
+
+#ifdef __AVX2__
+// sum of a[i] * b[i] over n components; four independent accumulators keep
+// enough fmas in flight to hide their latency
+template <typename T>
+T dot_product_sum_avx(unaligned_view<T> a, unaligned_view<T> b, size_t n) {
+    using SimdVector      = simd::bit_vector<T, 256>;
+    constexpr size_t step = SimdVector::size;
+
+    auto acc0 = SimdVector::broadcast(0);
+    auto acc1 = acc0;
+    auto acc2 = acc0;
+    auto acc3 = acc0;
+
+    // dot_product_sum passes components, two per element
+    const size_t lookahead = simd::prefetch_distance() * 2;
+    size_t i               = 0;
+    for (; i + 4 * step <= n; i += 4 * step) {
+        prefetch_ahead<SimdVector::width_bytes * 4>(
+                a.get(), b.get(), i, lookahead);
+        acc0 = simd::fmadd(
+                SimdVector::load(a + i), SimdVector::load(b + i), acc0);
+        acc1 = simd::fmadd(
+                SimdVector::load(a + i + step),
+                SimdVector::load(b + i + step),
+                acc1);
+        acc2 = simd::fmadd(
+                SimdVector::load(a + i + 2 * step),
+                SimdVector::load(b + i + 2 * step),
+                acc2);
+        acc3 = simd::fmadd(
+                SimdVector::load(a + i + 3 * step),
+                SimdVector::load(b + i + 3 * step),
+                acc3);
+    }
+    for (; i + step <= n; i += step) {
+        acc0 = simd::fmadd(
+                SimdVector::load(a + i), SimdVector::load(b + i), acc0);
+    }
+    if (i < n) {
+        const auto mask = SimdVector::first_n_mask(n - i);
+        acc1            = simd::fmadd(
+                SimdVector::load(a + i, mask),
+                SimdVector::load(b + i, mask),
+                acc1);
+    }
+    return simd::reduce_add((acc0 + acc1) + (acc2 + acc3));
+}
+
+// adds value to sum, carrying the rounding error in c
+template <typename SimdVector>
+void kahan_add(SimdVector& sum, SimdVector& c, SimdVector value) {
+    auto y = value - c;
+    auto t = sum + y;
+    c      = (t - sum) - y;
+    sum    = t;
+}
+
+// lane-wise Kahan summation of the products; every step is a chain of four
+// dependent adds, so four independent sum and compensation pairs are kept
+template <typename T>
+T dot_product_sum_kahan_avx(
+        unaligned_view<T> a, unaligned_view<T> b, size_t n) {
+    using SimdVector      = simd::bit_vector<T, 256>;
+    constexpr size_t step = SimdVector::size;
+
+    auto sum0 = SimdVector::broadcast(0);
+    auto sum1 = sum0;
+    auto sum2 = sum0;
+    auto sum3 = sum0;
+    auto c0   = sum0;
+    auto c1   = sum0;
+    auto c2   = sum0;
+    auto c3   = sum0;
+
+    auto product = [&](size_t i) {
+        return SimdVector::load(a + i) * SimdVector::load(b + i);
+    };
+
+    size_t i = 0;
+    for (; i + 4 * step <= n; i += 4 * step) {
+        kahan_add(sum0, c0, product(i));
+        kahan_add(sum1, c1, product(i + step));
+        kahan_add(sum2, c2, product(i + 2 * step));
+        kahan_add(sum3, c3, product(i + 3 * step));
+    }
+    for (; i + step <= n; i += step) {
+        kahan_add(sum0, c0, product(i));
+    }
+    if (i < n) {
+        const auto mask = SimdVector::first_n_mask(n - i);
+        kahan_add(
+                sum1,
+                c1,
+                SimdVector::load(a + i, mask) * SimdVector::load(b + i, mask));
+    }
+
+    // the chains are folded into the first one, carrying their compensation
+    // along, and its lanes are combined with a scalar Kahan pass
+    c0 = (c0 + c1) + (c2 + c3);
+    kahan_add(sum0, c0, sum1);
+    kahan_add(sum0, c0, sum2);
+    kahan_add(sum0, c0, sum3);
+
+    T sums[step];
+    T compensation[step];
+    sum0.store(unaligned_view<T>{sums});
+    c0.store(unaligned_view<T>{compensation});
+
+    T total = 0;
+    T c     = 0;
+    for (size_t lane = 0; lane < step; ++lane) {
+        c += compensation[lane];
+    }
+    for (size_t lane = 0; lane < step; ++lane) {
+        T y   = sums[lane] - c;
+        T t   = total + y;
+        c     = (t - total) - y;
+        total = t;
+    }
+    return total;
+}
+#endif
+
+template <typename T>
+T dot_product_sum_plain(unaligned_view<T> a, unaligned_view<T> b, size_t n) {
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        return dot_product_sum_avx(a, b, n);
+    }
+#endif
+    T sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template <typename T>
+T dot_product_sum_kahan(unaligned_view<T> a, unaligned_view<T> b, size_t n) {
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        return dot_product_sum_kahan_avx(a, b, n);
+    }
+#endif
+    T sum = 0;
+    T c   = 0;
+    for (size_t i = 0; i < n; ++i) {
+        T y = a[i] * b[i] - c;
+        T t = sum + y;
+        c   = (t - sum) - y;
+        sum = t;
+    }
+    return sum;
+}
+
+// blocks are small enough for plain accumulation to stay accurate and large
+// enough to amortize the recursion
+inline constexpr size_t pairwise_block_components = 1024;
+
+template <typename T>
+T dot_product_sum_pairwise(
+        unaligned_view<T> a, unaligned_view<T> b, size_t n) {
+    if (n <= pairwise_block_components) {
+        return dot_product_sum_plain(a, b, n);
+    }
+    // split on a multiple of the block so only the last block is partial
+    const size_t half = (n / 2 + pairwise_block_components - 1)
+                        / pairwise_block_components
+                        * pairwise_block_components;
+    return dot_product_sum_pairwise(a, b, half)
+           + dot_product_sum_pairwise(a + half, b + half, n - half);
+}
+
+}  // namespace detail
+
+// sum of the n dot products a[i].dot(b[i]); the individual results are never
+// written to memory
+template <typename T, typename IterationType>
+T dot_product_sum(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        IterationType n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "dot_product_sum requires floating point components");
+    return detail::dot_product_sum_plain(
+            a.template as<T>(), b.template as<T>(), size_t(n) * 2);
+}
+
+template <typename T, typename IterationType>
+T dot_product_sum(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        IterationType n,
+        kahan_t) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "dot_product_sum requires floating point components");
+    return detail::dot_product_sum_kahan(
+            a.template as<T>(), b.template as<T>(), size_t(n) * 2);
+}
+
+template <typename T, typename IterationType>
+T dot_product_sum(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        IterationType n,
+        pairwise_t) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "dot_product_sum requires floating point components");
+    return detail::dot_product_sum_pairwise(
+            a.template as<T>(), b.template as<T>(), size_t(n) * 2);
+}
+
+// unaligned loads cost the same as aligned ones on aligned data, so the
+// aligned overloads forward
+template <
+        typename T,
+        typename IterationType,
+        size_t Alignment,
+        typename... Summation>
+T dot_product_sum(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<vector2<T>, Alignment> b,
+        IterationType n,
+        Summation... summation) {
+    return dot_product_sum(
+            unaligned_view<vector2<T>>{a.get()},
+            unaligned_view<vector2<T>>{b.get()},
+            n,
+            summation...);
+}
+
+namespace detail {
+
+// exact unless every component is INT32_MIN, in which case the sum wraps
+inline int64_t dot_product_wide(vector2i a, vector2i b) {
+    return static_cast<int64_t>(
+            static_cast<uint64_t>(int64_t{a.x} * b.x)
+            + static_cast<uint64_t>(int64_t{a.y} * b.y));
+}
+
+template <typename T>
+T dot_product_wrapping(vector2<T> a, vector2<T> b) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(U(a.x) * U(b.x) + U(a.y) * U(b.y));
+}
+
+inline int32_t dot_product_saturating(vector2i a, vector2i b) {
+    return static_cast<int32_t>(std::clamp<int64_t>(
+            dot_product_wide(a, b), INT32_MIN, INT32_MAX));
+}
+
+#ifdef __AVX2__
+// 64-bit dot products of the 4 vector2i pairs in a and b
+inline i64x4 dot_product_block_wide(i32x8 a, i32x8 b) {
+    // [a0x*b0x, a1x*b1x, a2x*b2x, a3x*b3x]
+    auto prod_x = mul_wide(a, b);
+
+    // [a0y*b0y, a1y*b1y, a2y*b2y, a3y*b3y]
+    auto prod_y = mul_wide(
+            shuffle(a, control4<1, 0, 3, 2>()),
+            shuffle(b, control4<1, 0, 3, 2>()));
+
+    return prod_x + prod_y;
+}
+#endif
+
+inline void dot_product_wide_n(
+        unaligned_view<vector2i> a,
+        unaligned_view<vector2i> b,
+        unaligned_view<int64_t> out,
+        size_t n) {
+    size_t i = 0;
+#ifdef __AVX2__
+    auto ai = a.as<int32_t>();
+    auto bi = b.as<int32_t>();
+#pragma unroll 4
+    for (; i + i64x4::size <= n; i += i64x4::size) {
+        dot_product_block_wide(i32x8::load(ai + i * 2), i32x8::load(bi + i * 2))
+                .store(out + i);
+    }
+    if (i < n) {
+        const auto mask = i32x8::first_n_mask((n - i) * 2);
+        dot_product_block_wide(
+                i32x8::load(ai + i * 2, mask), i32x8::load(bi + i * 2, mask))
+                .store(out + i, i64x4::first_n_mask(n - i));
+        return;
+    }
+#endif
+#pragma unroll 4
+    for (; i < n; ++i) {
+        out[i] = dot_product_wide(a[i], b[i]);
+    }
+}
+
+template <typename T>
+void dot_product_wrapping_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<T> out,
+        size_t n) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, int32_t>) {
+        auto ai = a.template as<int32_t>();
+        auto bi = b.template as<int32_t>();
+#pragma unroll 4
+        for (; i + i32x8::size <= n; i += i32x8::size) {
+            dot_product_block(
+                    i32x8::load(ai + i * 2),
+                    i32x8::load(ai + i * 2 + i32x8::size),
+                    i32x8::load(bi + i * 2),
+                    i32x8::load(bi + i * 2 + i32x8::size))
+                    .store(out + i);
+        }
+        if (i < n) {
+            dot_product_masked_block<i32x8>(
+                    ai + i * 2, bi + i * 2, out + i, n - i);
+            return;
+        }
+    }
+#endif
+#pragma unroll 4
+    for (; i < n; ++i) {
+        out[i] = dot_product_wrapping(a[i], b[i]);
+    }
+}
+
+inline void dot_product_saturating_n(
+        unaligned_view<vector2i> a,
+        unaligned_view<vector2i> b,
+        unaligned_view<int32_t> out,
+        size_t n) {
+    size_t i = 0;
+#ifdef __AVX2__
+    auto ai = a.as<int32_t>();
+    auto bi = b.as<int32_t>();
+#pragma unroll 4
+    for (; i + i32x8::size <= n; i += i32x8::size) {
+        pack_saturate(
+                dot_product_block_wide(
+                        i32x8::load(ai + i * 2), i32x8::load(bi + i * 2)),
+                dot_product_block_wide(
+                        i32x8::load(ai + i * 2 + i32x8::size),
+                        i32x8::load(bi + i * 2 + i32x8::size)))
+                .store(out + i);
+    }
+    if (i < n) {
+        const size_t components = (n - i) * 2;
+        const auto mask_lo      = i32x8::first_n_mask(components);
+        const auto mask_hi      = i32x8::first_n_mask(
+                components > i32x8::size ? components - i32x8::size : 0);
+        pack_saturate(
+                dot_product_block_wide(
+                        i32x8::load(ai + i * 2, mask_lo),
+                        i32x8::load(bi + i * 2, mask_lo)),
+                dot_product_block_wide(
+                        i32x8::load(ai + i * 2 + i32x8::size, mask_hi),
+                        i32x8::load(bi + i * 2 + i32x8::size, mask_hi)))
+                .store(out + i, i32x8::first_n_mask(n - i));
+        return;
+    }
+#endif
+#pragma unroll 4
+    for (; i < n; ++i) {
+        out[i] = dot_product_saturating(a[i], b[i]);
+    }
+}
+
+}  // namespace detail
+
+template <typename IterationCountType, size_t Alignment>
+void dot_product_n(
+        aligned_view<vector2i, Alignment> a,
+        aligned_view<vector2i, Alignment> b,
+        aligned_view<int64_t, Alignment> out,
+        IterationCountType n) {
+    detail::dot_product_wide_n(
+            unaligned_view<vector2i>{a.get()},
+            unaligned_view<vector2i>{b.get()},
+            unaligned_view<int64_t>{out.get()},
+            n);
+}
+
+template <typename IterationType>
+inline void dot_product_n(
+        unaligned_view<vector2i> a,
+        unaligned_view<vector2i> b,
+        unaligned_view<int64_t> out,
+        IterationType n) {
+    detail::dot_product_wide_n(a, b, out, n);
+}
+
+template <typename ComponentType, typename IterationCountType, size_t Alignment>
+void dot_product_n(
+        aligned_view<vector2<ComponentType>, Alignment> a,
+        aligned_view<vector2<ComponentType>, Alignment> b,
+        aligned_view<ComponentType, Alignment> out,
+        IterationCountType n,
+        wrapping_t) {
+    static_assert(std::is_integral_v<ComponentType>);
+    detail::dot_product_wrapping_n(
+            unaligned_view<vector2<ComponentType>>{a.get()},
+            unaligned_view<vector2<ComponentType>>{b.get()},
+            unaligned_view<ComponentType>{out.get()},
+            n);
+}
+
+template <typename T, typename IterationType>
+inline void dot_product_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<T> out,
+        IterationType n,
+        wrapping_t) {
+    static_assert(std::is_integral_v<T>);
+    detail::dot_product_wrapping_n(a, b, out, n);
+}
+
+template <typename IterationCountType, size_t Alignment>
+void dot_product_n(
+        aligned_view<vector2i, Alignment> a,
+        aligned_view<vector2i, Alignment> b,
+        aligned_view<int32_t, Alignment> out,
+        IterationCountType n,
+        saturating_t) {
+    detail::dot_product_saturating_n(
+            unaligned_view<vector2i>{a.get()},
+            unaligned_view<vector2i>{b.get()},
+            unaligned_view<int32_t>{out.get()},
+            n);
+}
+
+template <typename IterationType>
+inline void dot_product_n(
+        unaligned_view<vector2i> a,
+        unaligned_view<vector2i> b,
+        unaligned_view<int32_t> out,
+        IterationType n,
+        saturating_t) {
+    detail::dot_product_saturating_n(a, b, out, n);
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
 }  // namespace simd::math
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/view.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace simd::math {
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+namespace detail {
+
+// the widest register filter_n compresses T in
+template <typename T>
+constexpr size_t filter_bits() {
+#ifdef __AVX512F__
+    if constexpr (sizeof(T) == 4) {
+        return 512;
+    }
+#endif
+    return 256;
+}
+
+}  // namespace detail
+
+// copies the elements of in[0, n) that satisfy pred to the front of out,
+// keeping their order, and returns how many were copied. out needs room for
+// n elements and may be in itself. pred is called with a T and, in AVX2
+// builds, with a bit_vector of T, for which it returns the vector's mask_type
+template <typename T, typename Predicate>
+size_t filter_n(
+        unaligned_view<T> in, unaligned_view<T> out, size_t n, Predicate pred) {
+    size_t count = 0;
+    size_t i     = 0;
+#ifdef __AVX2__
+    if constexpr (
+            std::is_same_v<T, float> || std::is_same_v<T, double>
+            || std::is_same_v<T, int32_t>) {
+        using SimdVector = simd::bit_vector<T, detail::filter_bits<T>()>;
+        for (; i + SimdVector::size <= n; i += SimdVector::size) {
+            const auto v    = SimdVector::load(in + i);
+            const auto keep = pred(v);
+            // count <= i, so the full width store stays inside out[0, n)
+            // and only overwrites input that has already been loaded
+            simd::compress(keep, v).store(out + count);
+            count += simd::popcount(keep);
+        }
+        if (i < n) {
+            const auto tail = SimdVector::first_n_mask(n - i);
+            const auto v    = SimdVector::load(in + i, tail);
+            count += simd::compress_store(pred(v) & tail, v, out + count);
+            i = n;
+        }
+    }
+#endif
+    // branchless, since a predicate on data is rarely predictable
+    for (; i < n; ++i) {
+        const T value = in[i];
+        out[count]    = value;
+        count += pred(value) ? 1 : 0;
+    }
+    return count;
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <simd/isa.h>
+#include <simd/math/vector2.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace simd::math {
+
+#pragma pack(push, 0)
+// stored by columns: x_axis and y_axis are the images of the unit x and y
+// vectors, so m * v = x_axis * v.x + y_axis * v.y
+template <typename T>
+struct matrix2 {
+    vector2<T> x_axis;
+    vector2<T> y_axis;
+
+    SIMD_ISA_TAGGED
+    static constexpr matrix2<T> identity() {
+        return {.x_axis = {T(1), T(0)}, .y_axis = {T(0), T(1)}};
+    }
+
+    SIMD_ISA_TAGGED
+    static constexpr matrix2<T> scale(T sx, T sy) {
+        return {.x_axis = {sx, T(0)}, .y_axis = {T(0), sy}};
+    }
+
+    // counterclockwise by angle radians
+    SIMD_ISA_TAGGED
+    static matrix2<T> rotation(T angle) {
+        const T c = std::cos(angle);
+        const T s = std::sin(angle);
+        return {.x_axis = {c, s}, .y_axis = {-s, c}};
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr vector2<T> operator*(const vector2<T> v) const {
+        return x_axis * v.x + y_axis * v.y;
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr matrix2<T> operator*(const matrix2<T>& rhs) const {
+        return {.x_axis = *this * rhs.x_axis, .y_axis = *this * rhs.y_axis};
+    }
+};
+
+// p -> linear * p + translation
+template <typename T>
+struct affine2 {
+    matrix2<T> linear;
+    vector2<T> translation;
+
+    SIMD_ISA_TAGGED
+    static constexpr affine2<T> identity() {
+        return {.linear = matrix2<T>::identity(), .translation = {}};
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr vector2<T> operator*(const vector2<T> p) const {
+        return linear * p + translation;
+    }
+
+    // applies rhs first
+    SIMD_ISA_TAGGED
+    constexpr affine2<T> operator*(const affine2<T>& rhs) const {
+        return {.linear      = linear * rhs.linear,
+                .translation = *this * rhs.translation};
+    }
+};
+#pragma pack(pop)
+
+using matrix2f = matrix2<float>;
+using matrix2d = matrix2<double>;
+using affine2f = affine2<float>;
+using affine2d = affine2<double>;
+
+}  // namespace simd::math
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/math/matrix2.h>
+#include <simd/math/vector2.h>
+#include <simd/math/vector2_batch.h>
+#include <simd/math/vector2_soa.h>
+#include <simd/view.h>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace simd::math {
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+namespace detail {
+
+#ifdef __AVX2__
+// the transform spread over the lanes of packed vector2, such that
+// transform * v = v * diagonal + swap_pairs(v) * cross + translation
+template <typename SimdVector>
+struct affine2_lanes {
+    SimdVector diagonal;
+    SimdVector cross;
+    SimdVector translation;
+
+    template <typename T>
+    explicit affine2_lanes(const affine2<T>& transform)
+        : diagonal(alternating<SimdVector>(
+                  transform.linear.x_axis.x, transform.linear.y_axis.y)),
+          cross(alternating<SimdVector>(
+                  transform.linear.y_axis.x, transform.linear.x_axis.y)),
+          translation(alternating<SimdVector>(
+                  transform.translation.x, transform.translation.y)) {}
+
+    SimdVector operator()(SimdVector v) const {
+        return simd::fmadd(
+                v,
+                diagonal,
+                simd::fmadd(simd::swap_pairs(v), cross, translation));
+    }
+};
+
+// x_axis * x + y_axis * y + translation for the packed vector2 in v, with
+// every operand already spread over the lanes of its vector2
+template <typename SimdVector>
+SimdVector affine2_block(
+        SimdVector v,
+        SimdVector x_axis,
+        SimdVector y_axis,
+        SimdVector translation) {
+    return simd::fmadd(
+            simd::duplicate_even(v),
+            x_axis,
+            simd::fmadd(simd::duplicate_odd(v), y_axis, translation));
+}
+
+// the x_axis, y_axis and translation of transforms[i], ..., transforms[i + 3]
+// as [v0, v1, v2, v3] each. Every vector2f moves as one 64-bit lane
+inline std::tuple<f32x8, f32x8, f32x8>
+load_affine2_lanes(unaligned_view<affine2f> transforms, size_t i) {
+    const unaligned_view<double> pairs{
+            reinterpret_cast<double*>(&transforms[i])};
+    const auto [x_axis, y_axis, translation] = simd::deinterleave3(
+            f64x4::load(pairs), f64x4::load(pairs + 4), f64x4::load(pairs + 8));
+    return {f32x8(x_axis), f32x8(y_axis), f32x8(translation)};
+}
+
+inline void transform_each_n(
+        unaligned_view<affine2f> transforms,
+        unaligned_view<vector2f> in,
+        unaligned_view<vector2f> out,
+        size_t& i,
+        size_t n) {
+    auto components = in.as<float>();
+    auto result     = out.as<float>();
+    for (; i + 4 <= n; i += 4) {
+        const auto [x_axis, y_axis, translation]
+                = load_affine2_lanes(transforms, i);
+        affine2_block(
+                f32x8::load(components + i * 2), x_axis, y_axis, translation)
+                .store(result + i * 2);
+    }
+}
+
+// eight transforms split into one register per coefficient
+inline void transform_each_soa_n(
+        unaligned_view<affine2f> transforms,
+        unaligned_soa_view<float> in,
+        unaligned_soa_view<float> out,
+        size_t& i,
+        size_t n) {
+    for (; i + 8 <= n; i += 8) {
+        const auto [x_lo, y_lo, t_lo] = load_affine2_lanes(transforms, i);
+        const auto [x_hi, y_hi, t_hi] = load_affine2_lanes(transforms, i + 4);
+        const auto [a, b]             = simd::deinterleave(x_lo, x_hi);
+        const auto [c, d]             = simd::deinterleave(y_lo, y_hi);
+        const auto [tx, ty]           = simd::deinterleave(t_lo, t_hi);
+        const auto x                  = f32x8::load(in.x + i);
+        const auto y                  = f32x8::load(in.y + i);
+        simd::fmadd(x, a, simd::fmadd(y, c, tx)).store(out.x + i);
+        simd::fmadd(x, b, simd::fmadd(y, d, ty)).store(out.y + i);
+    }
+}
+
+template <typename SimdVector, typename T>
+void transform_soa_n(
+        const affine2<T>& transform,
+        unaligned_soa_view<T> in,
+        unaligned_soa_view<T> out,
+        size_t n) {
+    const auto a     = SimdVector::broadcast(transform.linear.x_axis.x);
+    const auto b     = SimdVector::broadcast(transform.linear.x_axis.y);
+    const auto c     = SimdVector::broadcast(transform.linear.y_axis.x);
+    const auto d     = SimdVector::broadcast(transform.linear.y_axis.y);
+    const auto tx    = SimdVector::broadcast(transform.translation.x);
+    const auto ty    = SimdVector::broadcast(transform.translation.y);
+    const auto block = [&](SimdVector x, SimdVector y) {
+        return std::pair{
+                simd::fmadd(x, a, simd::fmadd(y, c, tx)),
+                simd::fmadd(x, b, simd::fmadd(y, d, ty))};
+    };
+
+    size_t i = 0;
+#pragma unroll 4
+    for (; i + SimdVector::size <= n; i += SimdVector::size) {
+        const auto [x, y] = block(
+                SimdVector::load(in.x + i), SimdVector::load(in.y + i));
+        x.store(out.x + i);
+        y.store(out.y + i);
+    }
+    if (i < n) {
+        const auto mask   = SimdVector::first_n_mask(n - i);
+        const auto [x, y] = block(
+                SimdVector::load(in.x + i, mask),
+                SimdVector::load(in.y + i, mask));
+        x.store(out.x + i, mask);
+        y.store(out.y + i, mask);
+    }
+}
+
+#endif
+
+}  // namespace detail
+
+// out[i] = transform * in[i]; like the vector2 batch kernels, every element
+// is read before its output is written, so out may be in
+
+template <typename T>
+void transform_n(
+        const affine2<T>& transform,
+        unaligned_view<vector2<T>> in,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        using SimdVector = detail::vector2_register<T>;
+        detail::transform_components<SimdVector>(
+                out.template as<T>(),
+                n * 2,
+                detail::affine2_lanes<SimdVector>{transform},
+                in.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = transform * in[i];
+    }
+}
+
+template <typename T>
+void transform_n(
+        const matrix2<T>& transform,
+        unaligned_view<vector2<T>> in,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+    transform_n(affine2<T>{transform, {}}, in, out, n);
+}
+
+// out[i] = transforms[i] * in[i]
+template <typename T>
+void transform_n(
+        unaligned_view<affine2<T>> transforms,
+        unaligned_view<vector2<T>> in,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float>) {
+        detail::transform_each_n(transforms, in, out, i, n);
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = transforms[i] * in[i];
+    }
+}
+
+template <typename T>
+void transform_n(
+        const affine2<T>& transform,
+        unaligned_soa_view<T> in,
+        unaligned_soa_view<T> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        detail::transform_soa_n<detail::vector2_register<T>>(
+                transform, in, out, n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        const vector2<T> p = transform * in[i];
+        out.x[i]           = p.x;
+        out.y[i]           = p.y;
+    }
+}
+
+template <typename T>
+void transform_n(
+        const matrix2<T>& transform,
+        unaligned_soa_view<T> in,
+        unaligned_soa_view<T> out,
+        size_t n) {
+    transform_n(affine2<T>{transform, {}}, in, out, n);
+}
+
+template <typename T>
+void transform_n(
+        unaligned_view<affine2<T>> transforms,
+        unaligned_soa_view<T> in,
+        unaligned_soa_view<T> out,
+        size_t n) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float>) {
+        detail::transform_each_soa_n(transforms, in, out, i, n);
+    }
+#endif
+    for (; i < n; ++i) {
+        const vector2<T> p = transforms[i] * in[i];
+        out.x[i]           = p.x;
+        out.y[i]           = p.y;
+    }
+}
+
+// the aligned overloads forward, see dot_product.h
+
+// Transform is a matrix2 or an affine2. An affine2f takes 24 bytes, so
+// arrays of them are only viewed unaligned
+
+template <typename Transform, typename T, size_t Alignment>
+void transform_n(
+        const Transform& transform,
+        aligned_view<vector2<T>, Alignment> in,
+        aligned_view<vector2<T>, Alignment> out,
+        size_t n) {
+    transform_n(
+            transform,
+            unaligned_view<vector2<T>>{in.get()},
+            unaligned_view<vector2<T>>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment>
+void transform_n(
+        unaligned_view<affine2<T>> transforms,
+        aligned_view<vector2<T>, Alignment> in,
+        aligned_view<vector2<T>, Alignment> out,
+        size_t n) {
+    transform_n(
+            transforms,
+            unaligned_view<vector2<T>>{in.get()},
+            unaligned_view<vector2<T>>{out.get()},
+            n);
+}
+
+template <typename Transform, typename T, size_t Alignment>
+void transform_n(
+        const Transform& transform,
+        aligned_soa_view<T, Alignment> in,
+        aligned_soa_view<T, Alignment> out,
+        size_t n) {
+    transform_n(
+            transform,
+            unaligned_soa_view<T>(in),
+            unaligned_soa_view<T>(out),
+            n);
+}
+
+template <typename T, size_t Alignment>
+void transform_n(
+        unaligned_view<affine2<T>> transforms,
+        aligned_soa_view<T, Alignment> in,
+        aligned_soa_view<T, Alignment> out,
+        size_t n) {
+    transform_n(
+            transforms,
+            unaligned_soa_view<T>(in),
+            unaligned_soa_view<T>(out),
+            n);
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <simd/isa.h>
+#include <simd/math/vector4.h>
+
+#include <cstdint>
+
+namespace simd::math {
+
+#pragma pack(push, 0)
+// stored by columns like matrix2, so m * v = x_axis * v.x + y_axis * v.y +
+// z_axis * v.z + w_axis * v.w
+template <typename T>
+struct matrix4 {
+    vector4<T> x_axis;
+    vector4<T> y_axis;
+    vector4<T> z_axis;
+    vector4<T> w_axis;
+
+    SIMD_ISA_TAGGED
+    static constexpr matrix4<T> identity() {
+        return scale(T(1), T(1), T(1));
+    }
+
+    SIMD_ISA_TAGGED
+    static constexpr matrix4<T> scale(T sx, T sy, T sz) {
+        return {.x_axis = {sx, T(0), T(0), T(0)},
+                .y_axis = {T(0), sy, T(0), T(0)},
+                .z_axis = {T(0), T(0), sz, T(0)},
+                .w_axis = {T(0), T(0), T(0), T(1)}};
+    }
+
+    // moves points, i.e. vectors with w = 1, by (tx, ty, tz)
+    SIMD_ISA_TAGGED
+    static constexpr matrix4<T> translation(T tx, T ty, T tz) {
+        matrix4<T> m = identity();
+        m.w_axis     = {tx, ty, tz, T(1)};
+        return m;
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr vector4<T> operator*(const vector4<T> v) const {
+        return x_axis * v.x + y_axis * v.y + z_axis * v.z + w_axis * v.w;
+    }
+
+    // applies rhs first
+    SIMD_ISA_TAGGED
+    constexpr matrix4<T> operator*(const matrix4<T>& rhs) const {
+        return {.x_axis = *this * rhs.x_axis,
+                .y_axis = *this * rhs.y_axis,
+                .z_axis = *this * rhs.z_axis,
+                .w_axis = *this * rhs.w_axis};
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr matrix4<T> transposed() const {
+        return {.x_axis = {x_axis.x, y_axis.x, z_axis.x, w_axis.x},
+                .y_axis = {x_axis.y, y_axis.y, z_axis.y, w_axis.y},
+                .z_axis = {x_axis.z, y_axis.z, z_axis.z, w_axis.z},
+                .w_axis = {x_axis.w, y_axis.w, z_axis.w, w_axis.w}};
+    }
+};
+#pragma pack(pop)
+
+using matrix4f = matrix4<float>;
+using matrix4d = matrix4<double>;
+
+}  // namespace simd::math
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/math/matrix4.h>
+#include <simd/math/vector2_batch.h>
+#include <simd/math/vector4.h>
+#include <simd/view.h>
+
+#include <type_traits>
+
+namespace simd::math {
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+namespace detail {
+
+#ifdef __AVX2__
+// one register per column of a matrix4<T>
+template <typename T>
+using column_register = bit_vector<T, sizeof(T) * 4 * 8>;
+
+// the columns of the matrix4 at columns held in registers; applied to the
+// vector4 at v it broadcasts each component from memory
+template <typename Column>
+struct matrix4_columns {
+    Column x_axis;
+    Column y_axis;
+    Column z_axis;
+    Column w_axis;
+
+    template <typename T>
+    explicit matrix4_columns(unaligned_view<T> columns)
+        : x_axis(Column::load(columns)),
+          y_axis(Column::load(columns + 4)),
+          z_axis(Column::load(columns + 8)),
+          w_axis(Column::load(columns + 12)) {}
+
+    template <typename T>
+    Column operator()(unaligned_view<T> v) const {
+        const auto x = Column::broadcast(v[0]);
+        const auto y = Column::broadcast(v[1]);
+        const auto z = Column::broadcast(v[2]);
+        const auto w = Column::broadcast(v[3]);
+        return simd::fmadd(
+                x_axis,
+                x,
+                simd::fmadd(y_axis, y, simd::fmadd(z_axis, z, w_axis * w)));
+    }
+
+    // the matrix4 at b multiplied from the left, read whole before out is
+    // written
+    template <typename T>
+    void multiply(unaligned_view<T> b, unaligned_view<T> out) const {
+        const Column x = (*this)(b);
+        const Column y = (*this)(b + 4);
+        const Column z = (*this)(b + 8);
+        const Column w = (*this)(b + 12);
+        x.store(out);
+        y.store(out + 4);
+        z.store(out + 8);
+        w.store(out + 12);
+    }
+};
+
+// the columns of a matrix4f repeated in every 128-bit lane, so that one
+// register holds the product with several vector4f or columns of another
+// matrix4f
+template <typename SimdVector>
+struct matrix4f_lanes {
+    SimdVector x_axis;
+    SimdVector y_axis;
+    SimdVector z_axis;
+    SimdVector w_axis;
+
+    explicit matrix4f_lanes(unaligned_view<float> columns)
+        : x_axis(SimdVector::broadcast_lanes(columns)),
+          y_axis(SimdVector::broadcast_lanes(columns + 4)),
+          z_axis(SimdVector::broadcast_lanes(columns + 8)),
+          w_axis(SimdVector::broadcast_lanes(columns + 12)) {}
+
+    SimdVector operator()(SimdVector v) const {
+        const auto x = simd::shuffle(v, control4<0, 0, 0, 0>());
+        const auto y = simd::shuffle(v, control4<1, 1, 1, 1>());
+        const auto z = simd::shuffle(v, control4<2, 2, 2, 2>());
+        const auto w = simd::shuffle(v, control4<3, 3, 3, 3>());
+        return simd::fmadd(
+                x_axis,
+                x,
+                simd::fmadd(y_axis, y, simd::fmadd(z_axis, z, w_axis * w)));
+    }
+
+    // each register of out only depends on the same register of b
+    void multiply(unaligned_view<float> b, unaligned_view<float> out) const {
+        for (size_t i = 0; i < 16; i += SimdVector::size) {
+            (*this)(SimdVector::load(b + i)).store(out + i);
+        }
+    }
+};
+
+// how a matrix4<T> multiplies whole matrix4 and arrays of vector4
+template <typename T>
+using matrix4_lanes = std::conditional_t<
+        std::is_same_v<T, float>,
+        matrix4f_lanes<vector2_register<float>>,
+        matrix4_columns<column_register<T>>>;
+
+template <typename SimdVector>
+void transform_vectors(
+        const matrix4f_lanes<SimdVector>& m,
+        unaligned_view<float> in,
+        unaligned_view<float> out,
+        size_t n) {
+    const size_t components = n * 4;
+    size_t i                = 0;
+#pragma unroll 4
+    for (; i + SimdVector::size <= components; i += SimdVector::size) {
+        m(SimdVector::load(in + i)).store(out + i);
+    }
+    if (i < components) {
+        const auto mask = SimdVector::first_n_mask(components - i);
+        m(SimdVector::load(in + i, mask)).store(out + i, mask);
+    }
+}
+
+template <typename Column, typename T>
+void transform_vectors(
+        const matrix4_columns<Column>& m,
+        unaligned_view<T> in,
+        unaligned_view<T> out,
+        size_t n) {
+#pragma unroll 4
+    for (size_t i = 0; i < n * 4; i += 4) {
+        m(in + i).store(out + i);
+    }
+}
+
+// only ever read through
+template <typename T>
+unaligned_view<T> components(const matrix4<T>& m) {
+    return unaligned_view<T>{const_cast<T*>(&m.x_axis.x)};
+}
+
+inline void transpose(unaligned_view<float> in, unaligned_view<float> out) {
+#ifdef __AVX512F__
+    simd::transpose4x4(f32x16::load(in)).store(out);
+#else
+    const auto [lo, hi]
+            = simd::transpose4x4(f32x8::load(in), f32x8::load(in + 8));
+    lo.store(out);
+    hi.store(out + 8);
+#endif
+}
+
+inline void transpose(unaligned_view<double> in, unaligned_view<double> out) {
+    const auto [x, y, z, w] = simd::transpose4x4(
+            f64x4::load(in),
+            f64x4::load(in + 4),
+            f64x4::load(in + 8),
+            f64x4::load(in + 12));
+    x.store(out);
+    y.store(out + 4);
+    z.store(out + 8);
+    w.store(out + 12);
+}
+#endif
+
+}  // namespace detail
+
+// out may be one of the inputs, see vector2_batch.h
+
+// out[i] = a[i] * b[i]
+template <typename T>
+void multiply_n(
+        unaligned_view<matrix4<T>> a,
+        unaligned_view<matrix4<T>> b,
+        unaligned_view<matrix4<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        const auto lhs    = a.template as<T>();
+        const auto rhs    = b.template as<T>();
+        const auto result = out.template as<T>();
+        for (size_t i = 0; i < n * 16; i += 16) {
+            detail::matrix4_lanes<T>{lhs + i}.multiply(rhs + i, result + i);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i] * b[i];
+    }
+}
+
+// out[i] = a * b[i]
+template <typename T>
+void multiply_n(
+        const matrix4<T>& a,
+        unaligned_view<matrix4<T>> b,
+        unaligned_view<matrix4<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        const detail::matrix4_lanes<T> lhs{detail::components(a)};
+        const auto rhs    = b.template as<T>();
+        const auto result = out.template as<T>();
+        for (size_t i = 0; i < n * 16; i += 16) {
+            lhs.multiply(rhs + i, result + i);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a * b[i];
+    }
+}
+
+// out[i] = m * in[i]
+template <typename T>
+void transform_n(
+        const matrix4<T>& m,
+        unaligned_view<vector4<T>> in,
+        unaligned_view<vector4<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        detail::transform_vectors(
+                detail::matrix4_lanes<T>{detail::components(m)},
+                in.template as<T>(),
+                out.template as<T>(),
+                n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = m * in[i];
+    }
+}
+
+// out[i] = m[i] * in[i]
+template <typename T>
+void transform_n(
+        unaligned_view<matrix4<T>> m,
+        unaligned_view<vector4<T>> in,
+        unaligned_view<vector4<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        using Column       = detail::column_register<T>;
+        const auto columns = m.template as<T>();
+        const auto from    = in.template as<T>();
+        const auto to      = out.template as<T>();
+        for (size_t i = 0; i < n; ++i) {
+            detail::matrix4_columns<Column>{columns + i * 16}(from + i * 4)
+                    .store(to + i * 4);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = m[i] * in[i];
+    }
+}
+
+// out[i] = in[i].transposed()
+template <typename T>
+void transpose_n(
+        unaligned_view<matrix4<T>> in,
+        unaligned_view<matrix4<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        const auto from = in.template as<T>();
+        const auto to   = out.template as<T>();
+#pragma unroll 4
+        for (size_t i = 0; i < n * 16; i += 16) {
+            detail::transpose(from + i, to + i);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = in[i].transposed();
+    }
+}
+
+// the aligned overloads forward, see dot_product.h
+
+template <typename T, size_t Alignment>
+void multiply_n(
+        aligned_view<matrix4<T>, Alignment> a,
+        aligned_view<matrix4<T>, Alignment> b,
+        aligned_view<matrix4<T>, Alignment> out,
+        size_t n) {
+    multiply_n(
+            unaligned_view<matrix4<T>>{a.get()},
+            unaligned_view<matrix4<T>>{b.get()},
+            unaligned_view<matrix4<T>>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment>
+void multiply_n(
+        const matrix4<T>& a,
+        aligned_view<matrix4<T>, Alignment> b,
+        aligned_view<matrix4<T>, Alignment> out,
+        size_t n) {
+    multiply_n(
+            a,
+            unaligned_view<matrix4<T>>{b.get()},
+            unaligned_view<matrix4<T>>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment>
+void transform_n(
+        const matrix4<T>& m,
+        aligned_view<vector4<T>, Alignment> in,
+        aligned_view<vector4<T>, Alignment> out,
+        size_t n) {
+    transform_n(
+            m,
+            unaligned_view<vector4<T>>{in.get()},
+            unaligned_view<vector4<T>>{out.get()},
+            n);
+}
+
+template <typename T, size_t MatrixAlignment, size_t Alignment>
+void transform_n(
+        aligned_view<matrix4<T>, MatrixAlignment> m,
+        aligned_view<vector4<T>, Alignment> in,
+        aligned_view<vector4<T>, Alignment> out,
+        size_t n) {
+    transform_n(
+            unaligned_view<matrix4<T>>{m.get()},
+            unaligned_view<vector4<T>>{in.get()},
+            unaligned_view<vector4<T>>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment>
+void transpose_n(
+        aligned_view<matrix4<T>, Alignment> in,
+        aligned_view<matrix4<T>, Alignment> out,
+        size_t n) {
+    transpose_n(
+            unaligned_view<matrix4<T>>{in.get()},
+            unaligned_view<matrix4<T>>{out.get()},
+            n);
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
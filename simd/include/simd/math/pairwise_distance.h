@@ -0,0 +1,326 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/math/dot_product.h>
+#include <simd/math/vector2.h>
+#include <simd/math/vector2_batch.h>
+#include <simd/math/vector2_soa.h>
+#include <simd/view.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace simd::math {
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+namespace detail {
+
+#ifdef __AVX2__
+// the kernels pass blocks of pairwise_rows points of a over tiles of
+// pairwise_columns points of b; a tile is held as structure of arrays on the
+// stack, 8 KiB for float, and stays in L1 while the rows pass over it
+inline constexpr size_t pairwise_rows    = 128;
+inline constexpr size_t pairwise_columns = 1024;
+
+// b[0, n) as separate x and y arrays, zero padded by one register so that
+// loads may start at any j < n
+template <typename SimdVector, typename T>
+struct pairwise_tile {
+    alignas(64) T x[pairwise_columns + SimdVector::size];
+    alignas(64) T y[pairwise_columns + SimdVector::size];
+    size_t n;
+
+    pairwise_tile(unaligned_view<vector2<T>> b, size_t n) : n(n) {
+        aos_to_soa(b, unaligned_soa_view<T>{{x}, {y}}, n);
+        std::fill(x + n, x + n + SimdVector::size, T(0));
+        std::fill(y + n, y + n + SimdVector::size, T(0));
+    }
+
+    // the squared distances from (px, py) to the points [j, j + size)
+    SimdVector distance_squared(SimdVector px, SimdVector py, size_t j) {
+        const auto dx = SimdVector::load(unaligned_view<T>{x + j}) - px;
+        const auto dy = SimdVector::load(unaligned_view<T>{y + j}) - py;
+        return simd::fmadd(dx, dx, dy * dy);
+    }
+};
+
+// calls row(i, j0, tile) for every row i < m and every tile of b starting
+// at j0, going through the rows in blocks
+template <typename SimdVector, typename T, typename Row>
+void for_each_tile(size_t m, unaligned_view<vector2<T>> b, size_t n, Row row) {
+    for (size_t i0 = 0; i0 < m; i0 += pairwise_rows) {
+        const size_t rows = std::min(pairwise_rows, m - i0);
+        for (size_t j0 = 0; j0 < n; j0 += pairwise_columns) {
+            pairwise_tile<SimdVector, T> tile{
+                    b + j0, std::min(pairwise_columns, n - j0)};
+            for (size_t i = i0; i < i0 + rows; ++i) {
+                row(i, j0, tile);
+            }
+        }
+    }
+}
+
+// Stream peels one masked register off the front of the row, so that the
+// stores of the steady state loop are aligned
+template <bool Stream, typename SimdVector, typename T>
+void distance_row(
+        pairwise_tile<SimdVector, T>& tile,
+        vector2<T> p,
+        unaligned_view<T> out) {
+    using ByteViewType = aligned_view<T, SimdVector::width_bytes>;
+
+    const auto px = SimdVector::broadcast(p.x);
+    const auto py = SimdVector::broadcast(p.y);
+    size_t j      = 0;
+    if constexpr (Stream) {
+        const size_t misalignment = reinterpret_cast<uintptr_t>(out.get())
+                                    % SimdVector::width_bytes;
+        if (misalignment != 0) {
+            j = std::min(
+                    tile.n,
+                    (SimdVector::width_bytes - misalignment) / sizeof(T));
+            tile.distance_squared(px, py, 0)
+                    .store(out, SimdVector::first_n_mask(j));
+        }
+    }
+#pragma unroll 4
+    for (; j + SimdVector::size <= tile.n; j += SimdVector::size) {
+        const auto d = tile.distance_squared(px, py, j);
+        if constexpr (Stream) {
+            d.stream(ByteViewType{out.get() + j});
+        } else {
+            d.store(out + j);
+        }
+    }
+    if (j < tile.n) {
+        tile.distance_squared(px, py, j)
+                .store(out + j, SimdVector::first_n_mask(tile.n - j));
+    }
+}
+
+// the row-major matrix of squared distances
+template <bool Stream, typename T>
+void pairwise_distance_squared(
+        unaligned_view<vector2<T>> a,
+        size_t m,
+        unaligned_view<vector2<T>> b,
+        size_t n,
+        unaligned_view<T> out) {
+    using SimdVector = vector2_register<T>;
+    for_each_tile<SimdVector>(
+            m, b, n, [a, n, out](size_t i, size_t j0, auto& tile) {
+                distance_row<Stream>(tile, a[i], out + (i * n + j0));
+            });
+    if constexpr (Stream) {
+        simd::stream_fence();
+    }
+}
+#endif
+
+// the growing list of pairs of the threshold mode; pairs past capacity are
+// counted but not written
+struct pair_writer {
+    unaligned_view<int32_t> rows;
+    unaligned_view<int32_t> columns;
+    size_t capacity;
+    size_t count = 0;
+
+    void push(size_t i, size_t j) {
+        if (count < capacity) {
+            rows[count]    = static_cast<int32_t>(i);
+            columns[count] = static_cast<int32_t>(j);
+        }
+        ++count;
+    }
+};
+
+#ifdef __AVX2__
+// [0, 1, 2, ...]
+template <typename Indices>
+Indices lane_indices() {
+    int32_t lanes[Indices::size];
+    for (size_t k = 0; k < Indices::size; ++k) {
+        lanes[k] = static_cast<int32_t>(k);
+    }
+    return Indices::load(unaligned_view<int32_t>{lanes});
+}
+
+// pushes the pairs of row i with the tile at j0 that are closer than
+// radius_squared. Neighbours are expected to be sparse, so registers without
+// any are skipped; float compresses the column indices of the others while
+// there is room for a whole register, otherwise the lanes are pushed one by
+// one
+template <typename SimdVector, typename T>
+void within_row(
+        pairwise_tile<SimdVector, T>& tile,
+        size_t i,
+        size_t j0,
+        vector2<T> p,
+        SimdVector radius_squared,
+        pair_writer& pairs) {
+    using Indices   = bit_vector<int32_t, SimdVector::size * 32>;
+    const auto px   = SimdVector::broadcast(p.x);
+    const auto py   = SimdVector::broadcast(p.y);
+    const auto row  = Indices::broadcast(static_cast<int32_t>(i));
+    const auto step = Indices::broadcast(SimdVector::size);
+    auto columns    = lane_indices<Indices>()
+                   + Indices::broadcast(static_cast<int32_t>(j0));
+    for (size_t j = 0; j < tile.n; j += SimdVector::size, columns += step) {
+        auto close = simd::cmp_lt(
+                tile.distance_squared(px, py, j), radius_squared);
+        if (j + SimdVector::size > tile.n) {
+            close = close & SimdVector::first_n_mask(tile.n - j);
+        }
+        if (simd::none(close)) {
+            continue;
+        }
+        if constexpr (std::is_same_v<T, float>) {
+            // the full width stores stay inside capacity
+            if (pairs.count + SimdVector::size <= pairs.capacity) {
+                const auto found = typename Indices::mask_type(close);
+                simd::compress(found, columns)
+                        .store(pairs.columns + pairs.count);
+                row.store(pairs.rows + pairs.count);
+                pairs.count += simd::popcount(found);
+                continue;
+            }
+        }
+        for (unsigned bits = simd::movemask(close); bits != 0;
+             bits &= bits - 1) {
+            pairs.push(i, j0 + j + __builtin_ctz(bits));
+        }
+    }
+}
+#endif
+
+}  // namespace detail
+
+// out[i * n + j] = (a[i] - b[j]).dot(a[i] - b[j]) for i < m and j < n, i.e.
+// the row-major m x n matrix of squared distances. out must not overlap a or
+// b. A matrix of streaming_threshold() bytes or more is written with
+// non-temporal stores
+template <typename T>
+void pairwise_distance_squared(
+        unaligned_view<vector2<T>> a,
+        size_t m,
+        unaligned_view<vector2<T>> b,
+        size_t n,
+        unaligned_view<T> out) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        if (detail::streams_output<T>(m * n)) {
+            detail::pairwise_distance_squared<true>(a, m, b, n, out);
+        } else {
+            detail::pairwise_distance_squared<false>(a, m, b, n, out);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const vector2<T> d = a[i] - b[j];
+            out[i * n + j]     = d.dot(d);
+        }
+    }
+}
+
+// always writes the matrix with non-temporal stores
+template <typename T>
+void pairwise_distance_squared(
+        unaligned_view<vector2<T>> a,
+        size_t m,
+        unaligned_view<vector2<T>> b,
+        size_t n,
+        unaligned_view<T> out,
+        streaming_t) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        detail::pairwise_distance_squared<true>(a, m, b, n, out);
+        return;
+    }
+#endif
+    pairwise_distance_squared(a, m, b, n, out);
+}
+
+// the threshold mode: writes the (rows[k], columns[k]) = (i, j) for which
+// (a[i] - b[j]).dot(a[i] - b[j]) < radius_squared, in no particular order,
+// and returns their number. Only the first capacity pairs are written, so a
+// result above capacity tells how much room a second call needs; entries past
+// the result may be overwritten up to capacity
+template <typename T>
+size_t pairwise_distance_squared(
+        unaligned_view<vector2<T>> a,
+        size_t m,
+        unaligned_view<vector2<T>> b,
+        size_t n,
+        T radius_squared,
+        unaligned_view<int32_t> rows,
+        unaligned_view<int32_t> columns,
+        size_t capacity) {
+    detail::pair_writer pairs{rows, columns, capacity};
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        using SimdVector  = detail::vector2_register<T>;
+        const auto radius = SimdVector::broadcast(radius_squared);
+        detail::for_each_tile<SimdVector>(
+                m, b, n, [&](size_t i, size_t j0, auto& tile) {
+                    detail::within_row(tile, i, j0, a[i], radius, pairs);
+                });
+        return pairs.count;
+    }
+#endif
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const vector2<T> d = a[i] - b[j];
+            if (d.dot(d) < radius_squared) {
+                pairs.push(i, j);
+            }
+        }
+    }
+    return pairs.count;
+}
+
+// the aligned overloads forward, see dot_product.h
+
+template <typename T, size_t Alignment, size_t OutAlignment, typename... Mode>
+void pairwise_distance_squared(
+        aligned_view<vector2<T>, Alignment> a,
+        size_t m,
+        aligned_view<vector2<T>, Alignment> b,
+        size_t n,
+        aligned_view<T, OutAlignment> out,
+        Mode... mode) {
+    pairwise_distance_squared(
+            unaligned_view<vector2<T>>{a.get()},
+            m,
+            unaligned_view<vector2<T>>{b.get()},
+            n,
+            unaligned_view<T>{out.get()},
+            mode...);
+}
+
+template <typename T, size_t Alignment, size_t IndexAlignment>
+size_t pairwise_distance_squared(
+        aligned_view<vector2<T>, Alignment> a,
+        size_t m,
+        aligned_view<vector2<T>, Alignment> b,
+        size_t n,
+        T radius_squared,
+        aligned_view<int32_t, IndexAlignment> rows,
+        aligned_view<int32_t, IndexAlignment> columns,
+        size_t capacity) {
+    return pairwise_distance_squared(
+            unaligned_view<vector2<T>>{a.get()},
+            m,
+            unaligned_view<vector2<T>>{b.get()},
+            n,
+            radius_squared,
+            unaligned_view<int32_t>{rows.get()},
+            unaligned_view<int32_t>{columns.get()},
+            capacity);
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/view.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace simd::math {
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+namespace detail {
+
+template <typename F>
+using int_vector = simd::bit_vector<int32_t, F::size * 32>;
+
+// the same lanes as a mask of F
+template <typename F>
+typename F::mask_type as_float_mask(typename int_vector<F>::mask_type mask) {
+    return {mask.data};
+}
+
+// c[0] * x^(N - 1) + ... + c[N - 1]
+template <typename F, size_t N>
+F horner(F x, const float (&c)[N]) {
+    F result = F::broadcast(c[0]);
+    for (size_t i = 1; i < N; ++i) {
+        result = simd::fmadd(result, x, F::broadcast(c[i]));
+    }
+    return result;
+}
+
+// replaces the lanes set in mask with f of the same lane of x
+template <typename F, typename Function>
+F apply_scalar(F x, F result, typename F::mask_type mask, Function f) {
+    float in[F::size];
+    float out[F::size];
+    x.store(unaligned_view<float>{in});
+    result.store(unaligned_view<float>{out});
+    const int lanes = simd::movemask(mask);
+    for (size_t i = 0; i < F::size; ++i) {
+        if (lanes & (1 << i)) {
+            out[i] = f(in[i]);
+        }
+    }
+    return F::load(unaligned_view<float>{out});
+}
+
+// f of every lane of x
+template <typename F, typename Function>
+F map_scalar(F x, Function f) {
+    float lanes[F::size];
+    x.store(unaligned_view<float>{lanes});
+    for (size_t i = 0; i < F::size; ++i) {
+        lanes[i] = f(lanes[i]);
+    }
+    return F::load(unaligned_view<float>{lanes});
+}
+
+template <typename F>
+F exp(F x) {
+    using I = int_vector<F>;
+    // exp rounds to zero below -104 and overflows above 89; the clamp only
+    // keeps the exponent arithmetic in range
+    const F clamped = simd::min(
+            simd::max(x, F::broadcast(-104.f)), F::broadcast(89.f));
+
+    // x = n * ln 2 + r with |r| <= ln 2 / 2, ln 2 split in two parts
+    const I n = simd::round_to_int(
+            clamped * F::broadcast(1.44269504088896341f));
+    const F nf = simd::to_float(n);
+    F r        = simd::fnmadd(nf, F::broadcast(0.693359375f), clamped);
+    r          = simd::fnmadd(nf, F::broadcast(-2.12194440e-4f), r);
+
+    static constexpr float c[] = {
+            1.9875691500e-4f,
+            1.3981999507e-3f,
+            8.3334519073e-3f,
+            4.1665795894e-2f,
+            1.6666665459e-1f,
+            5.0000001201e-1f};
+    const F p = simd::fmadd(horner(r, c), r * r, r) + F::broadcast(1.f);
+
+    // 2^n as two factors, so that 2^128 and the subnormal results, which
+    // have no biased exponent of their own, still come out right
+    const I half   = n >> 1;
+    const I bias   = I::broadcast(127);
+    const F result = p * static_cast<F>((half + bias) << 23)
+                     * static_cast<F>((n - half + bias) << 23);
+    return simd::select(simd::cmp_ne(x, x), x, result);
+}
+
+template <typename F>
+F log(F x) {
+    using I = int_vector<F>;
+    const F zero = F::broadcast(0.f);
+    const F inf  = F::broadcast(std::numeric_limits<float>::infinity());
+
+    // subnormals are scaled by 2^23 into the normal range first
+    const auto subnormal = simd::cmp_lt(
+            x, F::broadcast(std::numeric_limits<float>::min()));
+    const I bits = static_cast<I>(
+            simd::select(subnormal, x * F::broadcast(8388608.f), x));
+    I e = (bits >> 23) - I::broadcast(126);
+    e   = simd::select(
+            typename I::mask_type{subnormal.data}, e - I::broadcast(23), e);
+
+    // x = m * 2^e with m in [sqrt(0.5), sqrt(2))
+    F m = static_cast<F>(
+            (bits & I::broadcast(0x007fffff)) | I::broadcast(0x3f000000));
+    const auto small = simd::cmp_lt(m, F::broadcast(0.707106781186547524f));
+    e = simd::select(typename I::mask_type{small.data}, e - I::broadcast(1), e);
+    m = simd::select(small, m + m, m) - F::broadcast(1.f);
+
+    static constexpr float c[] = {
+            7.0376836292e-2f,
+            -1.1514610310e-1f,
+            1.1676998740e-1f,
+            -1.2420140846e-1f,
+            1.4249322787e-1f,
+            -1.6668057665e-1f,
+            2.0000714765e-1f,
+            -2.4999993993e-1f,
+            3.3333331174e-1f};
+    const F ef = simd::to_float(e);
+    const F z  = m * m;
+    F y        = horner(m, c) * m * z;
+    y          = simd::fmadd(ef, F::broadcast(-2.12194440e-4f), y);
+    y          = simd::fnmadd(z, F::broadcast(0.5f), y);
+    F result   = simd::fmadd(ef, F::broadcast(0.693359375f), m + y);
+
+    result = simd::select(simd::cmp_eq(x, zero), -inf, result);
+    result = simd::select(
+            simd::cmp_lt(x, zero),
+            F::broadcast(std::numeric_limits<float>::quiet_NaN()),
+            result);
+    result = simd::select(simd::cmp_eq(x, inf), inf, result);
+    return simd::select(simd::cmp_ne(x, x), x, result);
+}
+
+// beyond 2^20 the three part reduction by pi / 2 loses accuracy and the
+// lanes are finished by libm
+inline constexpr float sin_cos_limit = 1048576.f;
+
+// sin(x + Quadrant * pi / 2)
+template <int Quadrant, typename F>
+F sin_cos(F x) {
+    const auto libm = [](float v) {
+        return Quadrant == 0 ? std::sin(v) : std::cos(v);
+    };
+#ifndef __FMA__
+    // q * 1.57079637f takes up to 44 bits, so without fma the reduction
+    // below rounds it and r loses its low bits near the zeros
+    return map_scalar(x, libm);
+#endif
+    using I = int_vector<F>;
+    // x = q * pi / 2 + r with |r| <= pi / 4, pi / 2 split into three floats.
+    // Each fma subtracts the exact product, so r keeps its bits near the
+    // zeros
+    const I q  = simd::round_to_int(x * F::broadcast(0.636619772367581343f));
+    const F qf = simd::to_float(q);
+    F r        = simd::fnmadd(qf, F::broadcast(1.57079637f), x);
+    r          = simd::fnmadd(qf, F::broadcast(-4.37113883e-8f), r);
+    r          = simd::fnmadd(qf, F::broadcast(-1.71512451e-15f), r);
+
+    static constexpr float sin_c[] = {
+            -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};
+    static constexpr float cos_c[] = {
+            2.443315711809948e-5f,
+            -1.388731625493765e-3f,
+            4.166664568298827e-2f};
+    const F z     = r * r;
+    const F sin_r = simd::fmadd(horner(z, sin_c) * z, r, r);
+    const F cos_r = simd::fmadd(
+            horner(z, cos_c) * z,
+            z,
+            simd::fnmadd(z, F::broadcast(0.5f), F::broadcast(1.f)));
+
+    // odd quadrants swap sin and cos, quadrants 2 and 3 flip the sign
+    const I k      = q + I::broadcast(Quadrant);
+    const I one    = I::broadcast(1);
+    const auto odd = as_float_mask<F>(simd::cmp_eq(k & one, one));
+    F signed_result = simd::select(odd, cos_r, sin_r)
+                      ^ static_cast<F>((k & I::broadcast(2)) << 30);
+    if constexpr (Quadrant == 0) {
+        // the reduction turns -0 into +0
+        signed_result = simd::select(
+                simd::cmp_eq(x, F::broadcast(0.f)), x, signed_result);
+    }
+    const auto in_range
+            = simd::cmp_le(simd::abs(x), F::broadcast(sin_cos_limit));
+    if (simd::all(in_range)) {
+        return signed_result;
+    }
+    // infinities and NaN come out as NaN from libm as well
+    return apply_scalar(x, signed_result, ~in_range, libm);
+}
+
+template <typename F>
+F atan2(F y, F x) {
+    using I      = int_vector<F>;
+    const F zero = F::broadcast(0.f);
+    const F ax   = simd::abs(x);
+    const F ay   = simd::abs(y);
+    const F lo   = simd::min(ax, ay);
+    const F hi   = simd::max(ax, ay);
+
+    // the angle of (hi, lo) from t = lo / hi in [0, 1]; two infinities make
+    // the diagonal and two zeros the positive x axis
+    F t = lo / hi;
+    t   = simd::select(
+            simd::cmp_eq(
+                    lo, F::broadcast(std::numeric_limits<float>::infinity())),
+            F::broadcast(1.f),
+            t);
+    t = simd::select(simd::cmp_eq(hi, zero), zero, t);
+
+    // above tan(pi / 8), atan(t) = pi / 4 + atan((t - 1) / (t + 1))
+    const auto reduce = simd::cmp_gt(t, F::broadcast(0.414213562373095f));
+    const F u         = simd::select(
+            reduce, (t - F::broadcast(1.f)) / (t + F::broadcast(1.f)), t);
+    static constexpr float c[] = {
+            8.05374449538e-2f,
+            -1.38776856032e-1f,
+            1.99777106478e-1f,
+            -3.33329491539e-1f};
+    const F z = u * u;
+    F angle   = simd::fmadd(horner(z, c) * z, u, u);
+    angle     = angle
+            + simd::select(reduce, F::broadcast(0.785398163397448f), zero);
+
+    // back from the first octant to the quadrant of (|x|, |y|) and then to
+    // the half plane of x; the sign bit of x, so that -0 counts as negative
+    angle = simd::select(
+            simd::cmp_gt(ay, ax),
+            F::broadcast(1.57079632679490f) - angle,
+            angle);
+    const auto x_negative = as_float_mask<F>(
+            simd::cmp_gt(I::broadcast(0), static_cast<I>(x)));
+    angle = simd::select(
+            x_negative, F::broadcast(3.14159265358979f) - angle, angle);
+    angle = angle | (y & F::broadcast(-0.f));
+    return simd::select(
+            simd::cmp_ne(x, x) | simd::cmp_ne(y, y), x + y, angle);
+}
+
+}  // namespace detail
+
+// vectorized libm functions for f32x4 and f32x8, each within the stated
+// number of ulp of the correctly rounded result over the whole float range.
+// NaN gives NaN, and the limits and special values follow libm
+
+// within 1 ulp. Results below FLT_MIN are rounded to subnormals
+inline f32x4 exp(f32x4 x) {
+    return detail::exp(x);
+}
+
+inline f32x8 exp(f32x8 x) {
+    return detail::exp(x);
+}
+
+// within 1 ulp
+inline f32x4 log(f32x4 x) {
+    return detail::log(x);
+}
+
+inline f32x8 log(f32x8 x) {
+    return detail::log(x);
+}
+
+// within 2 ulp. Lanes with |x| above 2^20 are computed by libm, which is
+// much slower than the polynomial. The reduction by pi / 2 needs fma;
+// without it every lane is computed by libm
+inline f32x4 sin(f32x4 x) {
+    return detail::sin_cos<0>(x);
+}
+
+inline f32x8 sin(f32x8 x) {
+    return detail::sin_cos<0>(x);
+}
+
+inline f32x4 cos(f32x4 x) {
+    return detail::sin_cos<1>(x);
+}
+
+inline f32x8 cos(f32x8 x) {
+    return detail::sin_cos<1>(x);
+}
+
+// the angle of (x, y) in [-pi, pi], within 3 ulp
+inline f32x4 atan2(f32x4 y, f32x4 x) {
+    return detail::atan2(y, x);
+}
+
+inline f32x8 atan2(f32x8 y, f32x8 x) {
+    return detail::atan2(y, x);
+}
+
+// correctly rounded, see bit_vector.h
+using simd::sqrt;
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <simd/isa.h>
+
 #include <cstdint>
 #include <type_traits>
 
@@ -11,27 +13,32 @@ struct vector2 {
     T x;
     T y;
 
+    SIMD_ISA_TAGGED
     constexpr vector2<T>& operator+=(const vector2<T> rhs) {
         x += rhs.x;
         y += rhs.y;
         return *this;
     }
 
+    SIMD_ISA_TAGGED
     constexpr vector2<T> operator+(const vector2<T> rhs) const {
         return {.x = x + rhs.x, .y = y + rhs.y};
     }
 
+    SIMD_ISA_TAGGED
     constexpr vector2<T>& operator-=(const vector2<T> rhs) {
         x -= rhs.x;
         y -= rhs.y;
         return *this;
     }
 
+    SIMD_ISA_TAGGED
     constexpr vector2<T> operator-(const vector2<T> rhs) const {
         return {.x = x - rhs.x, .y = y - rhs.y};
     }
 
     template <typename Scalar>
+    SIMD_ISA_TAGGED
     constexpr vector2<T>& operator*=(Scalar s) {
         x *= s;
         y *= s;
@@ -39,12 +46,14 @@ struct vector2 {
     }
 
     template <typename Scalar>
+    SIMD_ISA_TAGGED
     constexpr vector2<T>& operator/=(Scalar s) {
         x /= s;
         y /= s;
         return *this;
     }
 
+    SIMD_ISA_TAGGED
     constexpr T dot(const vector2<T> other) const {
         return x * other.x + y * other.y;
     }
@@ -56,6 +65,8 @@ using vector2f = vector2<float>;
 using vector2l = vector2<int64_t>;
 using vector2d = vector2<double>;
 
+inline namespace SIMD_ISA_NAMESPACE {
+
 template <typename T, typename Scalar>
 constexpr vector2<T> operator*(const vector2<T> vec, Scalar s) {
     return {.x = T(vec.x * s), .y = T(vec.y * s)};
@@ -71,4 +82,6 @@ constexpr vector2<T> operator/(const vector2<T> vec, Scalar s) {
     return {.x = T(vec.x / s), .y = T(vec.y / s)};
 }
 
+}  // namespace SIMD_ISA_NAMESPACE
+
 }  // namespace simd::math
@@ -0,0 +1,456 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/math/batch.h>
+#include <simd/math/dot_product.h>
+#include <simd/math/vector2.h>
+#include <simd/view.h>
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+namespace simd::math {
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+namespace detail {
+
+#ifdef __AVX2__
+// the widest register the batch kernels hold components of T in. Its size
+// is even, so every register of transform_components starts on an x
+// component
+#ifdef __AVX512F__
+template <typename T>
+using vector2_register = std::
+        conditional_t<std::is_same_v<T, float>, f32x16, bit_vector<T, 256>>;
+#else
+template <typename T>
+using vector2_register = bit_vector<T, 256>;
+#endif
+
+// the masks of the two registers holding the components of n <
+// SimdVector::size vector2
+template <typename SimdVector>
+auto component_masks(size_t n) {
+    const size_t components = n * 2;
+    return std::pair{
+            SimdVector::first_n_mask(components),
+            SimdVector::first_n_mask(
+                    components > SimdVector::size
+                            ? components - SimdVector::size
+                            : 0)};
+}
+
+// [s0, s0, s1, s1, ...] and the same for the upper half of s, lining one
+// factor per element up with the components
+template <typename SimdVector>
+std::pair<SimdVector, SimdVector> duplicate_lanes(SimdVector s) {
+    return simd::interleave(s, s);
+}
+
+#ifdef __AVX512F__
+inline std::pair<f32x16, f32x16> duplicate_lanes(f32x16 s) {
+    const auto lo
+            = i32x16::from(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+    const auto hi = lo + i32x16::broadcast(8);
+    return {simd::permutex2var(s, lo, s), simd::permutex2var(s, hi, s)};
+}
+#endif
+
+// even in the x lanes and odd in the y lanes
+template <typename SimdVector, typename T>
+SimdVector alternating(T even, T odd) {
+    T lanes[SimdVector::size];
+    for (size_t i = 0; i < SimdVector::size; ++i) {
+        lanes[i] = i % 2 == 0 ? even : odd;
+    }
+    return SimdVector::load(unaligned_view<T>{lanes});
+}
+
+// -1 in the x lanes and 1 in the y lanes
+template <typename SimdVector, typename T>
+SimdVector x_signs() {
+    return alternating<SimdVector>(T(-1), T(1));
+}
+
+template <typename SimdVector, typename T>
+void scale_by_n(
+        unaligned_view<T> a,
+        unaligned_view<T> s,
+        unaligned_view<T> out,
+        size_t n) {
+    size_t i = 0;
+    for (; i + SimdVector::size <= n; i += SimdVector::size) {
+        const auto [lo, hi] = duplicate_lanes(SimdVector::load(s + i));
+        (SimdVector::load(a + i * 2) * lo).store(out + i * 2);
+        (SimdVector::load(a + i * 2 + SimdVector::size) * hi)
+                .store(out + i * 2 + SimdVector::size);
+    }
+    if (i < n) {
+        const auto [mask_lo, mask_hi] = component_masks<SimdVector>(n - i);
+        const auto [lo, hi]           = duplicate_lanes(
+                SimdVector::load(s + i, SimdVector::first_n_mask(n - i)));
+        (SimdVector::load(a + i * 2, mask_lo) * lo)
+                .store(out + i * 2, mask_lo);
+        (SimdVector::load(a + i * 2 + SimdVector::size, mask_hi) * hi)
+                .store(out + i * 2 + SimdVector::size, mask_hi);
+    }
+}
+
+template <typename SimdVector, typename T>
+void length_blocks(unaligned_view<T> a, unaligned_view<T> out, size_t n) {
+    size_t i = 0;
+#pragma unroll 4
+    for (; i + SimdVector::size <= n; i += SimdVector::size) {
+        const auto lo = SimdVector::load(a + i * 2);
+        const auto hi = SimdVector::load(a + i * 2 + SimdVector::size);
+        simd::sqrt(dot_product_block(lo, hi, lo, hi)).store(out + i);
+    }
+    if (i < n) {
+        const auto [mask_lo, mask_hi] = component_masks<SimdVector>(n - i);
+        const auto lo = SimdVector::load(a + i * 2, mask_lo);
+        const auto hi = SimdVector::load(a + i * 2 + SimdVector::size, mask_hi);
+        simd::sqrt(dot_product_block(lo, hi, lo, hi))
+                .store(out + i, SimdVector::first_n_mask(n - i));
+    }
+}
+
+template <bool Approximate, typename SimdVector>
+SimdVector normalize_block(SimdVector v) {
+    const auto zero    = SimdVector::broadcast(0);
+    const auto squares = v * v;
+    // the squared length of every vector2 in both of its lanes
+    const auto length_squared = squares + simd::swap_pairs(squares);
+    return simd::select(
+            simd::cmp_gt(length_squared, zero),
+            v * inverse_sqrt<Approximate>(length_squared),
+            zero);
+}
+#endif
+
+template <bool Approximate, typename T>
+void normalize_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "normalize_n requires floating point components");
+#ifdef __AVX2__
+    if constexpr (simd_components<T>) {
+        transform_components<vector2_register<T>>(
+                out.template as<T>(),
+                n * 2,
+                [](auto v) { return normalize_block<Approximate>(v); },
+                a.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        const T length = std::sqrt(a[i].dot(a[i]));
+        out[i]         = length > 0 ? a[i] / length : vector2<T>{};
+    }
+}
+
+}  // namespace detail
+
+// the element-wise kernels below read every input element before writing
+// the output element at the same index, so out may be one of the inputs
+
+// out[i] = a[i] + b[i]
+template <typename T>
+void add_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        detail::transform_components<detail::vector2_register<T>>(
+                out.template as<T>(),
+                n * 2,
+                [](auto x, auto y) { return x + y; },
+                a.template as<T>(),
+                b.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i] + b[i];
+    }
+}
+
+// out[i] = a[i] - b[i]
+template <typename T>
+void sub_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        detail::transform_components<detail::vector2_register<T>>(
+                out.template as<T>(),
+                n * 2,
+                [](auto x, auto y) { return x - y; },
+                a.template as<T>(),
+                b.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i] - b[i];
+    }
+}
+
+// out[i] = a[i] * s
+template <typename T>
+void scale_n(
+        unaligned_view<vector2<T>> a,
+        T s,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        using SimdVector  = detail::vector2_register<T>;
+        const auto factor = SimdVector::broadcast(s);
+        detail::transform_components<SimdVector>(
+                out.template as<T>(),
+                n * 2,
+                [factor](auto x) { return x * factor; },
+                a.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i] * s;
+    }
+}
+
+// out[i] = a[i] * s[i]
+template <typename T>
+void scale_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<T> s,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        detail::scale_by_n<detail::vector2_register<T>>(
+                a.template as<T>(), s, out.template as<T>(), n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i] * s[i];
+    }
+}
+
+// out[i] = a[i] + (b[i] - a[i]) * t
+template <typename T>
+void lerp_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        T t,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        using SimdVector  = detail::vector2_register<T>;
+        const auto weight = SimdVector::broadcast(t);
+        detail::transform_components<SimdVector>(
+                out.template as<T>(),
+                n * 2,
+                [weight](auto x, auto y) {
+                    return simd::fmadd(y - x, weight, x);
+                },
+                a.template as<T>(),
+                b.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+}
+
+// out[i] = a[i] rotated by 90 degrees counterclockwise, i.e. (-y, x)
+template <typename T>
+void perp_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        using SimdVector = detail::vector2_register<T>;
+        const auto signs = detail::x_signs<SimdVector, T>();
+        detail::transform_components<SimdVector>(
+                out.template as<T>(),
+                n * 2,
+                [signs](auto x) { return simd::swap_pairs(x) * signs; },
+                a.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        const vector2<T> v = a[i];
+        out[i]             = {-v.y, v.x};
+    }
+}
+
+// out[i] = a[i].dot(a[i])
+template <typename T>
+void length_squared_n(
+        unaligned_view<vector2<T>> a, unaligned_view<T> out, size_t n) {
+    dot_product_n(a, a, out, n);
+}
+
+// out[i] = sqrt(a[i].dot(a[i]))
+template <typename T>
+void length_n(unaligned_view<vector2<T>> a, unaligned_view<T> out, size_t n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "length_n requires floating point components");
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        detail::length_blocks<detail::vector2_register<T>>(
+                a.template as<T>(), out, n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = std::sqrt(a[i].dot(a[i]));
+    }
+}
+
+// out[i] = a[i] / length(a[i]); vectors of length zero are written as zero
+template <typename T>
+void normalize_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> out,
+        size_t n) {
+    detail::normalize_n<false>(a, out, n);
+}
+
+template <typename T>
+void normalize_n(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> out,
+        size_t n,
+        approximate_t) {
+    detail::normalize_n<true>(a, out, n);
+}
+
+// the aligned overloads forward, see dot_product.h
+
+template <typename T, size_t Alignment>
+void add_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<vector2<T>, Alignment> b,
+        aligned_view<vector2<T>, Alignment> out,
+        size_t n) {
+    add_n(unaligned_view<vector2<T>>{a.get()},
+          unaligned_view<vector2<T>>{b.get()},
+          unaligned_view<vector2<T>>{out.get()},
+          n);
+}
+
+template <typename T, size_t Alignment>
+void sub_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<vector2<T>, Alignment> b,
+        aligned_view<vector2<T>, Alignment> out,
+        size_t n) {
+    sub_n(unaligned_view<vector2<T>>{a.get()},
+          unaligned_view<vector2<T>>{b.get()},
+          unaligned_view<vector2<T>>{out.get()},
+          n);
+}
+
+template <typename T, size_t Alignment>
+void scale_n(
+        aligned_view<vector2<T>, Alignment> a,
+        T s,
+        aligned_view<vector2<T>, Alignment> out,
+        size_t n) {
+    scale_n(unaligned_view<vector2<T>>{a.get()},
+            s,
+            unaligned_view<vector2<T>>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment, size_t ScaleAlignment>
+void scale_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<T, ScaleAlignment> s,
+        aligned_view<vector2<T>, Alignment> out,
+        size_t n) {
+    scale_n(unaligned_view<vector2<T>>{a.get()},
+            unaligned_view<T>{s.get()},
+            unaligned_view<vector2<T>>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment>
+void lerp_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<vector2<T>, Alignment> b,
+        T t,
+        aligned_view<vector2<T>, Alignment> out,
+        size_t n) {
+    lerp_n(unaligned_view<vector2<T>>{a.get()},
+           unaligned_view<vector2<T>>{b.get()},
+           t,
+           unaligned_view<vector2<T>>{out.get()},
+           n);
+}
+
+template <typename T, size_t Alignment>
+void perp_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<vector2<T>, Alignment> out,
+        size_t n) {
+    perp_n(unaligned_view<vector2<T>>{a.get()},
+           unaligned_view<vector2<T>>{out.get()},
+           n);
+}
+
+template <typename T, size_t Alignment, size_t OutAlignment>
+void length_squared_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<T, OutAlignment> out,
+        size_t n) {
+    length_squared_n(
+            unaligned_view<vector2<T>>{a.get()},
+            unaligned_view<T>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment, size_t OutAlignment>
+void length_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<T, OutAlignment> out,
+        size_t n) {
+    length_n(
+            unaligned_view<vector2<T>>{a.get()},
+            unaligned_view<T>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment, typename... Mode>
+void normalize_n(
+        aligned_view<vector2<T>, Alignment> a,
+        aligned_view<vector2<T>, Alignment> out,
+        size_t n,
+        Mode... mode) {
+    normalize_n(
+            unaligned_view<vector2<T>>{a.get()},
+            unaligned_view<vector2<T>>{out.get()},
+            n,
+            mode...);
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
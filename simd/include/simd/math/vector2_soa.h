@@ -0,0 +1,139 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/math/vector2.h>
+#include <simd/memory.h>
+#include <simd/view.h>
+
+#include <type_traits>
+
+namespace simd::math {
+
+template <typename T>
+struct unaligned_soa_view {
+    unaligned_view<T> x;
+    unaligned_view<T> y;
+
+    vector2<T> operator[](size_t i) const { return {x[i], y[i]}; }
+
+    unaligned_soa_view<T> operator+(long long int n) const {
+        return {x + n, y + n};
+    }
+};
+
+// x and y hold the components of the same elements in two separate arrays,
+// each starting on an Alignment boundary
+template <typename T, size_t Alignment>
+struct aligned_soa_view {
+    aligned_view<T, Alignment> x;
+    aligned_view<T, Alignment> y;
+
+    vector2<T> operator[](size_t i) const { return {x[i], y[i]}; }
+
+    explicit operator unaligned_soa_view<T>() const {
+        return {unaligned_view<T>{x.data}, unaligned_view<T>{y.data}};
+    }
+};
+
+// owns n vector2 stored as structure of arrays; both arrays are zeroed
+// aligned_buffers, padding included
+template <typename T>
+class vector2_soa {
+public:
+    static constexpr size_t alignment = 64;
+
+    vector2_soa() = default;
+
+    explicit vector2_soa(size_t n) : _x(n, zero_fill), _y(n, zero_fill) {}
+
+    size_t size() const { return _x.size(); }
+
+    T* x() { return _x.data(); }
+    const T* x() const { return _x.data(); }
+    T* y() { return _y.data(); }
+    const T* y() const { return _y.data(); }
+
+    vector2<T> operator[](size_t i) const { return {x()[i], y()[i]}; }
+
+    void set(size_t i, vector2<T> value) {
+        _x[i] = value.x;
+        _y[i] = value.y;
+    }
+
+    aligned_soa_view<T, alignment> view() { return {_x.view(), _y.view()}; }
+
+private:
+    aligned_buffer<T, alignment> _x;
+    aligned_buffer<T, alignment> _y;
+};
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+// copies n packed [x, y] pairs into separate x and y arrays
+template <typename T>
+void aos_to_soa(
+        unaligned_view<vector2<T>> in, unaligned_soa_view<T> out, size_t n) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        using SimdVector = simd::bit_vector<T, 256>;
+        auto components  = in.template as<T>();
+        for (; i + SimdVector::size <= n; i += SimdVector::size) {
+            auto [x, y] = simd::deinterleave(
+                    SimdVector::load(components + i * 2),
+                    SimdVector::load(components + i * 2 + SimdVector::size));
+            x.store(out.x + i);
+            y.store(out.y + i);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out.x[i] = in[i].x;
+        out.y[i] = in[i].y;
+    }
+}
+
+// the inverse of aos_to_soa
+template <typename T>
+void soa_to_aos(
+        unaligned_soa_view<T> in, unaligned_view<vector2<T>> out, size_t n) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        using SimdVector = simd::bit_vector<T, 256>;
+        auto components  = out.template as<T>();
+        for (; i + SimdVector::size <= n; i += SimdVector::size) {
+            auto [lo, hi] = simd::interleave(
+                    SimdVector::load(in.x + i), SimdVector::load(in.y + i));
+            lo.store(components + i * 2);
+            hi.store(components + i * 2 + SimdVector::size);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = in[i];
+    }
+}
+
+// converts once at ingest
+template <typename T>
+vector2_soa<T> to_soa(unaligned_view<vector2<T>> in, size_t n) {
+    vector2_soa<T> soa{n};
+    aos_to_soa(in, unaligned_soa_view<T>(soa.view()), n);
+    return soa;
+}
+
+template <typename T>
+void to_aos(const vector2_soa<T>& in, unaligned_view<vector2<T>> out) {
+    // soa_to_aos only reads through the view
+    soa_to_aos(
+            unaligned_soa_view<T>{
+                    unaligned_view<T>{const_cast<T*>(in.x())},
+                    unaligned_view<T>{const_cast<T*>(in.y())}},
+            out,
+            in.size());
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
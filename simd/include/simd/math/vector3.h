@@ -0,0 +1,100 @@
+#pragma once
+
+#include <simd/isa.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace simd::math {
+
+#pragma pack(push, 0)
+template <typename T>
+struct vector3 {
+    T x;
+    T y;
+    T z;
+
+    SIMD_ISA_TAGGED
+    constexpr vector3<T>& operator+=(const vector3<T> rhs) {
+        x += rhs.x;
+        y += rhs.y;
+        z += rhs.z;
+        return *this;
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr vector3<T> operator+(const vector3<T> rhs) const {
+        return {.x = x + rhs.x, .y = y + rhs.y, .z = z + rhs.z};
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr vector3<T>& operator-=(const vector3<T> rhs) {
+        x -= rhs.x;
+        y -= rhs.y;
+        z -= rhs.z;
+        return *this;
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr vector3<T> operator-(const vector3<T> rhs) const {
+        return {.x = x - rhs.x, .y = y - rhs.y, .z = z - rhs.z};
+    }
+
+    template <typename Scalar>
+    SIMD_ISA_TAGGED
+    constexpr vector3<T>& operator*=(Scalar s) {
+        x *= s;
+        y *= s;
+        z *= s;
+        return *this;
+    }
+
+    template <typename Scalar>
+    SIMD_ISA_TAGGED
+    constexpr vector3<T>& operator/=(Scalar s) {
+        x /= s;
+        y /= s;
+        z /= s;
+        return *this;
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr T dot(const vector3<T> other) const {
+        return x * other.x + y * other.y + z * other.z;
+    }
+
+    // right-handed: x.cross(y) = z
+    SIMD_ISA_TAGGED
+    constexpr vector3<T> cross(const vector3<T> other) const {
+        return {.x = y * other.z - z * other.y,
+                .y = z * other.x - x * other.z,
+                .z = x * other.y - y * other.x};
+    }
+};
+#pragma pack(pop)
+
+using vector3i = vector3<int32_t>;
+using vector3f = vector3<float>;
+using vector3l = vector3<int64_t>;
+using vector3d = vector3<double>;
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+template <typename T, typename Scalar>
+constexpr vector3<T> operator*(const vector3<T> vec, Scalar s) {
+    return {.x = T(vec.x * s), .y = T(vec.y * s), .z = T(vec.z * s)};
+}
+
+template <typename T, typename Scalar>
+constexpr vector3<T> operator*(Scalar s, const vector3<T> vec) {
+    return {.x = T(s * vec.x), .y = T(s * vec.y), .z = T(s * vec.z)};
+}
+
+template <typename T, typename Scalar>
+constexpr vector3<T> operator/(const vector3<T> vec, Scalar s) {
+    return {.x = T(vec.x / s), .y = T(vec.y / s), .z = T(vec.z / s)};
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
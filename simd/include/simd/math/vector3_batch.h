@@ -0,0 +1,285 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/math/batch.h>
+#include <simd/math/vector3.h>
+#include <simd/view.h>
+
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+
+namespace simd::math {
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+namespace detail {
+
+#ifdef __AVX2__
+// three registers hold SimdVector::size packed vector3 and are split into
+// one register per axis with shuffles, so every kernel below works on x, y
+// and z registers as if the input were stored as separate arrays
+template <typename T>
+using vector3_register = bit_vector<T, 256>;
+
+template <typename SimdVector>
+using vector3_block = std::tuple<SimdVector, SimdVector, SimdVector>;
+
+template <typename SimdVector>
+using vector3_masks = std::array<typename SimdVector::mask_type, 3>;
+
+template <typename SimdVector, typename T>
+vector3_block<SimdVector> load_vector3(unaligned_view<T> components) {
+    return simd::deinterleave3(
+            SimdVector::load(components),
+            SimdVector::load(components + SimdVector::size),
+            SimdVector::load(components + SimdVector::size * 2));
+}
+
+template <typename SimdVector, typename T>
+vector3_block<SimdVector> load_vector3(
+        unaligned_view<T> components, const vector3_masks<SimdVector>& masks) {
+    return simd::deinterleave3(
+            SimdVector::load(components, masks[0]),
+            SimdVector::load(components + SimdVector::size, masks[1]),
+            SimdVector::load(components + SimdVector::size * 2, masks[2]));
+}
+
+template <typename SimdVector, typename T>
+void store_vector3(
+        const vector3_block<SimdVector>& v, unaligned_view<T> components) {
+    const auto [x, y, z]    = v;
+    const auto [v0, v1, v2] = simd::interleave3(x, y, z);
+    v0.store(components);
+    v1.store(components + SimdVector::size);
+    v2.store(components + SimdVector::size * 2);
+}
+
+template <typename SimdVector, typename T>
+void store_vector3(
+        const vector3_block<SimdVector>& v,
+        unaligned_view<T> components,
+        const vector3_masks<SimdVector>& masks) {
+    const auto [x, y, z]    = v;
+    const auto [v0, v1, v2] = simd::interleave3(x, y, z);
+    v0.store(components, masks[0]);
+    v1.store(components + SimdVector::size, masks[1]);
+    v2.store(components + SimdVector::size * 2, masks[2]);
+}
+
+template <typename SimdVector>
+SimdVector dot_product_block(
+        const vector3_block<SimdVector>& a,
+        const vector3_block<SimdVector>& b) {
+    const auto [ax, ay, az] = a;
+    const auto [bx, by, bz] = b;
+    return simd::fmadd(ax, bx, simd::fmadd(ay, by, az * bz));
+}
+
+// the masks of a block holding fewer than SimdVector::size vector3
+template <typename SimdVector>
+struct vector3_tail {
+    typename SimdVector::mask_type elements;
+    vector3_masks<SimdVector> components;
+};
+
+// applies op to blocks of SimdVector::size vector3 from every input and
+// hands the result to store(result, i), adding a vector3_tail for the last
+// partial block
+template <typename SimdVector, typename Op, typename Store, typename... Inputs>
+void vector3_blocks(size_t n, Op op, Store store, Inputs... in) {
+    size_t i = 0;
+    for (; i + SimdVector::size <= n; i += SimdVector::size) {
+        store(op(load_vector3<SimdVector>(in + i * 3)...), i);
+    }
+    if (i < n) {
+        const vector3_tail<SimdVector> tail{
+                SimdVector::first_n_mask(n - i),
+                register_masks<SimdVector, 3>((n - i) * 3)};
+        store(op(load_vector3<SimdVector>(in + i * 3, tail.components)...),
+              i,
+              tail);
+    }
+}
+
+// op returns one value per vector3, written to out
+template <typename SimdVector, typename T, typename Op, typename... Inputs>
+void vector3_to_scalar_n(
+        unaligned_view<T> out, size_t n, Op op, Inputs... in) {
+    vector3_blocks<SimdVector>(
+            n,
+            op,
+            [out](SimdVector result, size_t i, const auto&... tail) {
+                result.store(out + i, tail.elements...);
+            },
+            in...);
+}
+
+// op returns a vector3_block, written to out
+template <typename SimdVector, typename T, typename Op, typename... Inputs>
+void vector3_to_vector3_n(
+        unaligned_view<T> out, size_t n, Op op, Inputs... in) {
+    vector3_blocks<SimdVector>(
+            n,
+            op,
+            [out](const vector3_block<SimdVector>& result,
+                  size_t i,
+                  const auto&... tail) {
+                store_vector3(result, out + i * 3, tail.components...);
+            },
+            in...);
+}
+#endif
+
+template <bool Approximate, typename T>
+void normalize_n(
+        unaligned_view<vector3<T>> a,
+        unaligned_view<vector3<T>> out,
+        size_t n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "normalize_n requires floating point components");
+#ifdef __AVX2__
+    if constexpr (simd_components<T>) {
+        using SimdVector = vector3_register<T>;
+        vector3_to_vector3_n<SimdVector>(
+                out.template as<T>(),
+                n,
+                [](const vector3_block<SimdVector>& v) {
+                    const auto zero           = SimdVector::broadcast(0);
+                    const auto length_squared = dot_product_block(v, v);
+                    const auto nonzero = simd::cmp_gt(length_squared, zero);
+                    const auto scale
+                            = inverse_sqrt<Approximate>(length_squared);
+                    const auto [x, y, z] = v;
+                    return vector3_block<SimdVector>{
+                            simd::select(nonzero, x * scale, zero),
+                            simd::select(nonzero, y * scale, zero),
+                            simd::select(nonzero, z * scale, zero)};
+                },
+                a.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        const T length = std::sqrt(a[i].dot(a[i]));
+        out[i]         = length > 0 ? a[i] / length : vector3<T>{};
+    }
+}
+
+}  // namespace detail
+
+// a vector3f takes 12 bytes, so arrays of them are only viewed unaligned.
+// out may be one of the inputs, see vector2_batch.h
+
+// out[i] = a[i].dot(b[i])
+template <typename T>
+void dot_product_n(
+        unaligned_view<vector3<T>> a,
+        unaligned_view<vector3<T>> b,
+        unaligned_view<T> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        using SimdVector = detail::vector3_register<T>;
+        detail::vector3_to_scalar_n<SimdVector>(
+                out,
+                n,
+                [](const auto& x, const auto& y) {
+                    return detail::dot_product_block(x, y);
+                },
+                a.template as<T>(),
+                b.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i].dot(b[i]);
+    }
+}
+
+// out[i] = a[i].cross(b[i])
+template <typename T>
+void cross_n(
+        unaligned_view<vector3<T>> a,
+        unaligned_view<vector3<T>> b,
+        unaligned_view<vector3<T>> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        using SimdVector = detail::vector3_register<T>;
+        detail::vector3_to_vector3_n<SimdVector>(
+                out.template as<T>(),
+                n,
+                [](const detail::vector3_block<SimdVector>& x,
+                   const detail::vector3_block<SimdVector>& y) {
+                    const auto [ax, ay, az] = x;
+                    const auto [bx, by, bz] = y;
+                    return detail::vector3_block<SimdVector>{
+                            simd::fmsub(ay, bz, az * by),
+                            simd::fmsub(az, bx, ax * bz),
+                            simd::fmsub(ax, by, ay * bx)};
+                },
+                a.template as<T>(),
+                b.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i].cross(b[i]);
+    }
+}
+
+// out[i] = a[i].dot(a[i])
+template <typename T>
+void length_squared_n(
+        unaligned_view<vector3<T>> a, unaligned_view<T> out, size_t n) {
+    dot_product_n(a, a, out, n);
+}
+
+// out[i] = sqrt(a[i].dot(a[i]))
+template <typename T>
+void length_n(unaligned_view<vector3<T>> a, unaligned_view<T> out, size_t n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "length_n requires floating point components");
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        using SimdVector = detail::vector3_register<T>;
+        detail::vector3_to_scalar_n<SimdVector>(
+                out,
+                n,
+                [](const auto& v) {
+                    return simd::sqrt(detail::dot_product_block(v, v));
+                },
+                a.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = std::sqrt(a[i].dot(a[i]));
+    }
+}
+
+// out[i] = a[i] / length(a[i]); vectors of length zero are written as zero
+template <typename T>
+void normalize_n(
+        unaligned_view<vector3<T>> a,
+        unaligned_view<vector3<T>> out,
+        size_t n) {
+    detail::normalize_n<false>(a, out, n);
+}
+
+template <typename T>
+void normalize_n(
+        unaligned_view<vector3<T>> a,
+        unaligned_view<vector3<T>> out,
+        size_t n,
+        approximate_t) {
+    detail::normalize_n<true>(a, out, n);
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <simd/isa.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace simd::math {
+
+#pragma pack(push, 0)
+template <typename T>
+struct vector4 {
+    T x;
+    T y;
+    T z;
+    T w;
+
+    SIMD_ISA_TAGGED
+    constexpr vector4<T>& operator+=(const vector4<T> rhs) {
+        x += rhs.x;
+        y += rhs.y;
+        z += rhs.z;
+        w += rhs.w;
+        return *this;
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr vector4<T> operator+(const vector4<T> rhs) const {
+        return {.x = x + rhs.x, .y = y + rhs.y, .z = z + rhs.z, .w = w + rhs.w};
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr vector4<T>& operator-=(const vector4<T> rhs) {
+        x -= rhs.x;
+        y -= rhs.y;
+        z -= rhs.z;
+        w -= rhs.w;
+        return *this;
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr vector4<T> operator-(const vector4<T> rhs) const {
+        return {.x = x - rhs.x, .y = y - rhs.y, .z = z - rhs.z, .w = w - rhs.w};
+    }
+
+    template <typename Scalar>
+    SIMD_ISA_TAGGED
+    constexpr vector4<T>& operator*=(Scalar s) {
+        x *= s;
+        y *= s;
+        z *= s;
+        w *= s;
+        return *this;
+    }
+
+    template <typename Scalar>
+    SIMD_ISA_TAGGED
+    constexpr vector4<T>& operator/=(Scalar s) {
+        x /= s;
+        y /= s;
+        z /= s;
+        w /= s;
+        return *this;
+    }
+
+    SIMD_ISA_TAGGED
+    constexpr T dot(const vector4<T> other) const {
+        return x * other.x + y * other.y + z * other.z + w * other.w;
+    }
+};
+#pragma pack(pop)
+
+using vector4i = vector4<int32_t>;
+using vector4f = vector4<float>;
+using vector4l = vector4<int64_t>;
+using vector4d = vector4<double>;
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+template <typename T, typename Scalar>
+constexpr vector4<T> operator*(const vector4<T> vec, Scalar s) {
+    return {.x = T(vec.x * s),
+            .y = T(vec.y * s),
+            .z = T(vec.z * s),
+            .w = T(vec.w * s)};
+}
+
+template <typename T, typename Scalar>
+constexpr vector4<T> operator*(Scalar s, const vector4<T> vec) {
+    return {.x = T(s * vec.x),
+            .y = T(s * vec.y),
+            .z = T(s * vec.z),
+            .w = T(s * vec.w)};
+}
+
+template <typename T, typename Scalar>
+constexpr vector4<T> operator/(const vector4<T> vec, Scalar s) {
+    return {.x = T(vec.x / s),
+            .y = T(vec.y / s),
+            .z = T(vec.z / s),
+            .w = T(vec.w / s)};
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
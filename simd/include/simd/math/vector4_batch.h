@@ -0,0 +1,246 @@
+#pragma once
+
+#include <simd/bit_vector.h>
+#include <simd/math/batch.h>
+#include <simd/math/vector4.h>
+#include <simd/view.h>
+
+#include <cmath>
+#include <type_traits>
+
+namespace simd::math {
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+namespace detail {
+
+#ifdef __AVX2__
+// every register holds whole vector4: two vector4f or one vector4d
+template <typename T>
+using vector4_register = bit_vector<T, 256>;
+
+// the dot products of SimdVector::size consecutive vector4 pairs, given the
+// lane-wise products p0, ..., p3 of their components
+inline f32x8 vector4_dot_products(f32x8 p0, f32x8 p1, f32x8 p2, f32x8 p3) {
+    // [d0, d2, d4, d6, d1, d3, d5, d7]
+    const auto sums = simd::hadd(simd::hadd(p0, p1), simd::hadd(p2, p3));
+    return simd::permutevar(sums, i32x8::from(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+inline f64x4 vector4_dot_products(f64x4 p0, f64x4 p1, f64x4 p2, f64x4 p3) {
+    // [d0, d1, d0, d1] and [d2, d3, d2, d3]
+    const auto lo = simd::hadd(p0, p1);
+    const auto hi = simd::hadd(p2, p3);
+    return simd::select(
+            f64x4::first_n_mask(2),
+            lo + simd::permute4x64(lo, control4<2, 3, 0, 1>()),
+            hi + simd::permute4x64(hi, control4<2, 3, 0, 1>()));
+}
+
+// the sum of the four components of every vector4 in each of its lanes
+inline f32x8 broadcast_sums(f32x8 v) {
+    const auto pairs = v + simd::swap_pairs(v);
+    return pairs + simd::permute4x64(pairs, control4<1, 0, 3, 2>());
+}
+
+inline f64x4 broadcast_sums(f64x4 v) {
+    const auto pairs = v + simd::swap_pairs(v);
+    return pairs + simd::permute4x64(pairs, control4<2, 3, 0, 1>());
+}
+
+// op maps the products of the components of a and b to one value per
+// vector4, written to out
+template <typename SimdVector, typename T, typename Op>
+void dot_product_blocks(
+        unaligned_view<T> a,
+        unaligned_view<T> b,
+        unaligned_view<T> out,
+        size_t n,
+        Op op) {
+    constexpr size_t size = SimdVector::size;
+    const auto products   = [&](size_t k, auto... mask) {
+        return SimdVector::load(a + k, mask...)
+               * SimdVector::load(b + k, mask...);
+    };
+    size_t i = 0;
+    for (; i + size <= n; i += size) {
+        const size_t k = i * 4;
+        op(vector4_dot_products(
+                   products(k),
+                   products(k + size),
+                   products(k + size * 2),
+                   products(k + size * 3)))
+                .store(out + i);
+    }
+    if (i < n) {
+        const size_t k   = i * 4;
+        const auto masks = register_masks<SimdVector, 4>((n - i) * 4);
+        op(vector4_dot_products(
+                   products(k, masks[0]),
+                   products(k + size, masks[1]),
+                   products(k + size * 2, masks[2]),
+                   products(k + size * 3, masks[3])))
+                .store(out + i, SimdVector::first_n_mask(n - i));
+    }
+}
+
+template <bool Approximate, typename SimdVector>
+SimdVector normalize_vector4_block(SimdVector v) {
+    const auto zero           = SimdVector::broadcast(0);
+    const auto length_squared = broadcast_sums(v * v);
+    return simd::select(
+            simd::cmp_gt(length_squared, zero),
+            v * inverse_sqrt<Approximate>(length_squared),
+            zero);
+}
+#endif
+
+template <bool Approximate, typename T>
+void normalize_n(
+        unaligned_view<vector4<T>> a,
+        unaligned_view<vector4<T>> out,
+        size_t n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "normalize_n requires floating point components");
+#ifdef __AVX2__
+    if constexpr (simd_components<T>) {
+        transform_components<vector4_register<T>>(
+                out.template as<T>(),
+                n * 4,
+                [](auto v) { return normalize_vector4_block<Approximate>(v); },
+                a.template as<T>());
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        const T length = std::sqrt(a[i].dot(a[i]));
+        out[i]         = length > 0 ? a[i] / length : vector4<T>{};
+    }
+}
+
+}  // namespace detail
+
+// out may be one of the inputs, see vector2_batch.h
+
+// out[i] = a[i].dot(b[i])
+template <typename T>
+void dot_product_n(
+        unaligned_view<vector4<T>> a,
+        unaligned_view<vector4<T>> b,
+        unaligned_view<T> out,
+        size_t n) {
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        detail::dot_product_blocks<detail::vector4_register<T>>(
+                a.template as<T>(),
+                b.template as<T>(),
+                out,
+                n,
+                [](auto d) { return d; });
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i].dot(b[i]);
+    }
+}
+
+// out[i] = a[i].dot(a[i])
+template <typename T>
+void length_squared_n(
+        unaligned_view<vector4<T>> a, unaligned_view<T> out, size_t n) {
+    dot_product_n(a, a, out, n);
+}
+
+// out[i] = sqrt(a[i].dot(a[i]))
+template <typename T>
+void length_n(unaligned_view<vector4<T>> a, unaligned_view<T> out, size_t n) {
+    static_assert(
+            std::is_floating_point_v<T>,
+            "length_n requires floating point components");
+#ifdef __AVX2__
+    if constexpr (detail::simd_components<T>) {
+        detail::dot_product_blocks<detail::vector4_register<T>>(
+                a.template as<T>(),
+                a.template as<T>(),
+                out,
+                n,
+                [](auto d) { return simd::sqrt(d); });
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = std::sqrt(a[i].dot(a[i]));
+    }
+}
+
+// out[i] = a[i] / length(a[i]); vectors of length zero are written as zero
+template <typename T>
+void normalize_n(
+        unaligned_view<vector4<T>> a,
+        unaligned_view<vector4<T>> out,
+        size_t n) {
+    detail::normalize_n<false>(a, out, n);
+}
+
+template <typename T>
+void normalize_n(
+        unaligned_view<vector4<T>> a,
+        unaligned_view<vector4<T>> out,
+        size_t n,
+        approximate_t) {
+    detail::normalize_n<true>(a, out, n);
+}
+
+template <typename T, size_t Alignment, size_t OutAlignment>
+void dot_product_n(
+        aligned_view<vector4<T>, Alignment> a,
+        aligned_view<vector4<T>, Alignment> b,
+        aligned_view<T, OutAlignment> out,
+        size_t n) {
+    dot_product_n(
+            unaligned_view<vector4<T>>{a.get()},
+            unaligned_view<vector4<T>>{b.get()},
+            unaligned_view<T>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment, size_t OutAlignment>
+void length_squared_n(
+        aligned_view<vector4<T>, Alignment> a,
+        aligned_view<T, OutAlignment> out,
+        size_t n) {
+    length_squared_n(
+            unaligned_view<vector4<T>>{a.get()},
+            unaligned_view<T>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment, size_t OutAlignment>
+void length_n(
+        aligned_view<vector4<T>, Alignment> a,
+        aligned_view<T, OutAlignment> out,
+        size_t n) {
+    length_n(
+            unaligned_view<vector4<T>>{a.get()},
+            unaligned_view<T>{out.get()},
+            n);
+}
+
+template <typename T, size_t Alignment, typename... Mode>
+void normalize_n(
+        aligned_view<vector4<T>, Alignment> a,
+        aligned_view<vector4<T>, Alignment> out,
+        size_t n,
+        Mode... mode) {
+    normalize_n(
+            unaligned_view<vector4<T>>{a.get()},
+            unaligned_view<vector4<T>>{out.get()},
+            n,
+            mode...);
+}
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math
@@ -1,17 +1,356 @@
 #pragma once
 
+#include <simd/view.h>
+
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace simd {
 
+// throws std::bad_alloc when the allocation fails; release with free()
 template <typename T>
 T* aligned_alloc(size_t alignment, size_t size) {
-    T* ptr;
-    [[maybe_unused]] int result
-            = posix_memalign(reinterpret_cast<void**>(&ptr), alignment, size);
-    assert(result == 0);
-    return ptr;
+    // posix_memalign rejects alignments below the size of a pointer
+    alignment = std::max(alignment, sizeof(void*));
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) {
+        throw std::bad_alloc();
+    }
+    return static_cast<T*>(ptr);
+}
+
+// page sizes map_pages can back an allocation with, smallest first
+enum class page_size {
+    standard,
+    // regular pages that the kernel may merge into 2 MiB pages, see
+    // madvise(MADV_HUGEPAGE)
+    transparent,
+    huge_2m,
+    huge_1g,
+};
+
+struct page_options {
+    // the largest page size to try; each smaller one is tried in turn when
+    // the system cannot provide it, down to standard pages
+    page_size pages = page_size::huge_2m;
+    // numa node to place the pages on; -1 leaves placement to the first
+    // thread that touches each page
+    int numa_node = -1;
+};
+
+struct page_allocation {
+    void* data = nullptr;
+    // bytes mapped, rounded up to whole pages
+    size_t size     = 0;
+    page_size pages = page_size::standard;
+    bool numa_bound = false;
+};
+
+// maps zeroed, page aligned memory straight from the kernel. Pages are only
+// backed when first touched, which is what places them on a numa node when
+// options.numa_node is -1. Throws std::bad_alloc when even standard pages
+// cannot be mapped; release with unmap_pages(data, size)
+page_allocation map_pages(size_t size, page_options options = {});
+void unmap_pages(void* data, size_t size);
+
+// the number of numa nodes the system may have, 1 without numa
+int numa_node_count();
+
+// size in bytes of the largest cache, or 0 when the system does not report it
+size_t last_level_cache_size();
+
+// kernels that write at least this many bytes use non-temporal stores by
+// default, so that the output does not evict their inputs from the caches.
+// Defaults to the size of the last level cache
+size_t streaming_threshold();
+void set_streaming_threshold(size_t bytes);
+
+// selects an aligned_buffer whose padding past size() is zeroed
+struct zero_padding_t {};
+inline constexpr zero_padding_t zero_padding{};
+
+// selects an aligned_buffer whose elements and padding are all zeroed
+struct zero_fill_t {};
+inline constexpr zero_fill_t zero_fill{};
+
+// owning, move-only array of n trivial T starting on an Alignment boundary.
+// The allocation is padded to a whole number of Alignment bytes, so a kernel
+// may run full SIMD iterations up to capacity() instead of handling a tail.
+// Elements are left uninitialized unless one of the zeroing tags is passed
+template <typename T, size_t Alignment = 64>
+class aligned_buffer {
+public:
+    static_assert(std::is_trivial_v<T>);
+    static_assert(Alignment >= alignof(T) && Alignment % sizeof(T) == 0);
+
+    static constexpr size_t alignment = Alignment;
+
+    aligned_buffer() = default;
+
+    explicit aligned_buffer(size_t n)
+            : _data(simd::aligned_alloc<T>(Alignment, padded(n) * sizeof(T)))
+            , _size(n) {}
+
+    aligned_buffer(size_t n, zero_padding_t) : aligned_buffer(n) {
+        std::memset(data() + n, 0, (capacity() - n) * sizeof(T));
+    }
+
+    aligned_buffer(size_t n, zero_fill_t) : aligned_buffer(n) {
+        std::memset(data(), 0, capacity() * sizeof(T));
+    }
+
+    // maps the buffer with map_pages; it starts zeroed but untouched, see
+    // first_touch
+    aligned_buffer(size_t n, page_options options)
+            : aligned_buffer(n, map_pages(padded(n) * sizeof(T), options)) {
+        static_assert(Alignment <= 4096, "mapped memory is page aligned");
+    }
+
+    aligned_buffer(aligned_buffer&& other) noexcept
+            : _data(std::move(other._data)), _size(other._size) {
+        other._size = 0;
+    }
+
+    aligned_buffer& operator=(aligned_buffer&& other) noexcept {
+        _data       = std::move(other._data);
+        _size       = other._size;
+        other._size = 0;
+        return *this;
+    }
+
+    size_t size() const { return _size; }
+    // the number of elements the allocation holds, padding included
+    size_t capacity() const { return padded(_size); }
+    bool empty() const { return _size == 0; }
+    // standard unless the buffer was mapped with huge pages
+    page_size pages() const { return _data.get_deleter().pages; }
+
+    T* data() { return _data.get(); }
+    const T* data() const { return _data.get(); }
+
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+
+    T* begin() { return data(); }
+    const T* begin() const { return data(); }
+    T* end() { return data() + _size; }
+    const T* end() const { return data() + _size; }
+
+    aligned_view<T, Alignment> view() { return {data()}; }
+
+    template <size_t ViewAlignment>
+    operator aligned_view<T, ViewAlignment>() {
+        static_assert(
+                ViewAlignment <= Alignment,
+                "invalid conversion to more restrictive alignment");
+        return aligned_view<T, ViewAlignment>{data()};
+    }
+
+    explicit operator unaligned_view<T>() { return {data()}; }
+
+private:
+    struct deleter {
+        // non zero when the memory came from map_pages
+        size_t mapped   = 0;
+        page_size pages = page_size::standard;
+
+        void operator()(T* ptr) const {
+            if (mapped) {
+                unmap_pages(ptr, mapped);
+            } else {
+                free(ptr);
+            }
+        }
+    };
+
+    aligned_buffer(size_t n, const page_allocation& mapping)
+            : _data(static_cast<T*>(mapping.data),
+                    deleter{mapping.size, mapping.pages})
+            , _size(n) {}
+
+    static constexpr size_t padded(size_t n) {
+        constexpr size_t lanes = Alignment / sizeof(T);
+        return (n + lanes - 1) / lanes * lanes;
+    }
+
+    std::unique_ptr<T, deleter> _data;
+    size_t _size = 0;
+};
+
+// std::allocator replacement whose storage starts on an Alignment boundary,
+// e.g. std::vector<float, aligned_allocator<float, 32>>
+template <typename T, size_t Alignment = 64>
+struct aligned_allocator {
+    static_assert(Alignment >= alignof(T));
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() = default;
+
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&) {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return simd::aligned_alloc<T>(Alignment, n * sizeof(T));
+    }
+
+    void deallocate(T* ptr, size_t) { free(ptr); }
+
+    template <typename U>
+    bool operator==(const aligned_allocator<U, Alignment>&) const {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const aligned_allocator<U, Alignment>&) const {
+        return false;
+    }
+};
+
+// zeroes [data, data + n) from `threads` threads, each writing one contiguous
+// slice of whole pages. Under the kernel's first touch policy every page then
+// lives on the numa node of the thread that wrote it, so a computation that
+// later splits the array the same way reads mostly local memory
+template <typename T>
+void first_touch(
+        unaligned_view<T> data,
+        size_t n,
+        size_t threads = std::thread::hardware_concurrency()) {
+    static_assert(std::is_trivial_v<T>);
+    constexpr size_t page_bytes = 4096;
+
+    auto* bytes      = reinterpret_cast<char*>(data.data);
+    const size_t end = n * sizeof(T);
+    threads          = std::max<size_t>(threads, 1);
+    const size_t slice = std::max(
+            page_bytes,
+            (end / threads + page_bytes - 1) / page_bytes * page_bytes);
+
+    std::vector<std::thread> workers;
+    for (size_t begin = 0; begin < end; begin += slice) {
+        const size_t size = std::min(slice, end - begin);
+        workers.emplace_back([=] { std::memset(bytes + begin, 0, size); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// bump allocator for short lived scratch memory. Allocation is a pointer
+// increment, and memory is only returned in bulk through reset() or
+// rewind(). Blocks are kept for reuse, so a steady workload stops calling
+// the system allocator after the first pass. Not thread safe; use one arena
+// per thread, e.g. thread_arena()
+class arena {
+public:
+    static constexpr size_t default_block_size = size_t(1) << 20;
+
+    // the position of the next allocation; rewinding to it releases every
+    // allocation made after it was taken
+    struct mark {
+        size_t block  = 0;
+        size_t offset = 0;
+    };
+
+    explicit arena(size_t block_size = default_block_size)
+            : _block_size(block_size) {}
+
+    arena(arena&&)            = default;
+    arena& operator=(arena&&) = default;
+
+    // n uninitialized elements; the memory stays valid until it is released
+    // by reset() or rewind()
+    template <typename T, size_t Alignment = 64>
+    aligned_view<T, Alignment> allocate(size_t n) {
+        static_assert(std::is_trivial_v<T>);
+        static_assert(Alignment >= alignof(T));
+        return {static_cast<T*>(allocate_bytes(n * sizeof(T), Alignment))};
+    }
+
+    void* allocate_bytes(size_t size, size_t alignment) {
+        assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+        while (true) {
+            if (_block < _blocks.size()) {
+                auto& block     = _blocks[_block];
+                const auto base = reinterpret_cast<uintptr_t>(block.data());
+                const uintptr_t aligned
+                        = (base + _offset + alignment - 1) & ~(alignment - 1);
+                if (aligned + size <= base + block.size()) {
+                    _offset = aligned + size - base;
+                    return reinterpret_cast<void*>(aligned);
+                }
+                // blocks that are too small are skipped until the next reset
+                ++_block;
+                _offset = 0;
+                continue;
+            }
+            _blocks.emplace_back(std::max(_block_size, size + alignment));
+        }
+    }
+
+    mark get_mark() const { return {_block, _offset}; }
+
+    void rewind(mark position) {
+        assert(position.block < _block
+               || (position.block == _block && position.offset <= _offset));
+        _block  = position.block;
+        _offset = position.offset;
+    }
+
+    // releases every allocation but keeps the blocks
+    void reset() { rewind({}); }
+
+    // releases every allocation and returns the blocks to the system
+    void release() {
+        _blocks.clear();
+        reset();
+    }
+
+    size_t block_count() const { return _blocks.size(); }
+
+private:
+    size_t _block_size;
+    std::vector<aligned_buffer<std::byte, 64>> _blocks;
+    size_t _block  = 0;
+    size_t _offset = 0;
+};
+
+// rewinds an arena to where it was when the scope was entered
+class arena_scope {
+public:
+    explicit arena_scope(arena& a) : _arena(a), _mark(a.get_mark()) {}
+    ~arena_scope() { _arena.rewind(_mark); }
+
+    arena_scope(const arena_scope&) = delete;
+    arena_scope& operator=(const arena_scope&) = delete;
+
+private:
+    arena& _arena;
+    arena::mark _mark;
+};
+
+// the calling thread's arena; no locking is needed since no other thread
+// can reach it
+inline arena& thread_arena() {
+    thread_local arena instance;
+    return instance;
 }
 
 }  // namespace simd
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace simd {
+
+// persistent worker threads for data parallel loops. Each parallel_for deals
+// its chunks out evenly to the participating threads; a thread that runs out
+// steals the last chunks of another, so uneven chunk costs still balance
+class thread_pool {
+public:
+    // `concurrency` counts the calling thread, so concurrency - 1 workers are
+    // started
+    explicit thread_pool(
+            size_t concurrency = std::thread::hardware_concurrency());
+    ~thread_pool();
+
+    thread_pool(const thread_pool&)            = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    size_t concurrency() const;
+
+    // calls body(begin, end) for disjoint ranges covering [0, n) whose
+    // boundaries are multiples of grain, and returns once all have run. The
+    // calling thread takes part; concurrent callers take turns, and calls
+    // made from inside a body run serially. body must not throw
+    template <typename Body>
+    void parallel_for(size_t n, size_t grain, Body&& body) {
+        using BodyType    = std::remove_reference_t<Body>;
+        BodyType* context = &body;
+        run(n,
+            grain,
+            [](void* erased, size_t begin, size_t end) {
+                (*static_cast<BodyType*>(erased))(begin, end);
+            },
+            const_cast<void*>(static_cast<const void*>(context)));
+    }
+
+private:
+    using chunk_function = void (*)(void*, size_t, size_t);
+
+    void run(size_t n, size_t grain, chunk_function function, void* context);
+
+    struct state;
+    std::unique_ptr<state> _state;
+};
+
+// shared pool sized to the hardware, started on first use
+thread_pool& default_thread_pool();
+
+}  // namespace simd
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace simd {
@@ -171,4 +174,89 @@ unaligned_view<T> as_unaligned_view(T* ptr) {
     return {ptr};
 }
 
+// elements `stride` bytes apart, e.g. one member of every record in an array
+// of structs
+template <typename T>
+struct strided_view {
+    T* data;
+    size_t stride;
+
+    using value_type = T;
+
+    T& operator[](size_t i) const {
+        return *reinterpret_cast<T*>(
+                reinterpret_cast<std::uintptr_t>(data) + i * stride);
+    }
+
+    strided_view<T> operator+(long long int n) const {
+        return {&(*this)[n], stride};
+    }
+};
+
+template <typename T>
+strided_view<T> as_strided_view(T* ptr, size_t stride = sizeof(T)) {
+    return {ptr, stride};
+}
+
+// the `member` of every record, e.g. as_strided_view(entities, &entity::pos)
+template <typename Record, typename T>
+strided_view<T> as_strided_view(Record* records, T Record::*member) {
+    return {&(records->*member), sizeof(Record)};
+}
+
+// the elements data[indices[0]], data[indices[1]], ...
+template <typename T>
+struct indexed_view {
+    T* data;
+    const int32_t* indices;
+
+    using value_type = T;
+
+    T& operator[](size_t i) const { return data[indices[i]]; }
+
+    indexed_view<T> operator+(long long int n) const {
+        return {data, indices + n};
+    }
+};
+
+template <typename T>
+indexed_view<T> as_indexed_view(T* data, const int32_t* indices) {
+    return {data, indices};
+}
+
+// which caches a prefetched line is brought into, as in _mm_prefetch: t0
+// fills every level, t1 and t2 stop at the second and third, and nta
+// minimizes cache pollution for data that is read once
+enum class prefetch_hint { nta, t2, t1, t0 };
+
+// asks for the line holding view[distance] to be loaded ahead of its use.
+// Prefetches never fault, so distance may point past the end of the data.
+// Only contiguous views are taken: finding the element of an indexed view
+// would read its index list, which may end before distance
+template <prefetch_hint Hint = prefetch_hint::t0, typename T>
+void prefetch(unaligned_view<T> view, long long distance) {
+    __builtin_prefetch(view.data + distance, 0, static_cast<int>(Hint));
+}
+
+template <prefetch_hint Hint = prefetch_hint::t0, typename T, size_t Alignment>
+void prefetch(aligned_view<T, Alignment> view, long long distance) {
+    prefetch<Hint>(unaligned_view<T>{view.data}, distance);
+}
+
+inline std::atomic<size_t>& prefetch_distance_setting() {
+    // constant initialized, so reading it needs no guard
+    static std::atomic<size_t> elements{0};
+    return elements;
+}
+
+// how many elements ahead of the current position the streaming kernels
+// prefetch their inputs; 0, the default, leaves it to the hardware prefetcher
+inline size_t prefetch_distance() {
+    return prefetch_distance_setting().load(std::memory_order_relaxed);
+}
+
+inline void set_prefetch_distance(size_t elements) {
+    prefetch_distance_setting().store(elements, std::memory_order_relaxed);
+}
+
 }  // namespace simd
@@ -0,0 +1,117 @@
+#include <simd/dispatch.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace simd {
+
+namespace {
+
+#if defined(__x86_64__) || defined(__i386__)
+struct cpuid_registers {
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+};
+
+cpuid_registers cpuid(unsigned leaf, unsigned subleaf) {
+    cpuid_registers r;
+    // leaves above the maximum supported one leave every register zeroed
+    __get_cpuid_count(leaf, subleaf, &r.eax, &r.ebx, &r.ecx, &r.edx);
+    return r;
+}
+
+// extended control register 0: which register states the os saves on
+// context switches
+uint64_t xgetbv0() {
+    unsigned lo, hi;
+    __asm__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return static_cast<uint64_t>(hi) << 32 | lo;
+}
+
+isa query_cpu() {
+    const auto leaf1 = cpuid(1, 0);
+    const auto leaf7 = cpuid(7, 0);
+
+    const uint64_t xcr0 = (leaf1.ecx & bit_OSXSAVE) ? xgetbv0() : 0;
+    // xmm | ymm, plus opmask | zmm_hi256 | hi16_zmm for avx-512
+    const bool ymm_enabled = (xcr0 & 0x06) == 0x06;
+    const bool zmm_enabled = (xcr0 & 0xe6) == 0xe6;
+
+    const bool avx2 = ymm_enabled && (leaf1.ecx & bit_AVX)
+                      && (leaf1.ecx & bit_FMA) && (leaf7.ebx & bit_AVX2);
+    if (avx2 && zmm_enabled && (leaf7.ebx & bit_AVX512F)) {
+        return isa::avx512;
+    }
+    if (avx2) {
+        return isa::avx2;
+    }
+    if (leaf1.ecx & bit_SSE4_2) {
+        return isa::sse4_2;
+    }
+    return isa::generic;
+}
+#else
+isa query_cpu() {
+    return isa::generic;
+}
+#endif
+
+isa initial_isa() {
+    if (const char* name = std::getenv("SIMD_ISA")) {
+        if (auto requested = parse_isa(name)) {
+            return std::min(*requested, detect_isa());
+        }
+    }
+    return detect_isa();
+}
+
+std::atomic<isa>& active() {
+    static std::atomic<isa> value{initial_isa()};
+    return value;
+}
+
+}  // namespace
+
+isa detect_isa() {
+    static const isa detected = query_cpu();
+    return detected;
+}
+
+isa active_isa() {
+    return active().load(std::memory_order_relaxed);
+}
+
+isa force_isa(isa target) {
+    const isa selected = std::min(target, detect_isa());
+    active().store(selected, std::memory_order_relaxed);
+    return selected;
+}
+
+const char* isa_name(isa value) {
+    switch (value) {
+        case isa::generic: return "generic";
+        case isa::sse4_2: return "sse4.2";
+        case isa::avx2: return "avx2";
+        case isa::avx512: return "avx512";
+    }
+    return "unknown";
+}
+
+std::optional<isa> parse_isa(std::string_view name) {
+    for (isa value : {isa::generic, isa::sse4_2, isa::avx2, isa::avx512}) {
+        if (name == isa_name(value)) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace simd
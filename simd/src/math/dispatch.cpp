@@ -0,0 +1,38 @@
+#include <simd/dispatch.h>
+#include <simd/math/dispatch.h>
+
+#include "dot_product_kernels.h"
+
+namespace simd::math::dispatch {
+
+namespace {
+
+const detail::dot_product_kernels& dot_product_kernels() {
+    switch (active_isa()) {
+        case isa::avx512: return detail::dot_product_avx512;
+        case isa::avx2: return detail::dot_product_avx2;
+        case isa::sse4_2: return detail::dot_product_sse4_2;
+        case isa::generic: break;
+    }
+    return detail::dot_product_generic;
+}
+
+}  // namespace
+
+void dot_product_n(
+        unaligned_view<vector2f> a,
+        unaligned_view<vector2f> b,
+        unaligned_view<float> out,
+        size_t n) {
+    dot_product_kernels().f32(a, b, out, n);
+}
+
+void dot_product_n(
+        unaligned_view<vector2d> a,
+        unaligned_view<vector2d> b,
+        unaligned_view<double> out,
+        size_t n) {
+    dot_product_kernels().f64(a, b, out, n);
+}
+
+}  // namespace simd::math::dispatch
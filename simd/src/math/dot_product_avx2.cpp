@@ -0,0 +1,11 @@
+#include "dot_product_kernels.h"
+
+#if !defined(__AVX2__) || !defined(__FMA__) || defined(__AVX512F__)
+#error "dot_product_avx2.cpp must be compiled with -mavx2 -mfma only"
+#endif
+
+namespace simd::math::dispatch::detail {
+
+const dot_product_kernels dot_product_avx2 = native_dot_product_kernels;
+
+}  // namespace simd::math::dispatch::detail
@@ -0,0 +1,11 @@
+#include "dot_product_kernels.h"
+
+#if !defined(__AVX512F__) || !defined(__AVX2__) || !defined(__FMA__)
+#error "dot_product_avx512.cpp must be compiled with -mavx512f -mavx2 -mfma"
+#endif
+
+namespace simd::math::dispatch::detail {
+
+const dot_product_kernels dot_product_avx512 = native_dot_product_kernels;
+
+}  // namespace simd::math::dispatch::detail
@@ -0,0 +1,11 @@
+#include "dot_product_kernels.h"
+
+#if defined(__SSE4_2__) || defined(__AVX__)
+#error "dot_product_generic.cpp must be compiled for baseline x86-64"
+#endif
+
+namespace simd::math::dispatch::detail {
+
+const dot_product_kernels dot_product_generic = native_dot_product_kernels;
+
+}  // namespace simd::math::dispatch::detail
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <simd/math/dot_product.h>
+
+namespace simd::math::dispatch::detail {
+
+struct dot_product_kernels {
+    void (*f32)(
+            unaligned_view<vector2f>,
+            unaligned_view<vector2f>,
+            unaligned_view<float>,
+            size_t);
+    void (*f64)(
+            unaligned_view<vector2d>,
+            unaligned_view<vector2d>,
+            unaligned_view<double>,
+            size_t);
+};
+
+// one table per isa, each defined in a translation unit built with the
+// matching flags
+extern const dot_product_kernels dot_product_generic;
+extern const dot_product_kernels dot_product_sse4_2;
+extern const dot_product_kernels dot_product_avx2;
+extern const dot_product_kernels dot_product_avx512;
+
+inline namespace SIMD_ISA_NAMESPACE {
+
+template <typename T>
+void dot_product_n_entry(
+        unaligned_view<vector2<T>> a,
+        unaligned_view<vector2<T>> b,
+        unaligned_view<T> out,
+        size_t n) {
+    simd::math::dot_product_n(a, b, out, n);
+}
+
+// the kernels of the isa this translation unit is compiled for
+inline constexpr dot_product_kernels native_dot_product_kernels{
+        &dot_product_n_entry<float>,
+        &dot_product_n_entry<double>,
+};
+
+}  // namespace SIMD_ISA_NAMESPACE
+
+}  // namespace simd::math::dispatch::detail
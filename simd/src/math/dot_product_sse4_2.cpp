@@ -0,0 +1,11 @@
+#include "dot_product_kernels.h"
+
+#if !defined(__SSE4_2__) || defined(__AVX__)
+#error "dot_product_sse4_2.cpp must be compiled with -msse4.2 only"
+#endif
+
+namespace simd::math::dispatch::detail {
+
+const dot_product_kernels dot_product_sse4_2 = native_dot_product_kernels;
+
+}  // namespace simd::math::dispatch::detail
@@ -0,0 +1,179 @@
+#include <simd/memory.h>
+
+#include <atomic>
+#include <fstream>
+#include <string>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(MAP_HUGETLB) && !defined(MAP_HUGE_SHIFT)
+#define MAP_HUGE_SHIFT 26
+#endif
+
+namespace simd {
+
+namespace {
+
+constexpr size_t huge_2m_bytes = size_t(1) << 21;
+constexpr size_t huge_1g_bytes = size_t(1) << 30;
+
+constexpr size_t round_up(size_t size, size_t granularity) {
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+void* map_anonymous(size_t size, int extra_flags) {
+    void* ptr = mmap(
+            nullptr,
+            size,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | extra_flags,
+            -1,
+            0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+#ifdef MAP_HUGETLB
+// explicit huge pages come from the pool reserved through
+// /proc/sys/vm/nr_hugepages and fail when it is empty
+void* map_hugetlb(size_t mapped, int log2_page_bytes) {
+    return map_anonymous(
+            mapped, MAP_HUGETLB | (log2_page_bytes << MAP_HUGE_SHIFT));
+}
+#endif
+
+// maps a 2 MiB aligned range so that transparent huge pages can back all of
+// it, trimming the over-allocation used to find the aligned start
+void* map_transparent(size_t size) {
+    const size_t reserved = size + huge_2m_bytes;
+
+    auto* base = static_cast<char*>(map_anonymous(reserved, 0));
+    if (!base) {
+        return nullptr;
+    }
+    const auto address = reinterpret_cast<uintptr_t>(base);
+    auto* start        = reinterpret_cast<char*>(
+            round_up(address, huge_2m_bytes));
+    if (start != base) {
+        munmap(base, start - base);
+    }
+    if (start + size != base + reserved) {
+        munmap(start + size, base + reserved - (start + size));
+    }
+    return start;
+}
+
+bool bind_to_node(void* data, size_t size, int node) {
+#ifdef SYS_mbind
+    constexpr int mpol_preferred = 1;
+    constexpr size_t bits        = sizeof(unsigned long) * 8;
+    if (node < 0 || size_t(node) >= bits) {
+        return false;
+    }
+    const unsigned long mask = 1ul << node;
+    // the kernel reads one bit less than maxnode
+    return syscall(SYS_mbind, data, size, mpol_preferred, &mask, bits + 1, 0)
+           == 0;
+#else
+    (void)data;
+    (void)size;
+    (void)node;
+    return false;
+#endif
+}
+
+std::atomic<size_t>& streaming_threshold_bytes() {
+    // 32 MiB when the cache size is unknown
+    static std::atomic<size_t> value{
+            last_level_cache_size() ? last_level_cache_size()
+                                    : size_t(32) << 20};
+    return value;
+}
+
+}  // namespace
+
+page_allocation map_pages(size_t size, page_options options) {
+    page_allocation result;
+    size = std::max<size_t>(size, 1);
+
+#ifdef MAP_HUGETLB
+    if (options.pages == page_size::huge_1g) {
+        const size_t mapped = round_up(size, huge_1g_bytes);
+        if (void* data = map_hugetlb(mapped, 30)) {
+            result = {data, mapped, page_size::huge_1g};
+        }
+    }
+    if (!result.data && options.pages >= page_size::huge_2m) {
+        const size_t mapped = round_up(size, huge_2m_bytes);
+        if (void* data = map_hugetlb(mapped, 21)) {
+            result = {data, mapped, page_size::huge_2m};
+        }
+    }
+#endif
+    if (!result.data && options.pages >= page_size::transparent) {
+        const size_t mapped = round_up(size, huge_2m_bytes);
+        if (void* data = map_transparent(mapped)) {
+            result = {data, mapped, page_size::standard};
+#ifdef MADV_HUGEPAGE
+            // only fails when transparent huge pages are disabled
+            if (madvise(data, mapped, MADV_HUGEPAGE) == 0) {
+                result.pages = page_size::transparent;
+            }
+#endif
+        }
+    }
+    if (!result.data) {
+        const size_t mapped = round_up(size, size_t(sysconf(_SC_PAGESIZE)));
+        if (void* data = map_anonymous(mapped, 0)) {
+            result = {data, mapped, page_size::standard};
+        }
+    }
+    if (!result.data) {
+        throw std::bad_alloc();
+    }
+
+    // must happen before the first touch faults the pages in
+    if (options.numa_node >= 0) {
+        result.numa_bound
+                = bind_to_node(result.data, result.size, options.numa_node);
+    }
+    return result;
+}
+
+void unmap_pages(void* data, size_t size) {
+    munmap(data, size);
+}
+
+int numa_node_count() {
+    // e.g. "0-3", or "0" on machines without numa
+    std::ifstream possible{"/sys/devices/system/node/possible"};
+    std::string nodes;
+    if (!(possible >> nodes)) {
+        return 1;
+    }
+    const auto dash = nodes.find_last_of("-,");
+    return std::stoi(nodes.substr(dash == std::string::npos ? 0 : dash + 1))
+           + 1;
+}
+
+size_t last_level_cache_size() {
+    long size = 0;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (size <= 0) {
+        size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+    return size > 0 ? size_t(size) : 0;
+}
+
+size_t streaming_threshold() {
+    return streaming_threshold_bytes().load(std::memory_order_relaxed);
+}
+
+void set_streaming_threshold(size_t bytes) {
+    streaming_threshold_bytes().store(bytes, std::memory_order_relaxed);
+}
+
+}  // namespace simd
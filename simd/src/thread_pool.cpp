@@ -0,0 +1,169 @@
+#include <simd/thread_pool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace simd {
+
+namespace {
+
+// set while a thread runs chunks of a job, whose nested parallel_for calls
+// would otherwise wait for themselves
+thread_local bool inside_job = false;
+
+}  // namespace
+
+struct thread_pool::state {
+    // the chunks one thread owns: the owner takes them from the front and
+    // thieves from the back. A job only ever removes chunks, so once every
+    // queue is empty the job has been handed out completely
+    struct alignas(64) queue {
+        std::mutex mutex;
+        size_t front = 0;
+        size_t back  = 0;
+    };
+
+    explicit state(size_t concurrency)
+            : participants(concurrency), queues(new queue[concurrency]) {}
+
+    bool pop(size_t self, size_t& chunk) {
+        auto& own = queues[self];
+        std::lock_guard lock{own.mutex};
+        if (own.front == own.back) {
+            return false;
+        }
+        chunk = own.front++;
+        return true;
+    }
+
+    bool steal(size_t self, size_t& chunk) {
+        for (size_t k = 1; k < participants; ++k) {
+            auto& victim = queues[(self + k) % participants];
+            std::lock_guard lock{victim.mutex};
+            if (victim.front != victim.back) {
+                chunk = --victim.back;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void participate(size_t self) {
+        size_t chunk;
+        while (pop(self, chunk) || steal(self, chunk)) {
+            const size_t begin = chunk * grain;
+            function(context, begin, std::min(n, begin + grain));
+        }
+    }
+
+    void work(size_t self) {
+        inside_job    = true;
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock lock{mutex};
+                wake.wait(lock, [&] { return stop || generation != seen; });
+                if (stop) {
+                    return;
+                }
+                seen = generation;
+            }
+            participate(self);
+            {
+                std::lock_guard lock{mutex};
+                if (--busy == 0) {
+                    done.notify_one();
+                }
+            }
+        }
+    }
+
+    const size_t participants;
+    std::unique_ptr<queue[]> queues;
+    std::vector<std::thread> workers;
+
+    // serializes parallel_for calls from different threads
+    std::mutex submit;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    uint64_t generation = 0;
+    size_t busy         = 0;
+    bool stop           = false;
+
+    // the running job; written only while every worker is idle
+    size_t n                = 0;
+    size_t grain            = 0;
+    chunk_function function = nullptr;
+    void* context           = nullptr;
+};
+
+thread_pool::thread_pool(size_t concurrency)
+        : _state(std::make_unique<state>(std::max<size_t>(concurrency, 1))) {
+    for (size_t i = 1; i < _state->participants; ++i) {
+        _state->workers.emplace_back([this, i] { _state->work(i); });
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        std::lock_guard lock{_state->mutex};
+        _state->stop = true;
+    }
+    _state->wake.notify_all();
+    for (auto& worker : _state->workers) {
+        worker.join();
+    }
+}
+
+size_t thread_pool::concurrency() const {
+    return _state->participants;
+}
+
+void thread_pool::run(
+        size_t n, size_t grain, chunk_function function, void* context) {
+    grain               = std::max<size_t>(grain, 1);
+    const size_t chunks = (n + grain - 1) / grain;
+    if (chunks <= 1 || _state->participants == 1 || inside_job) {
+        if (n > 0) {
+            function(context, 0, n);
+        }
+        return;
+    }
+
+    std::lock_guard submit_lock{_state->submit};
+    auto& s    = *_state;
+    s.n        = n;
+    s.grain    = grain;
+    s.function = function;
+    s.context  = context;
+    for (size_t i = 0; i < s.participants; ++i) {
+        s.queues[i].front = chunks * i / s.participants;
+        s.queues[i].back  = chunks * (i + 1) / s.participants;
+    }
+    {
+        std::lock_guard lock{s.mutex};
+        s.busy = s.workers.size();
+        ++s.generation;
+    }
+    s.wake.notify_all();
+
+    inside_job = true;
+    s.participate(0);
+    inside_job = false;
+
+    // chunks stolen by a worker may still be running
+    std::unique_lock lock{s.mutex};
+    s.done.wait(lock, [&] { return s.busy == 0; });
+}
+
+thread_pool& default_thread_pool() {
+    static thread_pool pool;
+    return pool;
+}
+
+}  // namespace simd
@@ -2,8 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <numeric>
+#include <vector>
 
 TEST(i32x4, from) {
     int32_t expected[4] = {0, 1, 2, 3};
@@ -100,6 +104,42 @@ TEST(f32x8, load_store_unaligned) {
     test_32_load_store_unaligned<float, simd::f32x8>();
 }
 
+template <typename SourceT, typename T>
+void test_32_masked_load_store() {
+    SourceT input[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    for (size_t n = 0; n <= T::size; ++n) {
+        SourceT loaded[T::size];
+        T::load(simd::as_unaligned_view(input), T::first_n_mask(n))
+                .store(simd::as_unaligned_view(loaded));
+
+        SourceT stored[T::size] = {};
+        T::load(simd::as_unaligned_view(input))
+                .store(simd::as_unaligned_view(stored), T::first_n_mask(n));
+
+        for (size_t i = 0; i < T::size; ++i) {
+            EXPECT_EQ(i < n ? input[i] : 0, loaded[i]);
+            EXPECT_EQ(i < n ? input[i] : 0, stored[i]);
+        }
+    }
+}
+
+TEST(i32x4, masked_load_store) {
+    test_32_masked_load_store<int32_t, simd::i32x4>();
+}
+
+TEST(i32x8, masked_load_store) {
+    test_32_masked_load_store<int32_t, simd::i32x8>();
+}
+
+TEST(f32x4, masked_load_store) {
+    test_32_masked_load_store<float, simd::f32x4>();
+}
+
+TEST(f32x8, masked_load_store) {
+    test_32_masked_load_store<float, simd::f32x8>();
+}
+
 template <typename T>
 void test_f32_multiply() {
     float input[]    = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
@@ -189,3 +229,1094 @@ TEST(i32x8, permute4x64) {
 TEST(f32x8, permute4x64) {
     test_permute4x64<simd::f32x8>();
 }
+
+TEST(f64x2, from) {
+    double expected[2] = {0.0, 1.0};
+    double actual[2];
+    simd::f64x2::from(0.0, 1.0).store(simd::as_unaligned_view(actual));
+    EXPECT_TRUE(std::equal(expected, expected + 2, actual));
+}
+
+TEST(f64x4, from) {
+    double expected[4] = {0.0, 1.0, 2.0, 3.0};
+    double actual[4];
+    simd::f64x4::from(0.0, 1.0, 2.0, 3.0)
+            .store(simd::as_unaligned_view(actual));
+    EXPECT_TRUE(std::equal(expected, expected + 4, actual));
+}
+
+TEST(f64x2, load_store_aligned) {
+    test_32_load_store_aligned<double, simd::f64x2>();
+}
+
+TEST(f64x4, load_store_aligned) {
+    test_32_load_store_aligned<double, simd::f64x4>();
+}
+
+TEST(f64x2, load_store_unaligned) {
+    test_32_load_store_unaligned<double, simd::f64x2>();
+}
+
+TEST(f64x4, load_store_unaligned) {
+    test_32_load_store_unaligned<double, simd::f64x4>();
+}
+
+TEST(f64x2, masked_load_store) {
+    test_32_masked_load_store<double, simd::f64x2>();
+}
+
+TEST(f64x4, masked_load_store) {
+    test_32_masked_load_store<double, simd::f64x4>();
+}
+
+template <typename T>
+void test_f64_multiply() {
+    double input[]    = {0.0, 1.0, 2.0, 3.0};
+    double expected[] = {0.0, 1.0, 4.0, 9.0};
+    double actual[T::size];
+
+    auto v = T::load(simd::as_unaligned_view(input));
+    (v * v).store(simd::as_unaligned_view(actual));
+
+    EXPECT_TRUE(std::equal(expected, expected + T::size, actual));
+}
+
+TEST(f64x2, multiply) {
+    test_f64_multiply<simd::f64x2>();
+}
+
+TEST(f64x4, multiply) {
+    test_f64_multiply<simd::f64x4>();
+}
+
+template <typename T>
+void test_f64_equality() {
+    double a[] = {0.0, 1.0, 2.0, 3.0};
+    double b[] = {-0.0, 1.0, 2.0, 3.0};  // -0.0 == 0.0
+    double c[] = {0.0, 1.0, 2.0, 4.0};
+
+    auto v1 = T::load(simd::as_unaligned_view(a));
+    auto v2 = v1;
+    auto v3 = T::load(simd::as_unaligned_view(b));
+    auto v4 = T::load(simd::as_unaligned_view(c + 4 - T::size));
+
+    EXPECT_EQ(v1, v2);
+    EXPECT_EQ(v1, v3);
+    EXPECT_FALSE(v1 == v4);
+}
+
+TEST(f64x2, equality) {
+    test_f64_equality<simd::f64x2>();
+}
+
+TEST(f64x4, equality) {
+    test_f64_equality<simd::f64x4>();
+}
+
+TEST(f64x2, hadd) {
+    auto actual = simd::hadd(simd::f64x2::from(0, 1), simd::f64x2::from(2, 3));
+    EXPECT_EQ(simd::f64x2::from(1, 5), actual);
+}
+
+TEST(f64x4, hadd) {
+    auto actual = simd::hadd(
+            simd::f64x4::from(0, 1, 2, 3), simd::f64x4::from(4, 5, 6, 7));
+    EXPECT_EQ(simd::f64x4::from(1, 9, 5, 13), actual);
+}
+
+TEST(f64x4, permute4x64) {
+    auto a        = simd::f64x4::from(0, 1, 2, 3);
+    auto expected = simd::f64x4::from(0, 2, 3, 1);
+
+    auto actual = simd::permute4x64(a, simd::control4<0, 2, 3, 1>());
+
+    EXPECT_EQ(expected, actual);
+}
+
+template <typename T>
+void test_i32_multiply() {
+    int32_t input[]    = {0, -1, 2, 3, 4, 5, 6, 0x10000};
+    int32_t expected[] = {0, 1, 4, 9, 16, 25, 36, 0};  // 2^32 wraps to 0
+    int32_t actual[T::size];
+
+    auto v = T::load(simd::as_unaligned_view(input + 8 - T::size));
+    (v * v).store(simd::as_unaligned_view(actual));
+
+    EXPECT_TRUE(std::equal(expected + 8 - T::size, expected + 8, actual));
+}
+
+TEST(i32x4, multiply) {
+    test_i32_multiply<simd::i32x4>();
+}
+
+TEST(i32x8, multiply) {
+    test_i32_multiply<simd::i32x8>();
+}
+
+TEST(i64x4, load_store) {
+    alignas(32) int64_t expected[] = {-1, 0, INT64_MAX, INT64_MIN, 7};
+    alignas(32) int64_t actual[5]  = {};
+
+    simd::i64x4::load(simd::as_aligned_view<32>(expected))
+            .store(simd::as_aligned_view<32>(actual));
+    EXPECT_TRUE(std::equal(expected, expected + 4, actual));
+
+    simd::i64x4::load(simd::as_unaligned_view(expected + 1))
+            .store(simd::as_unaligned_view(actual + 1));
+    EXPECT_TRUE(std::equal(expected, expected + 5, actual));
+}
+
+TEST(i64x4, masked_load_store) {
+    test_32_masked_load_store<int64_t, simd::i64x4>();
+}
+
+TEST(i64x4, add) {
+    auto actual = simd::i64x4::from(1, -2, INT64_MAX, 4)
+                  + simd::i64x4::from(1, 2, 1, 1LL << 40);
+    EXPECT_EQ(simd::i64x4::from(2, 0, INT64_MIN, 4 + (1LL << 40)), actual);
+}
+
+TEST(i32x8, mul_wide) {
+    auto a = simd::i32x8::from(INT32_MIN, 9, -3, 9, INT32_MAX, 9, 5, 9);
+    auto b = simd::i32x8::from(INT32_MIN, 9, 4, 9, INT32_MAX, 9, 6, 9);
+
+    auto expected = simd::i64x4::from(
+            int64_t{INT32_MIN} * INT32_MIN,
+            -12,
+            int64_t{INT32_MAX} * INT32_MAX,
+            30);
+    EXPECT_EQ(expected, simd::mul_wide(a, b));
+}
+
+TEST(i32x8, shuffle) {
+    auto a        = simd::i32x8::from(0, 1, 2, 3, 4, 5, 6, 7);
+    auto expected = simd::i32x8::from(1, 0, 3, 2, 5, 4, 7, 6);
+
+    EXPECT_EQ(expected, simd::shuffle(a, simd::control4<1, 0, 3, 2>()));
+}
+
+TEST(i64x4, pack_saturate) {
+    auto lo = simd::i64x4::from(0, -1, INT64_MAX, INT64_MIN);
+    auto hi = simd::i64x4::from(
+            INT32_MAX,
+            INT32_MIN,
+            int64_t{INT32_MAX} + 1,
+            int64_t{INT32_MIN} - 1);
+
+    auto expected = simd::i32x8::from(
+            0,
+            -1,
+            INT32_MAX,
+            INT32_MIN,
+            INT32_MAX,
+            INT32_MIN,
+            INT32_MAX,
+            INT32_MIN);
+    EXPECT_EQ(expected, simd::pack_saturate(lo, hi));
+}
+
+// applies op lane by lane to the first T::size entries of the inputs and
+// compares against the vectorized version
+template <typename SourceT, typename T, typename ScalarOp, typename VectorOp>
+void test_lanewise(ScalarOp scalar_op, VectorOp vector_op) {
+    SourceT a[] = {0, 1, -2, 3, -4, 5, 100, -7};
+    SourceT b[] = {-3, 2, 2, -9, -4, 1, 7, 6};
+    SourceT c[] = {1, -1, 2, -2, 3, -3, 4, -4};
+
+    SourceT expected[T::size];
+    SourceT actual[T::size];
+    for (size_t i = 0; i < T::size; ++i) {
+        expected[i] = scalar_op(a[i], b[i], c[i]);
+    }
+    vector_op(
+            T::load(simd::as_unaligned_view(a)),
+            T::load(simd::as_unaligned_view(b)),
+            T::load(simd::as_unaligned_view(c)))
+            .store(simd::as_unaligned_view(actual));
+
+    EXPECT_TRUE(std::equal(expected, expected + T::size, actual));
+}
+
+template <typename SourceT, typename T>
+void test_arithmetic() {
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto) { return a + b; },
+            [](auto a, auto b, auto) { return a + b; });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto) { return a - b; },
+            [](auto a, auto b, auto) { return a - b; });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto, auto) { return -a; },
+            [](auto a, auto, auto) { return -a; });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto) { return std::min(a, b); },
+            [](auto a, auto b, auto) { return simd::min(a, b); });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto) { return std::max(a, b); },
+            [](auto a, auto b, auto) { return simd::max(a, b); });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto, auto) { return a < 0 ? -a : a; },
+            [](auto a, auto, auto) { return simd::abs(a); });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto c) { return a * b + c; },
+            [](auto a, auto b, auto c) { return simd::fmadd(a, b, c); });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto c) { return a * b - c; },
+            [](auto a, auto b, auto c) { return simd::fmsub(a, b, c); });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto c) { return c - a * b; },
+            [](auto a, auto b, auto c) { return simd::fnmadd(a, b, c); });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto c) {
+                auto v = a;
+                v += b;
+                v -= c;
+                return v;
+            },
+            [](auto a, auto b, auto c) {
+                auto v = a;
+                v += b;
+                v -= c;
+                return v;
+            });
+}
+
+TEST(i32x4, arithmetic) {
+    test_arithmetic<int32_t, simd::i32x4>();
+}
+
+TEST(i32x8, arithmetic) {
+    test_arithmetic<int32_t, simd::i32x8>();
+}
+
+TEST(f32x4, arithmetic) {
+    test_arithmetic<float, simd::f32x4>();
+}
+
+TEST(f32x8, arithmetic) {
+    test_arithmetic<float, simd::f32x8>();
+}
+
+TEST(f64x2, arithmetic) {
+    test_arithmetic<double, simd::f64x2>();
+}
+
+TEST(f64x4, arithmetic) {
+    test_arithmetic<double, simd::f64x4>();
+}
+
+template <typename SourceT, typename T>
+void test_bitwise() {
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto) { return a & b; },
+            [](auto a, auto b, auto) { return a & b; });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto) { return a | b; },
+            [](auto a, auto b, auto) { return a | b; });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto) { return a ^ b; },
+            [](auto a, auto b, auto) { return a ^ b; });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto) { return ~a & b; },
+            [](auto a, auto b, auto) { return simd::andnot(a, b); });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto, auto) { return a * 8; },
+            [](auto a, auto, auto) { return a << 3; });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto, auto) { return a >> 1; },
+            [](auto a, auto, auto) { return a >> 1; });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto, auto c) { return a * (1 << (c < 0 ? -c : c)); },
+            [](auto a, auto, auto c) { return a << simd::abs(c); });
+    test_lanewise<SourceT, T>(
+            [](auto a, auto, auto c) { return a >> (c < 0 ? -c : c); },
+            [](auto a, auto, auto c) { return a >> simd::abs(c); });
+}
+
+TEST(i32x4, bitwise) {
+    test_bitwise<int32_t, simd::i32x4>();
+}
+
+TEST(i32x8, bitwise) {
+    test_bitwise<int32_t, simd::i32x8>();
+}
+
+template <typename SourceT, typename T>
+void test_float_ops() {
+    test_lanewise<SourceT, T>(
+            [](auto a, auto b, auto) { return a / b; },
+            [](auto a, auto b, auto) { return a / b; });
+
+    // negation flips the sign of zero and abs clears it again
+    SourceT zero[T::size] = {};
+    SourceT actual[T::size];
+
+    auto negative_zero = -T::load(simd::as_unaligned_view(zero));
+    negative_zero.store(simd::as_unaligned_view(actual));
+    EXPECT_TRUE(std::signbit(actual[0]));
+
+    simd::abs(negative_zero).store(simd::as_unaligned_view(actual));
+    EXPECT_FALSE(std::signbit(actual[0]));
+
+    // andnot with the sign mask also clears it
+    simd::andnot(negative_zero, negative_zero)
+            .store(simd::as_unaligned_view(actual));
+    EXPECT_FALSE(std::signbit(actual[0]));
+}
+
+TEST(f32x4, float_ops) {
+    test_float_ops<float, simd::f32x4>();
+}
+
+TEST(f32x8, float_ops) {
+    test_float_ops<float, simd::f32x8>();
+}
+
+TEST(f64x2, float_ops) {
+    test_float_ops<double, simd::f64x2>();
+}
+
+TEST(f64x4, float_ops) {
+    test_float_ops<double, simd::f64x4>();
+}
+
+template <typename SourceT, typename T>
+void test_compare() {
+    SourceT a[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    SourceT b[] = {1, 1, 1, 1, 5, 5, 5, 5};
+    const auto v1 = T::load(simd::as_unaligned_view(a));
+    const auto v2 = T::load(simd::as_unaligned_view(b));
+
+    int lt = 0, le = 0, gt = 0, ge = 0, eq = 0, ne = 0;
+    for (size_t i = 0; i < T::size; ++i) {
+        lt |= (a[i] < b[i]) << i;
+        le |= (a[i] <= b[i]) << i;
+        gt |= (a[i] > b[i]) << i;
+        ge |= (a[i] >= b[i]) << i;
+        eq |= (a[i] == b[i]) << i;
+        ne |= (a[i] != b[i]) << i;
+    }
+
+    EXPECT_EQ(lt, simd::movemask(simd::cmp_lt(v1, v2)));
+    EXPECT_EQ(le, simd::movemask(simd::cmp_le(v1, v2)));
+    EXPECT_EQ(gt, simd::movemask(simd::cmp_gt(v1, v2)));
+    EXPECT_EQ(ge, simd::movemask(simd::cmp_ge(v1, v2)));
+    EXPECT_EQ(eq, simd::movemask(simd::cmp_eq(v1, v2)));
+    EXPECT_EQ(ne, simd::movemask(simd::cmp_ne(v1, v2)));
+}
+
+TEST(i32x4, compare) {
+    test_compare<int32_t, simd::i32x4>();
+}
+
+TEST(i32x8, compare) {
+    test_compare<int32_t, simd::i32x8>();
+}
+
+TEST(f32x4, compare) {
+    test_compare<float, simd::f32x4>();
+}
+
+TEST(f32x8, compare) {
+    test_compare<float, simd::f32x8>();
+}
+
+TEST(f64x2, compare) {
+    test_compare<double, simd::f64x2>();
+}
+
+TEST(f64x4, compare) {
+    test_compare<double, simd::f64x4>();
+}
+
+TEST(f32x8, compare_nan) {
+    const auto nan = simd::f32x8::from(NAN, 0, NAN, 0, NAN, 0, NAN, 0);
+    const auto one = simd::f32x8::from(1, 1, 1, 1, 1, 1, 1, 1);
+
+    EXPECT_EQ(0xaa, simd::movemask(simd::cmp_lt(nan, one)));
+    EXPECT_EQ(0x00, simd::movemask(simd::cmp_gt(nan, one)));
+    EXPECT_EQ(0xaa, simd::movemask(simd::cmp_eq(nan, nan)));
+    EXPECT_EQ(0x55, simd::movemask(simd::cmp_ne(nan, nan)));
+}
+
+template <typename SourceT, typename T>
+void test_select() {
+    SourceT a[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    SourceT b[] = {10, 11, 12, 13, 14, 15, 16, 17};
+    SourceT actual[T::size];
+
+    const auto v1 = T::load(simd::as_unaligned_view(a));
+    const auto v2 = T::load(simd::as_unaligned_view(b));
+    simd::select(T::first_n_mask(T::size / 2), v1, v2)
+            .store(simd::as_unaligned_view(actual));
+
+    for (size_t i = 0; i < T::size; ++i) {
+        EXPECT_EQ(i < T::size / 2 ? a[i] : b[i], actual[i]);
+    }
+}
+
+TEST(i32x4, select) {
+    test_select<int32_t, simd::i32x4>();
+}
+
+TEST(i32x8, select) {
+    test_select<int32_t, simd::i32x8>();
+}
+
+TEST(i64x4, select) {
+    test_select<int64_t, simd::i64x4>();
+}
+
+TEST(f32x4, select) {
+    test_select<float, simd::f32x4>();
+}
+
+TEST(f32x8, select) {
+    test_select<float, simd::f32x8>();
+}
+
+TEST(f64x2, select) {
+    test_select<double, simd::f64x2>();
+}
+
+TEST(f64x4, select) {
+    test_select<double, simd::f64x4>();
+}
+
+template <typename T>
+void test_mask_queries() {
+    using mask = typename T::mask_type;
+    for (size_t n = 0; n <= T::size; ++n) {
+        const auto m = T::first_n_mask(n);
+        EXPECT_EQ((1 << n) - 1, simd::movemask(m));
+        EXPECT_EQ(static_cast<int>(n), simd::popcount(m));
+        EXPECT_EQ(n > 0, simd::any(m));
+        EXPECT_EQ(n == T::size, simd::all(m));
+        EXPECT_EQ(n == 0, simd::none(m));
+        EXPECT_EQ(static_cast<int>(T::size - n), simd::popcount(~m));
+    }
+
+    const mask low  = T::first_n_mask(1);
+    const mask most = T::first_n_mask(T::size - 1);
+    EXPECT_EQ(low, low & most);
+    EXPECT_EQ(most, low | most);
+    EXPECT_EQ(static_cast<int>(T::size - 2), simd::popcount(low ^ most));
+}
+
+TEST(i32x4, mask_queries) {
+    test_mask_queries<simd::i32x4>();
+}
+
+TEST(i32x8, mask_queries) {
+    test_mask_queries<simd::i32x8>();
+}
+
+TEST(i64x4, mask_queries) {
+    test_mask_queries<simd::i64x4>();
+}
+
+TEST(f32x4, mask_queries) {
+    test_mask_queries<simd::f32x4>();
+}
+
+TEST(f32x8, mask_queries) {
+    test_mask_queries<simd::f32x8>();
+}
+
+TEST(f64x2, mask_queries) {
+    test_mask_queries<simd::f64x2>();
+}
+
+TEST(f64x4, mask_queries) {
+    test_mask_queries<simd::f64x4>();
+}
+
+template <typename SourceT, typename T>
+void test_interleave() {
+    SourceT packed[T::size * 2];
+    std::iota(packed, packed + T::size * 2, 0);
+
+    auto [even, odd] = simd::deinterleave(
+            T::load(simd::as_unaligned_view(packed)),
+            T::load(simd::as_unaligned_view(packed + T::size)));
+    SourceT even_lanes[T::size], odd_lanes[T::size];
+    even.store(simd::as_unaligned_view(even_lanes));
+    odd.store(simd::as_unaligned_view(odd_lanes));
+    for (size_t i = 0; i < T::size; ++i) {
+        EXPECT_EQ(SourceT(i * 2), even_lanes[i]);
+        EXPECT_EQ(SourceT(i * 2 + 1), odd_lanes[i]);
+    }
+
+    auto [lo, hi] = simd::interleave(even, odd);
+    SourceT repacked[T::size * 2];
+    lo.store(simd::as_unaligned_view(repacked));
+    hi.store(simd::as_unaligned_view(repacked + T::size));
+    EXPECT_TRUE(std::equal(packed, packed + T::size * 2, repacked));
+}
+
+TEST(f32x8, interleave) {
+    test_interleave<float, simd::f32x8>();
+}
+
+TEST(f64x4, interleave) {
+    test_interleave<double, simd::f64x4>();
+}
+
+template <typename SourceT, typename T>
+void test_stream() {
+    alignas(T::width_bytes) SourceT lanes[T::size];
+    alignas(T::width_bytes) SourceT streamed[T::size];
+    std::iota(lanes, lanes + T::size, 1);
+
+    T::load(simd::as_unaligned_view(lanes))
+            .stream(simd::as_aligned_view<T::width_bytes>(streamed));
+    simd::stream_fence();
+    EXPECT_TRUE(std::equal(lanes, lanes + T::size, streamed));
+}
+
+TEST(bit_vector, stream) {
+    test_stream<float, simd::f32x4>();
+    test_stream<float, simd::f32x8>();
+    test_stream<double, simd::f64x2>();
+    test_stream<double, simd::f64x4>();
+    test_stream<int32_t, simd::i32x4>();
+    test_stream<int32_t, simd::i32x8>();
+}
+
+TEST(bit_vector, gather) {
+    float floats[32];
+    double doubles[32];
+    std::iota(floats, floats + 32, 0.f);
+    std::iota(doubles, doubles + 32, 0.0);
+
+    const auto indices = simd::i32x8::from(31, 0, 7, 7, 2, 16, 30, 1);
+    float expected[8]  = {31, 0, 7, 7, 2, 16, 30, 1};
+    float lanes[8];
+    simd::f32x8::gather(simd::as_unaligned_view(floats), indices)
+            .store(simd::as_unaligned_view(lanes));
+    EXPECT_TRUE(std::equal(expected, expected + 8, lanes));
+
+    // byte offsets, with the last five lanes masked off
+    simd::f32x8::gather<1>(
+            simd::as_unaligned_view(floats),
+            indices + indices + indices + indices,
+            simd::f32x8::first_n_mask(3))
+            .store(simd::as_unaligned_view(lanes));
+    std::fill(expected + 3, expected + 8, 0.f);
+    EXPECT_TRUE(std::equal(expected, expected + 8, lanes));
+
+    double double_lanes[4];
+    simd::f64x4::gather(
+            simd::as_unaligned_view(doubles),
+            simd::i32x4::from(5, 31, 0, 4))
+            .store(simd::as_unaligned_view(double_lanes));
+    EXPECT_EQ(5.0, double_lanes[0]);
+    EXPECT_EQ(31.0, double_lanes[1]);
+    EXPECT_EQ(0.0, double_lanes[2]);
+    EXPECT_EQ(4.0, double_lanes[3]);
+}
+
+template <typename SourceT, typename T>
+void test_sqrt() {
+    SourceT lanes[T::size], roots[T::size], estimates[T::size];
+    for (size_t i = 0; i < T::size; ++i) {
+        lanes[i] = SourceT(i * i + 1);
+    }
+    const auto v = T::load(simd::as_unaligned_view(lanes));
+    simd::sqrt(v).store(simd::as_unaligned_view(roots));
+    for (size_t i = 0; i < T::size; ++i) {
+        EXPECT_EQ(std::sqrt(lanes[i]), roots[i]);
+    }
+    if constexpr (std::is_same_v<SourceT, float>) {
+        simd::rsqrt(v).store(simd::as_unaligned_view(estimates));
+        for (size_t i = 0; i < T::size; ++i) {
+            EXPECT_NEAR(1 / roots[i], estimates[i], 1.5f / 4096 / roots[i]);
+        }
+    }
+}
+
+TEST(bit_vector, sqrt) {
+    test_sqrt<float, simd::f32x4>();
+    test_sqrt<float, simd::f32x8>();
+    test_sqrt<double, simd::f64x2>();
+    test_sqrt<double, simd::f64x4>();
+}
+
+TEST(bit_vector, swap_pairs) {
+    float floats[8];
+    simd::swap_pairs(simd::f32x8::from(0, 1, 2, 3, 4, 5, 6, 7))
+            .store(simd::as_unaligned_view(floats));
+    const float expected_floats[8] = {1, 0, 3, 2, 5, 4, 7, 6};
+    EXPECT_TRUE(std::equal(floats, floats + 8, expected_floats));
+
+    double doubles[4];
+    simd::swap_pairs(simd::f64x4::from(0, 1, 2, 3))
+            .store(simd::as_unaligned_view(doubles));
+    const double expected_doubles[4] = {1, 0, 3, 2};
+    EXPECT_TRUE(std::equal(doubles, doubles + 4, expected_doubles));
+}
+
+TEST(bit_vector, duplicate_even_odd) {
+    float floats[8];
+    const auto v = simd::f32x8::from(0, 1, 2, 3, 4, 5, 6, 7);
+    simd::duplicate_even(v).store(simd::as_unaligned_view(floats));
+    const float expected_even[8] = {0, 0, 2, 2, 4, 4, 6, 6};
+    EXPECT_TRUE(std::equal(floats, floats + 8, expected_even));
+    simd::duplicate_odd(v).store(simd::as_unaligned_view(floats));
+    const float expected_odd[8] = {1, 1, 3, 3, 5, 5, 7, 7};
+    EXPECT_TRUE(std::equal(floats, floats + 8, expected_odd));
+
+    double doubles[4];
+    const auto w = simd::f64x4::from(0, 1, 2, 3);
+    simd::duplicate_even(w).store(simd::as_unaligned_view(doubles));
+    EXPECT_TRUE(std::equal(doubles, doubles + 4, std::begin({0., 0., 2., 2.})));
+    simd::duplicate_odd(w).store(simd::as_unaligned_view(doubles));
+    EXPECT_TRUE(std::equal(doubles, doubles + 4, std::begin({1., 1., 3., 3.})));
+}
+
+TEST(bit_vector, deinterleave3) {
+    double in[12];
+    std::iota(in, in + 12, 0);
+    const auto [a, b, c] = simd::deinterleave3(
+            simd::f64x4::load(simd::as_unaligned_view(in)),
+            simd::f64x4::load(simd::as_unaligned_view(in + 4)),
+            simd::f64x4::load(simd::as_unaligned_view(in + 8)));
+    double out[4];
+    a.store(simd::as_unaligned_view(out));
+    EXPECT_TRUE(std::equal(out, out + 4, std::begin({0., 3., 6., 9.})));
+    b.store(simd::as_unaligned_view(out));
+    EXPECT_TRUE(std::equal(out, out + 4, std::begin({1., 4., 7., 10.})));
+    c.store(simd::as_unaligned_view(out));
+    EXPECT_TRUE(std::equal(out, out + 4, std::begin({2., 5., 8., 11.})));
+}
+
+TEST(bit_vector, deinterleave3_f32x8) {
+    float in[24];
+    std::iota(in, in + 24, 0);
+    const auto [a, b, c] = simd::deinterleave3(
+            simd::f32x8::load(simd::as_unaligned_view(in)),
+            simd::f32x8::load(simd::as_unaligned_view(in + 8)),
+            simd::f32x8::load(simd::as_unaligned_view(in + 16)));
+    const simd::f32x8 components[] = {a, b, c};
+    for (int component = 0; component < 3; ++component) {
+        float out[8];
+        components[component].store(simd::as_unaligned_view(out));
+        for (int i = 0; i < 8; ++i) {
+            EXPECT_EQ(float(i * 3 + component), out[i]);
+        }
+    }
+}
+
+TEST(bit_vector, interleave3) {
+    float floats[24];
+    std::iota(floats, floats + 24, 0);
+    const auto [a, b, c] = simd::deinterleave3(
+            simd::f32x8::load(simd::as_unaligned_view(floats)),
+            simd::f32x8::load(simd::as_unaligned_view(floats + 8)),
+            simd::f32x8::load(simd::as_unaligned_view(floats + 16)));
+    const auto [v0, v1, v2] = simd::interleave3(a, b, c);
+    float float_out[24];
+    v0.store(simd::as_unaligned_view(float_out));
+    v1.store(simd::as_unaligned_view(float_out + 8));
+    v2.store(simd::as_unaligned_view(float_out + 16));
+    EXPECT_TRUE(std::equal(floats, floats + 24, float_out));
+
+    double doubles[12];
+    std::iota(doubles, doubles + 12, 0);
+    const auto [x, y, z] = simd::interleave3(
+            simd::f64x4::from(0, 3, 6, 9),
+            simd::f64x4::from(1, 4, 7, 10),
+            simd::f64x4::from(2, 5, 8, 11));
+    double double_out[12];
+    x.store(simd::as_unaligned_view(double_out));
+    y.store(simd::as_unaligned_view(double_out + 4));
+    z.store(simd::as_unaligned_view(double_out + 8));
+    EXPECT_TRUE(std::equal(doubles, doubles + 12, double_out));
+}
+
+TEST(bit_vector, permutevar) {
+    float out[8];
+    simd::permutevar(
+            simd::f32x8::from(0, 1, 2, 3, 4, 5, 6, 7),
+            simd::i32x8::from(7, 0, 6, 1, 5, 2, 4, 3))
+            .store(simd::as_unaligned_view(out));
+    const float expected[8] = {7, 0, 6, 1, 5, 2, 4, 3};
+    EXPECT_TRUE(std::equal(out, out + 8, expected));
+}
+
+TEST(bit_vector, broadcast_lanes) {
+    float in[4] = {1, 2, 3, 4};
+    float out[8];
+    const auto v = simd::f32x8::broadcast_lanes(simd::as_unaligned_view(in));
+    v.store(simd::as_unaligned_view(out));
+    const float expected[8] = {1, 2, 3, 4, 1, 2, 3, 4};
+    EXPECT_TRUE(std::equal(out, out + 8, expected));
+
+    simd::shuffle(v, simd::control4<3, 3, 0, 1>())
+            .store(simd::as_unaligned_view(out));
+    const float shuffled[8] = {4, 4, 1, 2, 4, 4, 1, 2};
+    EXPECT_TRUE(std::equal(out, out + 8, shuffled));
+}
+
+TEST(bit_vector, transpose4x4) {
+    float floats[16];
+    std::iota(floats, floats + 16, 0);
+    const auto [lo, hi] = simd::transpose4x4(
+            simd::f32x8::load(simd::as_unaligned_view(floats)),
+            simd::f32x8::load(simd::as_unaligned_view(floats + 8)));
+    float float_out[16];
+    lo.store(simd::as_unaligned_view(float_out));
+    hi.store(simd::as_unaligned_view(float_out + 8));
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            EXPECT_EQ(floats[row * 4 + column], float_out[column * 4 + row]);
+        }
+    }
+
+    double doubles[16];
+    std::iota(doubles, doubles + 16, 0);
+    const auto rows = simd::transpose4x4(
+            simd::f64x4::load(simd::as_unaligned_view(doubles)),
+            simd::f64x4::load(simd::as_unaligned_view(doubles + 4)),
+            simd::f64x4::load(simd::as_unaligned_view(doubles + 8)),
+            simd::f64x4::load(simd::as_unaligned_view(doubles + 12)));
+    double double_out[16];
+    std::get<0>(rows).store(simd::as_unaligned_view(double_out));
+    std::get<1>(rows).store(simd::as_unaligned_view(double_out + 4));
+    std::get<2>(rows).store(simd::as_unaligned_view(double_out + 8));
+    std::get<3>(rows).store(simd::as_unaligned_view(double_out + 12));
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            EXPECT_EQ(doubles[row * 4 + column], double_out[column * 4 + row]);
+        }
+    }
+}
+
+TEST(bit_vector, convert) {
+    int32_t ints[8];
+    simd::round_to_int(
+            simd::f32x8::from(0.5f, 1.5f, -2.5f, -0.7f, 3.2f, 1e10f, -1e10f, 7))
+            .store(simd::as_unaligned_view(ints));
+    const int32_t expected_ints[8] = {0, 2, -2, -1, 3, INT32_MIN, INT32_MIN, 7};
+    EXPECT_TRUE(std::equal(ints, ints + 8, expected_ints));
+
+    simd::round_to_int(simd::f32x4::from(2.5f, -3.5f, 0.49f, -0.f))
+            .store(simd::as_unaligned_view(ints));
+    EXPECT_TRUE(std::equal(ints, ints + 4, std::begin({2, -4, 0, 0})));
+
+    float floats[8];
+    simd::to_float(simd::i32x8::from(0, 1, -1, 16777217, INT32_MIN, 5, 6, 7))
+            .store(simd::as_unaligned_view(floats));
+    const float expected_floats[8]
+            = {0.f, 1.f, -1.f, 16777216.f, -2147483648.f, 5.f, 6.f, 7.f};
+    EXPECT_TRUE(std::equal(floats, floats + 8, expected_floats));
+
+    simd::to_float(simd::i32x4::from(-7, 0, 3, 1 << 30))
+            .store(simd::as_unaligned_view(floats));
+    EXPECT_TRUE(std::equal(
+            floats, floats + 4, std::begin({-7.f, 0.f, 3.f, 1073741824.f})));
+}
+
+template <typename SourceT, typename T>
+void test_compress_store(unsigned bits) {
+    SourceT lanes[T::size], flags[T::size];
+    std::vector<SourceT> expected;
+    for (size_t i = 0; i < T::size; ++i) {
+        lanes[i] = SourceT(i + 1);
+        flags[i] = SourceT((bits >> i) & 1);
+        if (flags[i]) {
+            expected.push_back(lanes[i]);
+        }
+    }
+    const auto mask = simd::cmp_gt(
+            T::load(simd::as_unaligned_view(flags)), T::broadcast(0));
+
+    SourceT out[T::size + 1];
+    std::fill(out, out + T::size + 1, SourceT(-1));
+    EXPECT_EQ(
+            expected.size(),
+            simd::compress_store(
+                    mask,
+                    T::load(simd::as_unaligned_view(lanes)),
+                    simd::as_unaligned_view(out)));
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), out));
+    // nothing past the kept lanes is written
+    EXPECT_TRUE(std::all_of(
+            out + expected.size(), out + T::size + 1, [](SourceT x) {
+                return x == SourceT(-1);
+            }));
+}
+
+TEST(bit_vector, compress_store) {
+    for (unsigned bits = 0; bits < 256; ++bits) {
+        test_compress_store<float, simd::f32x8>(bits);
+        test_compress_store<int32_t, simd::i32x8>(bits);
+        test_compress_store<double, simd::f64x4>(bits & 0xf);
+    }
+}
+
+// compresses int32_t indices by a float comparison
+template <typename Floats, typename Indices>
+void test_mask_conversion() {
+    float values[Floats::size];
+    int32_t lanes[Indices::size];
+    for (size_t i = 0; i < Floats::size; ++i) {
+        values[i] = i % 3 == 0 ? -1.f : 1.f;
+        lanes[i]  = static_cast<int32_t>(i);
+    }
+    const auto negative = simd::cmp_lt(
+            Floats::load(simd::as_unaligned_view(values)),
+            Floats::broadcast(0.f));
+    int32_t out[Indices::size];
+    const size_t n = simd::compress_store(
+            typename Indices::mask_type(negative),
+            Indices::load(simd::as_unaligned_view(lanes)),
+            simd::as_unaligned_view(out));
+    ASSERT_EQ((Floats::size + 2) / 3, n);
+    for (size_t k = 0; k < n; ++k) {
+        EXPECT_EQ(int32_t(k * 3), out[k]);
+    }
+}
+
+TEST(bit_vector, mask_conversion) {
+    test_mask_conversion<simd::f32x8, simd::i32x8>();
+#ifdef __AVX512F__
+    test_mask_conversion<simd::f32x16, simd::i32x16>();
+#endif
+}
+
+template <typename SourceT, typename T>
+void test_reduce() {
+    // every rotation moves the extremes to a different lane
+    for (size_t rotation = 0; rotation < T::size; ++rotation) {
+        SourceT values[T::size], factors[T::size];
+        for (size_t i = 0; i < T::size; ++i) {
+            const int j = (i + rotation) % T::size;
+            values[i]   = SourceT(j * 3 - int(T::size));
+            factors[i]  = SourceT(j % 3 == 0 ? -1 : j % 3);
+        }
+        const auto v = T::load(simd::as_unaligned_view(values));
+        const auto f = T::load(simd::as_unaligned_view(factors));
+
+        EXPECT_EQ(
+                std::accumulate(values, values + T::size, SourceT(0)),
+                simd::reduce_add(v));
+        EXPECT_EQ(
+                std::accumulate(
+                        factors,
+                        factors + T::size,
+                        SourceT(1),
+                        std::multiplies<>()),
+                simd::reduce_mul(f));
+        EXPECT_EQ(
+                *std::min_element(values, values + T::size),
+                simd::reduce_min(v));
+        EXPECT_EQ(
+                *std::max_element(values, values + T::size),
+                simd::reduce_max(v));
+    }
+}
+
+template <typename T>
+void test_reduce_bitwise() {
+    int32_t ones[T::size], holes[T::size];
+    int32_t expected_or = 0, expected_and = ~0;
+    for (size_t i = 0; i < T::size; ++i) {
+        ones[i]  = 1 << (i * 2);
+        holes[i] = ~(1 << (i + 3));
+        expected_or |= ones[i];
+        expected_and &= holes[i];
+    }
+    EXPECT_EQ(
+            expected_or,
+            simd::reduce_or(T::load(simd::as_unaligned_view(ones))));
+    EXPECT_EQ(
+            expected_and,
+            simd::reduce_and(T::load(simd::as_unaligned_view(holes))));
+}
+
+TEST(i32x4, reduce) {
+    test_reduce<int32_t, simd::i32x4>();
+    test_reduce_bitwise<simd::i32x4>();
+}
+
+TEST(i32x8, reduce) {
+    test_reduce<int32_t, simd::i32x8>();
+    test_reduce_bitwise<simd::i32x8>();
+}
+
+TEST(f32x4, reduce) {
+    test_reduce<float, simd::f32x4>();
+}
+
+TEST(f32x8, reduce) {
+    test_reduce<float, simd::f32x8>();
+}
+
+#ifdef __AVX512F__
+
+template <typename SourceT, typename T>
+void test_512_load_store() {
+    alignas(64) SourceT expected[17];
+    alignas(64) SourceT actual[17] = {};
+    std::iota(expected, expected + 17, 0);
+
+    T::load(simd::as_aligned_view<64>(expected))
+            .store(simd::as_aligned_view<64>(actual));
+    EXPECT_TRUE(std::equal(expected, expected + 16, actual));
+
+    T::load(simd::as_unaligned_view(expected + 1))
+            .store(simd::as_unaligned_view(actual + 1));
+    EXPECT_TRUE(std::equal(expected, expected + 17, actual));
+
+    for (size_t n = 0; n <= T::size; ++n) {
+        SourceT loaded[16];
+        T::load(simd::as_unaligned_view(expected + 1), T::first_n_mask(n))
+                .store(simd::as_unaligned_view(loaded));
+
+        SourceT stored[16] = {};
+        T::load(simd::as_unaligned_view(expected + 1))
+                .store(simd::as_unaligned_view(stored), T::first_n_mask(n));
+
+        for (size_t i = 0; i < T::size; ++i) {
+            EXPECT_EQ(i < n ? expected[i + 1] : 0, loaded[i]);
+            EXPECT_EQ(i < n ? expected[i + 1] : 0, stored[i]);
+        }
+    }
+}
+
+TEST(i32x16, load_store) {
+    test_512_load_store<int32_t, simd::i32x16>();
+}
+
+TEST(f32x16, load_store) {
+    test_512_load_store<float, simd::f32x16>();
+}
+
+template <typename SourceT, typename T>
+void test_512_arithmetic() {
+    SourceT a[16], b[16], c[16];
+    for (int i = 0; i < 16; ++i) {
+        a[i] = i - 8;
+        b[i] = 3 - i;
+        c[i] = i % 3;
+    }
+    const auto va = T::load(simd::as_unaligned_view(a));
+    const auto vb = T::load(simd::as_unaligned_view(b));
+    const auto vc = T::load(simd::as_unaligned_view(c));
+
+    SourceT sum[16], product[16], fma[16], lo[16], hi[16], magnitude[16];
+    (va + vb).store(simd::as_unaligned_view(sum));
+    (va * vb).store(simd::as_unaligned_view(product));
+    simd::fmadd(va, vb, vc).store(simd::as_unaligned_view(fma));
+    simd::min(va, vb).store(simd::as_unaligned_view(lo));
+    simd::max(va, vb).store(simd::as_unaligned_view(hi));
+    simd::abs(-va).store(simd::as_unaligned_view(magnitude));
+
+    for (size_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(a[i] + b[i], sum[i]);
+        EXPECT_EQ(a[i] * b[i], product[i]);
+        EXPECT_EQ(a[i] * b[i] + c[i], fma[i]);
+        EXPECT_EQ(std::min(a[i], b[i]), lo[i]);
+        EXPECT_EQ(std::max(a[i], b[i]), hi[i]);
+        EXPECT_EQ(a[i] < 0 ? -a[i] : a[i], magnitude[i]);
+    }
+
+    const auto less = simd::cmp_lt(va, vb);
+    int expected_mask = 0;
+    for (size_t i = 0; i < 16; ++i) {
+        expected_mask |= (a[i] < b[i]) << i;
+    }
+    EXPECT_EQ(expected_mask, simd::movemask(less));
+    EXPECT_EQ(simd::popcount(less), __builtin_popcount(expected_mask));
+    EXPECT_TRUE(simd::any(less));
+    EXPECT_FALSE(simd::all(less));
+    EXPECT_TRUE(simd::none(less & ~less));
+
+    SourceT selected[16];
+    simd::select(less, va, vb).store(simd::as_unaligned_view(selected));
+    EXPECT_TRUE(std::equal(lo, lo + 16, selected));
+}
+
+TEST(i32x16, arithmetic) {
+    test_512_arithmetic<int32_t, simd::i32x16>();
+}
+
+TEST(f32x16, arithmetic) {
+    test_512_arithmetic<float, simd::f32x16>();
+}
+
+TEST(i32x16, reduce) {
+    test_reduce<int32_t, simd::i32x16>();
+    test_reduce_bitwise<simd::i32x16>();
+}
+
+TEST(f32x16, reduce) {
+    test_reduce<float, simd::f32x16>();
+}
+
+TEST(f32x16, sqrt) {
+    test_sqrt<float, simd::f32x16>();
+}
+
+TEST(f32x16, duplicate_even_odd) {
+    float in[16];
+    float out[16];
+    std::iota(in, in + 16, 0);
+    const auto v = simd::f32x16::load(simd::as_unaligned_view(in));
+    simd::duplicate_even(v).store(simd::as_unaligned_view(out));
+    for (size_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(in[i & ~size_t(1)], out[i]);
+    }
+    simd::duplicate_odd(v).store(simd::as_unaligned_view(out));
+    for (size_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(in[i | 1], out[i]);
+    }
+}
+
+TEST(f32x16, broadcast_lanes) {
+    float in[4] = {1, 2, 3, 4};
+    float out[16];
+    const auto v = simd::f32x16::broadcast_lanes(simd::as_unaligned_view(in));
+    simd::shuffle(v, simd::control4<3, 3, 0, 1>())
+            .store(simd::as_unaligned_view(out));
+    const float shuffled[4] = {4, 4, 1, 2};
+    for (size_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(shuffled[i % 4], out[i]);
+    }
+}
+
+TEST(f32x16, transpose4x4) {
+    float in[16];
+    float out[16];
+    std::iota(in, in + 16, 0);
+    simd::transpose4x4(simd::f32x16::load(simd::as_unaligned_view(in)))
+            .store(simd::as_unaligned_view(out));
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            EXPECT_EQ(in[row * 4 + column], out[column * 4 + row]);
+        }
+    }
+}
+
+TEST(bit_vector, compress_store_512) {
+    for (unsigned bits = 0; bits < 0x10000; bits += 257) {
+        test_compress_store<float, simd::f32x16>(bits);
+        test_compress_store<int32_t, simd::i32x16>(bits ^ 0x8001);
+    }
+}
+
+TEST(f32x16, permutex2var) {
+    auto a   = simd::f32x16::from(
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    auto b   = simd::f32x16::from(
+            16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+    auto idx = simd::i32x16::from(
+            31, 0, 30, 1, 29, 2, 28, 3, 27, 4, 26, 5, 25, 6, 24, 7);
+
+    auto expected = simd::f32x16::from(
+            31, 0, 30, 1, 29, 2, 28, 3, 27, 4, 26, 5, 25, 6, 24, 7);
+    EXPECT_EQ(expected, simd::permutex2var(a, idx, b));
+}
+
+#endif
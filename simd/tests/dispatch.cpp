@@ -0,0 +1,72 @@
+#include <simd/dispatch.h>
+#include <simd/math/dispatch.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+constexpr simd::isa all_isas[] = {
+        simd::isa::generic,
+        simd::isa::sse4_2,
+        simd::isa::avx2,
+        simd::isa::avx512,
+};
+
+// restores the detected isa so that test order does not matter
+class dispatch_fixture : public ::testing::Test {
+public:
+    void TearDown() { simd::force_isa(simd::detect_isa()); }
+};
+
+template <typename T>
+void test_dot_product_n() {
+    for (size_t n = 0; n <= 70; ++n) {
+        // one extra element so that every view is shifted off its alignment
+        std::vector<simd::math::vector2<T>> a(n + 1), b(n + 1);
+        std::vector<T> out(n + 1), expected(n + 1);
+        for (size_t i = 0; i <= n; ++i) {
+            a[i] = {T(i), T(1) - T(i)};
+            b[i] = {T(n) - T(i), T(i) / T(2)};
+            expected[i] = a[i].dot(b[i]);
+        }
+
+        simd::math::dispatch::dot_product_n(
+                simd::as_unaligned_view(a.data() + 1),
+                simd::as_unaligned_view(b.data() + 1),
+                simd::as_unaligned_view(out.data() + 1),
+                n);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_NEAR(expected[i], out[i], 0.0001)
+                    << simd::isa_name(simd::active_isa()) << " n=" << n;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(isa, names) {
+    for (auto value : all_isas) {
+        EXPECT_EQ(value, simd::parse_isa(simd::isa_name(value)));
+    }
+    EXPECT_FALSE(simd::parse_isa("sse9"));
+}
+
+TEST_F(dispatch_fixture, force_isa) {
+    for (auto value : all_isas) {
+        const auto selected = simd::force_isa(value);
+        EXPECT_EQ(selected, std::min(value, simd::detect_isa()));
+        EXPECT_EQ(selected, simd::active_isa());
+    }
+}
+
+TEST_F(dispatch_fixture, dot_product_n) {
+    for (auto value : all_isas) {
+        if (simd::force_isa(value) != value) {
+            continue;
+        }
+        test_dot_product_n<float>();
+        test_dot_product_n<double>();
+    }
+}
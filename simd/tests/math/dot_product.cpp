@@ -4,42 +4,34 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <numeric>
 #include <random>
+#include <vector>
 
 using namespace simd::math;
 
-class dot_product_fixture : public ::testing::Test {
+template <typename T>
+class dot_product_fixture_base : public ::testing::Test {
 public:
-    vector2f* a     = nullptr;
-    vector2f* b     = nullptr;
-    float* result   = nullptr;
-    float* expected = nullptr;
-
-    void TearDown() { free_vectors(); }
-
-    void free_vectors() {
-        free(a);
-        free(b);
-        free(result);
-        free(expected);
-        a        = nullptr;
-        b        = nullptr;
-        result   = nullptr;
-        expected = nullptr;
-    }
-
-    void allocate_vectors() {
-        a        = simd::aligned_alloc<vector2f>(32, sizeof(vector2f) * _size);
-        b        = simd::aligned_alloc<vector2f>(32, sizeof(vector2f) * _size);
-        result   = simd::aligned_alloc<float>(32, sizeof(float) * _size);
-        expected = simd::aligned_alloc<float>(32, sizeof(float) * _size);
-    }
+    vector2<T>* a = nullptr;
+    vector2<T>* b = nullptr;
+    T* result     = nullptr;
+    T* expected   = nullptr;
 
     void regenerate(size_t n) {
-        _size = n;
-        free_vectors();
-        allocate_vectors();
+        _size     = n;
+        _a        = simd::aligned_buffer<vector2<T>, 32>{n};
+        _b        = simd::aligned_buffer<vector2<T>, 32>{n};
+        _result   = simd::aligned_buffer<T, 32>{n};
+        _expected = simd::aligned_buffer<T, 32>{n};
+        a         = _a.data();
+        b         = _b.data();
+        result    = _result.data();
+        expected  = _expected.data();
         fill_vectors();
     }
 
@@ -55,7 +47,7 @@ public:
     size_t size() const { return _size; }
 
     bool results_are_near() {
-        for (size_t i = 0; i < _size; ++i) {
+        for (size_t i = _offset; i < _size; ++i) {
             if (std::fabs(expected[i] - result[i]) > 0.0001) {
                 return false;
             }
@@ -63,12 +55,15 @@ public:
         return true;
     }
 
+    void calculate_expected() {
+        for (size_t i = 0; i < _size; ++i) {
+            expected[i] = a[i].dot(b[i]);
+        }
+    }
+
     void calculate() {
-        dot_product_n(
-                simd::as_unaligned_view(a),
-                simd::as_unaligned_view(b),
-                simd::as_unaligned_view(expected),
-                _size);
+        calculate_expected();
+        _offset = 0;
         dot_product_n(
                 simd::as_aligned_view<32>(a),
                 simd::as_aligned_view<32>(b),
@@ -76,10 +71,46 @@ public:
                 _size);
     }
 
+    void set_offset(size_t offset) { _offset = std::min(offset, _size); }
+
+    // skips the first `offset` elements so that the views passed to the
+    // kernel are not 32-byte aligned
+    void calculate_unaligned(size_t offset) {
+        calculate_expected();
+        _offset = std::min(offset, _size);
+        dot_product_n(
+                simd::as_unaligned_view(a + _offset),
+                simd::as_unaligned_view(b + _offset),
+                simd::as_unaligned_view(result + _offset),
+                _size - _offset);
+    }
+
 private:
-    size_t _size = 0;
+    simd::aligned_buffer<vector2<T>, 32> _a;
+    simd::aligned_buffer<vector2<T>, 32> _b;
+    simd::aligned_buffer<T, 32> _result;
+    simd::aligned_buffer<T, 32> _expected;
+    size_t _size   = 0;
+    size_t _offset = 0;
 };
 
+class dot_product_fixture : public dot_product_fixture_base<float> {
+public:
+    // runs one of the ISA specific kernels directly, bypassing the selection
+    // dot_product_n makes at compile time
+    template <typename Kernel>
+    void calculate_with(Kernel kernel, size_t offset) {
+        calculate_expected();
+        set_offset(offset);
+        kernel(simd::as_unaligned_view(a + offset),
+               simd::as_unaligned_view(b + offset),
+               simd::as_unaligned_view(result + offset),
+               size() - offset);
+    }
+};
+
+class dot_product_fixture_double : public dot_product_fixture_base<double> {};
+
 TEST(vector, basics) {
     {
         vector2f v1{0.0, 0.0};
@@ -163,3 +194,537 @@ TEST_F(dot_product_fixture, vectorized_implementation_1000) {
     calculate();
     EXPECT_TRUE(results_are_near());
 }
+
+TEST_F(dot_product_fixture, unaligned_implementation) {
+    for (size_t n : {1, 2, 8, 9, 16, 18, 31, 32, 100, 1000}) {
+        for (size_t offset = 0; offset < 8; ++offset) {
+            regenerate(n + offset);
+            calculate_unaligned(offset);
+            EXPECT_TRUE(results_are_near())
+                    << "n=" << n << " offset=" << offset;
+        }
+    }
+}
+
+TEST_F(dot_product_fixture, masked_tail) {
+    for (size_t n = 0; n <= 64; ++n) {
+        regenerate(n);
+        calculate();
+        EXPECT_TRUE(results_are_near()) << "n=" << n;
+    }
+}
+
+TEST_F(dot_product_fixture, masked_tail_unaligned) {
+    for (size_t n = 0; n <= 64; ++n) {
+        regenerate(n + 3);
+        calculate_unaligned(3);
+        EXPECT_TRUE(results_are_near()) << "n=" << n;
+    }
+}
+
+TEST_F(dot_product_fixture_double, vectorized_implementation) {
+    for (size_t n = 0; n <= 64; ++n) {
+        regenerate(n);
+        calculate();
+        EXPECT_TRUE(results_are_near()) << "n=" << n;
+    }
+    for (size_t n : {100, 200, 1000}) {
+        regenerate(n);
+        calculate();
+        EXPECT_TRUE(results_are_near()) << "n=" << n;
+    }
+}
+
+TEST_F(dot_product_fixture_double, unaligned_implementation) {
+    for (size_t n = 0; n <= 64; ++n) {
+        for (size_t offset = 0; offset < 4; ++offset) {
+            regenerate(n + offset);
+            calculate_unaligned(offset);
+            EXPECT_TRUE(results_are_near())
+                    << "n=" << n << " offset=" << offset;
+        }
+    }
+}
+
+// aligned_buffer views default to 64-byte alignment, wider than a 256-bit
+// block, so the aligned path must not step out in units of the view
+template <typename T>
+void test_wide_aligned_views() {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<T> dis(-100, 100);
+    for (size_t n : {size_t(1), size_t(31), size_t(64), size_t(1000)}) {
+        simd::aligned_buffer<vector2<T>, 64> a{n};
+        simd::aligned_buffer<vector2<T>, 64> b{n};
+        simd::aligned_buffer<T, 64> out{n};
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = {dis(gen), dis(gen)};
+            b[i] = {dis(gen), dis(gen)};
+        }
+        dot_product_n(a.view(), b.view(), out.view(), n);
+        for (size_t i = 0; i < n; ++i) {
+            // relative to the products, which may cancel
+            const T scale = std::abs(a[i].x * b[i].x)
+                            + std::abs(a[i].y * b[i].y);
+            EXPECT_NEAR(a[i].dot(b[i]), out[i], scale * T(1e-6))
+                    << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+TEST(dot_product, wide_aligned_views_float) {
+    test_wide_aligned_views<float>();
+}
+
+TEST(dot_product, wide_aligned_views_double) {
+    test_wide_aligned_views<double>();
+}
+
+class integral_dot_product_fixture : public ::testing::Test {
+public:
+    alignas(32) vector2i a[65];
+    alignas(32) vector2i b[65];
+
+    // mixes full range values, which overflow 32 bits, with small values,
+    // which do not
+    void regenerate(size_t n) {
+        std::mt19937 gen(n);
+        std::uniform_int_distribution<int32_t> full;
+        std::uniform_int_distribution<int32_t> small(-1000, 1000);
+        for (size_t i = 0; i < n; ++i) {
+            auto& dis = i % 3 == 0 ? small : full;
+            a[i]      = {dis(gen), dis(gen)};
+            b[i]      = {dis(gen), dis(gen)};
+        }
+    }
+};
+
+TEST_F(integral_dot_product_fixture, widening) {
+    for (size_t n = 0; n <= 64; ++n) {
+        regenerate(n + 1);
+        alignas(32) int64_t aligned_result[65];
+        int64_t unaligned_result[65];
+
+        dot_product_n(
+                simd::as_aligned_view<32>(a),
+                simd::as_aligned_view<32>(b),
+                simd::as_aligned_view<32>(aligned_result),
+                n);
+        dot_product_n(
+                simd::as_unaligned_view(a + 1),
+                simd::as_unaligned_view(b + 1),
+                simd::as_unaligned_view(unaligned_result),
+                n);
+
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(int64_t{a[i].x} * b[i].x + int64_t{a[i].y} * b[i].y,
+                      aligned_result[i]);
+            EXPECT_EQ(
+                    int64_t{a[i + 1].x} * b[i + 1].x
+                            + int64_t{a[i + 1].y} * b[i + 1].y,
+                    unaligned_result[i]);
+        }
+    }
+}
+
+TEST_F(integral_dot_product_fixture, wrapping) {
+    for (size_t n = 0; n <= 64; ++n) {
+        regenerate(n);
+        alignas(32) int32_t result[64];
+
+        dot_product_n(
+                simd::as_aligned_view<32>(a),
+                simd::as_aligned_view<32>(b),
+                simd::as_aligned_view<32>(result),
+                n,
+                wrapping);
+
+        for (size_t i = 0; i < n; ++i) {
+            const auto wide
+                    = int64_t{a[i].x} * b[i].x + int64_t{a[i].y} * b[i].y;
+            EXPECT_EQ(static_cast<int32_t>(wide), result[i]);
+        }
+    }
+}
+
+TEST_F(integral_dot_product_fixture, saturating) {
+    for (size_t n = 0; n <= 64; ++n) {
+        regenerate(n);
+        alignas(32) int32_t result[64];
+
+        dot_product_n(
+                simd::as_aligned_view<32>(a),
+                simd::as_aligned_view<32>(b),
+                simd::as_aligned_view<32>(result),
+                n,
+                saturating);
+
+        for (size_t i = 0; i < n; ++i) {
+            const auto wide
+                    = int64_t{a[i].x} * b[i].x + int64_t{a[i].y} * b[i].y;
+            EXPECT_EQ(std::clamp<int64_t>(wide, INT32_MIN, INT32_MAX),
+                      result[i]);
+        }
+    }
+}
+
+TEST(integral_dot_product, wrapping_vector2l) {
+    vector2l a[] = {{INT64_MAX, 2}, {3, 4}};
+    vector2l b[] = {{2, 1}, {5, 6}};
+    int64_t result[2];
+
+    dot_product_n(
+            simd::as_unaligned_view(a),
+            simd::as_unaligned_view(b),
+            simd::as_unaligned_view(result),
+            2,
+            wrapping);
+
+    EXPECT_EQ(0, result[0]);
+    EXPECT_EQ(39, result[1]);
+}
+
+#ifdef __AVX2__
+TEST_F(dot_product_fixture, avx_kernel) {
+    for (size_t n = 0; n <= 64; ++n) {
+        for (size_t offset = 0; offset < 8; offset += 3) {
+            regenerate(n + offset);
+            calculate_with(
+                    detail::dot_product_n_avx<float>, offset);
+            EXPECT_TRUE(results_are_near())
+                    << "n=" << n << " offset=" << offset;
+        }
+    }
+}
+#endif
+
+#ifdef __AVX512F__
+TEST_F(dot_product_fixture, avx512_kernel) {
+    for (size_t n = 0; n <= 80; ++n) {
+        for (size_t offset = 0; offset < 16; offset += 5) {
+            regenerate(n + offset);
+            calculate_with(detail::dot_product_n_avx512<>, offset);
+            EXPECT_TRUE(results_are_near())
+                    << "n=" << n << " offset=" << offset;
+        }
+    }
+}
+#endif
+
+TEST_F(dot_product_fixture, sum) {
+    // the components are small integers, so every summation order is exact
+    for (size_t n = 0; n <= 100; ++n) {
+        regenerate(n + 1);
+        calculate_expected();
+        const float expected_sum = std::accumulate(expected, expected + n, 0.f);
+
+        EXPECT_EQ(
+                expected_sum,
+                dot_product_sum(
+                        simd::as_aligned_view<32>(a),
+                        simd::as_aligned_view<32>(b),
+                        n));
+        EXPECT_EQ(
+                expected_sum + expected[n],
+                dot_product_sum(
+                        simd::as_unaligned_view(a + 1),
+                        simd::as_unaligned_view(b + 1),
+                        n,
+                        kahan));
+        EXPECT_EQ(
+                expected_sum + expected[n],
+                dot_product_sum(
+                        simd::as_unaligned_view(a + 1),
+                        simd::as_unaligned_view(b + 1),
+                        n,
+                        pairwise));
+    }
+}
+
+TEST_F(dot_product_fixture_double, sum) {
+    for (size_t n = 0; n <= 40; ++n) {
+        regenerate(n);
+        calculate_expected();
+        const double expected_sum
+                = std::accumulate(expected, expected + n, 0.0);
+
+        EXPECT_EQ(
+                expected_sum,
+                dot_product_sum(
+                        simd::as_aligned_view<32>(a),
+                        simd::as_aligned_view<32>(b),
+                        n));
+        EXPECT_EQ(
+                expected_sum,
+                dot_product_sum(
+                        simd::as_aligned_view<32>(a),
+                        simd::as_aligned_view<32>(b),
+                        n,
+                        kahan));
+        EXPECT_EQ(
+                expected_sum,
+                dot_product_sum(
+                        simd::as_aligned_view<32>(a),
+                        simd::as_aligned_view<32>(b),
+                        n,
+                        pairwise));
+    }
+}
+
+TEST(dot_product_sum, compensation) {
+    const size_t n = 1 << 20;
+    std::vector<vector2f> a(n), b(n);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> dis(0.f, 1.f);
+    double reference = 0;
+    for (size_t i = 0; i < n; ++i) {
+        a[i]      = {dis(gen), dis(gen)};
+        b[i]      = {dis(gen), dis(gen)};
+        reference += double(a[i].x) * b[i].x;
+        reference += double(a[i].y) * b[i].y;
+    }
+    auto relative_error = [&](float sum) {
+        return std::fabs(sum - reference) / reference;
+    };
+
+    auto av = simd::as_unaligned_view(a.data());
+    auto bv = simd::as_unaligned_view(b.data());
+#ifdef __AVX2__
+    // the vector kernel spreads the plain sum over 32 partial sums
+    EXPECT_LT(relative_error(dot_product_sum(av, bv, n)), 1e-4);
+#else
+    // a single running sum
+    EXPECT_LT(relative_error(dot_product_sum(av, bv, n)), 1e-3);
+#endif
+    EXPECT_LT(relative_error(dot_product_sum(av, bv, n, kahan)), 1e-6);
+    EXPECT_LT(relative_error(dot_product_sum(av, bv, n, pairwise)), 1e-6);
+}
+
+template <typename T>
+void test_soa_dot_product_n() {
+    for (size_t n = 0; n <= 70; ++n) {
+        vector2_soa<T> a{n}, b{n};
+        std::vector<T> expected(n);
+        for (size_t i = 0; i < n; ++i) {
+            a.set(i, {T(i), T(1) - T(i)});
+            b.set(i, {T(n) - T(i), T(i) / T(2)});
+            expected[i] = a[i].dot(b[i]);
+        }
+
+        vector2_soa<T> out_storage{n};
+        dot_product_n(
+                a.view(),
+                b.view(),
+                simd::as_aligned_view<vector2_soa<T>::alignment>(
+                        out_storage.x()),
+                n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(expected[i], out_storage.x()[i]) << "n=" << n;
+        }
+
+        if (n == 0) {
+            continue;
+        }
+        // drops the first element so that nothing is aligned
+        std::vector<T> out(n);
+        dot_product_n(
+                unaligned_soa_view<T>(a.view()) + 1,
+                unaligned_soa_view<T>(b.view()) + 1,
+                simd::as_unaligned_view(out.data()),
+                n - 1);
+        for (size_t i = 0; i + 1 < n; ++i) {
+            EXPECT_EQ(expected[i + 1], out[i]) << "n=" << n;
+        }
+    }
+}
+
+TEST(soa_dot_product, float) {
+    test_soa_dot_product_n<float>();
+}
+
+TEST(soa_dot_product, double) {
+    test_soa_dot_product_n<double>();
+}
+
+template <typename T>
+void test_parallel_dot_product_n() {
+    simd::thread_pool pool{4};
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<T> dis(-100, 100);
+
+    for (size_t n :
+         {size_t(100), parallel_threshold + 3, parallel_grain * 9 + 5}) {
+        simd::aligned_buffer<vector2<T>, 32> a{n};
+        simd::aligned_buffer<vector2<T>, 32> b{n};
+        simd::aligned_buffer<T, 32> serial{n};
+        simd::aligned_buffer<T, 32> threaded{n};
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = {dis(gen), dis(gen)};
+            b[i] = {dis(gen), dis(gen)};
+        }
+
+        dot_product_n(a.view(), b.view(), serial.view(), n);
+        dot_product_n(a.view(), b.view(), threaded.view(), n, parallel, pool);
+        EXPECT_TRUE(
+                std::equal(serial.begin(), serial.end(), threaded.begin()))
+                << "n=" << n;
+
+        // shifted by one element so no chunk starts aligned
+        auto a1 = simd::unaligned_view<vector2<T>>{a.data() + 1};
+        auto b1 = simd::unaligned_view<vector2<T>>{b.data() + 1};
+        dot_product_n(a1, b1, simd::unaligned_view<T>{serial.data()}, n - 1);
+        dot_product_n(
+                a1,
+                b1,
+                simd::unaligned_view<T>{threaded.data()},
+                n - 1,
+                parallel,
+                pool);
+        EXPECT_TRUE(
+                std::equal(serial.begin(), serial.end() - 1, threaded.begin()))
+                << "n=" << n;
+    }
+}
+
+TEST(parallel_dot_product, float) {
+    test_parallel_dot_product_n<float>();
+}
+
+TEST(parallel_dot_product, double) {
+    test_parallel_dot_product_n<double>();
+}
+
+template <typename T>
+void test_streaming_dot_product_n() {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<T> dis(-100, 100);
+
+    const size_t n = min_streaming_bytes / sizeof(T) + 13;
+    simd::aligned_buffer<vector2<T>, 32> a{n};
+    simd::aligned_buffer<vector2<T>, 32> b{n};
+    simd::aligned_buffer<T, 32> stored{n};
+    simd::aligned_buffer<T, 32> streamed{n};
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = {dis(gen), dis(gen)};
+        b[i] = {dis(gen), dis(gen)};
+    }
+
+    // the plain stores as reference; the results do not depend on the
+    // alignment of out, so one pass serves every offset
+    const size_t threshold = simd::streaming_threshold();
+    simd::set_streaming_threshold(SIZE_MAX);
+    dot_product_n(
+            simd::unaligned_view<vector2<T>>{a.data()},
+            simd::unaligned_view<vector2<T>>{b.data()},
+            simd::unaligned_view<T>{stored.data()},
+            n);
+
+    // every offset within a 32-byte block, so the peeled head varies
+    for (size_t offset = 0; offset < 32 / sizeof(T); ++offset) {
+        auto a1        = simd::unaligned_view<vector2<T>>{a.data() + offset};
+        auto b1        = simd::unaligned_view<vector2<T>>{b.data() + offset};
+        auto streamed1 = simd::unaligned_view<T>{streamed.data() + offset};
+        dot_product_n(a1, b1, streamed1, n - offset, streaming);
+        EXPECT_TRUE(std::equal(
+                stored.begin() + offset,
+                stored.end(),
+                streamed.begin() + offset))
+                << "offset=" << offset;
+    }
+
+    // above the threshold the default overloads stream on their own
+    simd::set_streaming_threshold(0);
+    std::fill(streamed.begin(), streamed.end(), T(0));
+    dot_product_n(a.view(), b.view(), streamed.view(), n);
+    EXPECT_TRUE(std::equal(stored.begin(), stored.end(), streamed.begin()));
+    simd::set_streaming_threshold(threshold);
+}
+
+TEST(streaming_dot_product, float) {
+    test_streaming_dot_product_n<float>();
+}
+
+TEST(streaming_dot_product, double) {
+    test_streaming_dot_product_n<double>();
+}
+
+TEST_F(dot_product_fixture, prefetch) {
+    const size_t distance = simd::prefetch_distance();
+    // a distance far past the end of the arrays must be harmless too
+    for (size_t lookahead : {size_t(8), size_t(64), size_t(1) << 24}) {
+        simd::set_prefetch_distance(lookahead);
+        regenerate(1000);
+        calculate();
+        EXPECT_TRUE(results_are_near()) << lookahead;
+        calculate_unaligned(3);
+        EXPECT_TRUE(results_are_near()) << lookahead;
+
+        std::vector<vector2f> halves(1000, vector2f{0.5f, 0.5f});
+        auto view = simd::as_unaligned_view(halves.data());
+        EXPECT_EQ(500.f, dot_product_sum(view, view, halves.size()));
+    }
+    simd::set_prefetch_distance(distance);
+}
+
+template <typename T>
+void test_gather_dot_product_n() {
+    // a vector2 at offset 16 of a 48-byte record
+    struct entity {
+        char header[16];
+        vector2<T> position;
+        char tag[32 - sizeof(vector2<T>)];
+    };
+    static_assert(sizeof(entity) == 48);
+
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<T> dis(-100, 100);
+    std::vector<entity> entities(100);
+    std::vector<vector2<T>> dense(100);
+    for (size_t i = 0; i < entities.size(); ++i) {
+        entities[i].position = {dis(gen), dis(gen)};
+        dense[i]             = {dis(gen), dis(gen)};
+    }
+    std::vector<int32_t> indices(100);
+    for (auto& index : indices) {
+        index = gen() % dense.size();
+    }
+
+    for (size_t n : {1, 3, 8, 13, 64, 100}) {
+        std::vector<T> out(n);
+
+        auto positions = simd::as_strided_view(
+                entities.data(), &entity::position);
+        dot_product_n(
+                positions,
+                simd::as_strided_view(dense.data()),
+                simd::as_unaligned_view(out.data()),
+                n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(
+                    entities[i].position.dot(dense[i]),
+                    out[i],
+                    std::abs(out[i]) * 1e-5)
+                    << "n=" << n << " i=" << i;
+        }
+
+        dot_product_n(
+                simd::as_indexed_view(dense.data(), indices.data()),
+                simd::as_indexed_view(dense.data(), indices.data() + 1),
+                simd::as_unaligned_view(out.data()),
+                std::min<size_t>(n, 99));
+        for (size_t i = 0; i < std::min<size_t>(n, 99); ++i) {
+            EXPECT_NEAR(
+                    dense[indices[i]].dot(dense[indices[i + 1]]),
+                    out[i],
+                    std::abs(out[i]) * 1e-5)
+                    << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+TEST(gather_dot_product, float) {
+    test_gather_dot_product_n<float>();
+}
+
+TEST(gather_dot_product, double) {
+    test_gather_dot_product_n<double>();
+}
@@ -0,0 +1,81 @@
+#include <simd/math/filter.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace simd::math;
+
+template <typename T>
+struct greater_than {
+    T threshold;
+
+    bool operator()(T value) const { return value > threshold; }
+
+    template <typename SimdVector>
+    auto operator()(SimdVector v) const {
+        return simd::cmp_gt(v, SimdVector::broadcast(threshold));
+    }
+};
+
+template <typename T>
+void test_filter_n() {
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> values{-50, 50};
+
+    for (size_t n = 0; n <= 70; ++n) {
+        // one extra element so that the views are shifted off alignment
+        std::vector<T> in(n + 1);
+        for (auto& value : in) {
+            value = T(values(rng));
+        }
+        std::vector<T> expected;
+        for (size_t i = 1; i <= n; ++i) {
+            if (in[i] > T(10)) {
+                expected.push_back(in[i]);
+            }
+        }
+
+        std::vector<T> out(n + 2, T(99));
+        const size_t count = filter_n(
+                simd::as_unaligned_view(in.data() + 1),
+                simd::as_unaligned_view(out.data() + 1),
+                n,
+                greater_than<T>{T(10)});
+        ASSERT_EQ(expected.size(), count);
+        EXPECT_EQ(T(99), out[0]);
+        EXPECT_EQ(T(99), out[n + 1]);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(expected[i], out[i + 1]);
+        }
+
+        // in place
+        const size_t in_place = filter_n(
+                simd::as_unaligned_view(in.data() + 1),
+                simd::as_unaligned_view(in.data() + 1),
+                n,
+                greater_than<T>{T(10)});
+        ASSERT_EQ(expected.size(), in_place);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(expected[i], in[i + 1]);
+        }
+    }
+}
+
+TEST(filter_n, matches_scalar) {
+    test_filter_n<float>();
+    test_filter_n<double>();
+    test_filter_n<int32_t>();
+}
+
+TEST(filter_n, keeps_all_or_none) {
+    std::vector<float> in(100, 1.f);
+    std::vector<float> out(100);
+    const auto from = simd::as_unaligned_view(in.data());
+    const auto to   = simd::as_unaligned_view(out.data());
+    EXPECT_EQ(100u, filter_n(from, to, 100, greater_than<float>{0.f}));
+    EXPECT_EQ(in, out);
+    EXPECT_EQ(0u, filter_n(from, to, 100, greater_than<float>{1.f}));
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <simd/math/vector2.h>
+#include <simd/math/vector3.h>
+#include <simd/math/vector4.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+// the generators and checkers shared by the batch kernel tests
+namespace simd::math::test {
+
+namespace detail {
+
+template <typename T, typename Next>
+void fill(vector2<T>& v, Next next) {
+    v = {T(next()), T(next())};
+}
+
+template <typename T, typename Next>
+void fill(vector3<T>& v, Next next) {
+    v = {T(next()), T(next()), T(next())};
+}
+
+template <typename T, typename Next>
+void fill(vector4<T>& v, Next next) {
+    v = {T(next()), T(next()), T(next()), T(next())};
+}
+
+}  // namespace detail
+
+// a vector with every component drawn from [-range, range]
+template <typename Vector>
+Vector random_vector(std::mt19937& rng, double range = 100.0) {
+    std::uniform_real_distribution<double> component{-range, range};
+    Vector v;
+    detail::fill(v, [&] { return component(rng); });
+    return v;
+}
+
+template <typename Vector>
+std::vector<Vector> random_vectors(
+        size_t n, std::mt19937& rng, double range = 100.0) {
+    std::vector<Vector> vectors(n);
+    for (auto& v : vectors) {
+        v = random_vector<Vector>(rng, range);
+    }
+    return vectors;
+}
+
+template <typename Vector>
+std::vector<Vector> random_vectors(
+        size_t n, unsigned seed, double range = 100.0) {
+    std::mt19937 rng{seed};
+    return random_vectors<Vector>(n, rng, range);
+}
+
+// n + 2 vectors with every component set to value, for the kernels to write
+// elements 1 to n of and leave the rest alone
+template <typename Vector>
+std::vector<Vector> sentinels(size_t n, double value = 7.0) {
+    Vector v;
+    detail::fill(v, [&] { return value; });
+    return std::vector<Vector>(n + 2, v);
+}
+
+// calls f(n) for no, one and two blocks of the vector3 and vector4 kernels
+// followed by every tail length. A block holds as many elements as a 256 bit
+// register holds components of T
+template <typename T, typename F>
+void for_each_tail(F f) {
+    constexpr size_t block = 32 / sizeof(T);
+    for (size_t n = 0; n < block * 3; ++n) {
+        SCOPED_TRACE(n);
+        f(n);
+    }
+}
+
+template <typename T>
+void expect_near(vector2<T> expected, vector2<T> actual, T tolerance) {
+    EXPECT_NEAR(expected.x, actual.x, tolerance);
+    EXPECT_NEAR(expected.y, actual.y, tolerance);
+}
+
+template <typename T>
+void expect_near(vector3<T> expected, vector3<T> actual, T tolerance) {
+    EXPECT_NEAR(expected.x, actual.x, tolerance);
+    EXPECT_NEAR(expected.y, actual.y, tolerance);
+    EXPECT_NEAR(expected.z, actual.z, tolerance);
+}
+
+template <typename T>
+void expect_near(vector4<T> expected, vector4<T> actual, T tolerance) {
+    EXPECT_NEAR(expected.x, actual.x, tolerance);
+    EXPECT_NEAR(expected.y, actual.y, tolerance);
+    EXPECT_NEAR(expected.z, actual.z, tolerance);
+    EXPECT_NEAR(expected.w, actual.w, tolerance);
+}
+
+}  // namespace simd::math::test
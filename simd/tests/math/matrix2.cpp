@@ -0,0 +1,58 @@
+#include <simd/math/matrix2.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace simd::math;
+
+TEST(matrix2, multiply_vector) {
+    constexpr matrix2f m = {.x_axis = {1.f, 2.f}, .y_axis = {3.f, 4.f}};
+    constexpr vector2f v = m * vector2f{5.f, 6.f};
+    EXPECT_EQ(1.f * 5.f + 3.f * 6.f, v.x);
+    EXPECT_EQ(2.f * 5.f + 4.f * 6.f, v.y);
+
+    constexpr vector2d s = matrix2d::scale(2.0, 3.0) * vector2d{1.0, 1.0};
+    EXPECT_EQ(2.0, s.x);
+    EXPECT_EQ(3.0, s.y);
+}
+
+TEST(matrix2, multiply_matrix) {
+    constexpr matrix2f a = {.x_axis = {1.f, 2.f}, .y_axis = {3.f, 4.f}};
+    constexpr matrix2f b = {.x_axis = {5.f, 6.f}, .y_axis = {7.f, 8.f}};
+    constexpr vector2f v = {-1.f, 2.f};
+    const vector2f composed = (a * b) * v;
+    const vector2f nested   = a * (b * v);
+    EXPECT_EQ(nested.x, composed.x);
+    EXPECT_EQ(nested.y, composed.y);
+
+    const matrix2f same = a * matrix2f::identity();
+    EXPECT_EQ(a.x_axis.x, same.x_axis.x);
+    EXPECT_EQ(a.y_axis.y, same.y_axis.y);
+}
+
+TEST(matrix2, rotation) {
+    const vector2d v = matrix2d::rotation(M_PI / 2) * vector2d{1.0, 0.0};
+    EXPECT_NEAR(0.0, v.x, 1e-15);
+    EXPECT_NEAR(1.0, v.y, 1e-15);
+}
+
+TEST(affine2, multiply) {
+    constexpr affine2f rotate_then_move = {
+            .linear      = {.x_axis = {0.f, 1.f}, .y_axis = {-1.f, 0.f}},
+            .translation = {10.f, 20.f}};
+    constexpr vector2f p = rotate_then_move * vector2f{1.f, 2.f};
+    EXPECT_EQ(8.f, p.x);
+    EXPECT_EQ(21.f, p.y);
+
+    // the right operand applies first
+    constexpr affine2f twice    = rotate_then_move * rotate_then_move;
+    constexpr vector2f expected = rotate_then_move * p;
+    constexpr vector2f actual   = twice * vector2f{1.f, 2.f};
+    EXPECT_EQ(expected.x, actual.x);
+    EXPECT_EQ(expected.y, actual.y);
+
+    constexpr vector2f same = affine2f::identity() * p;
+    EXPECT_EQ(p.x, same.x);
+    EXPECT_EQ(p.y, same.y);
+}
@@ -0,0 +1,145 @@
+#include <simd/math/matrix2_batch.h>
+#include <simd/memory.h>
+
+#include "helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace simd::math;
+using namespace simd::math::test;
+
+namespace {
+
+template <typename T>
+std::vector<affine2<T>> random_transforms(size_t n, std::mt19937& rng) {
+    std::vector<affine2<T>> transforms(n);
+    const auto columns = random_vectors<vector2<T>>(n * 3, rng);
+    for (size_t i = 0; i < n; ++i) {
+        transforms[i] = {
+                .linear
+                = {.x_axis = columns[i * 3], .y_axis = columns[i * 3 + 1]},
+                .translation = columns[i * 3 + 2]};
+    }
+    return transforms;
+}
+
+// the kernels fuse the multiply-adds, so they may differ from the scalar
+// operators in the last bits of the products, which reach 2 * 10^4
+template <typename T>
+void expect_near(vector2<T> expected, vector2<T> actual) {
+    const T tolerance = std::is_same_v<T, float> ? 1e-2f : 1e-10;
+    test::expect_near(expected, actual, tolerance);
+}
+
+}  // namespace
+
+// every layout against the scalar operators, for every tail length and with
+// the views shifted off alignment by one element
+template <typename T>
+void test_transform() {
+    std::mt19937 rng{1};
+    for (size_t n = 0; n <= 40; ++n) {
+        const auto in         = random_vectors<vector2<T>>(n + 1, rng);
+        const auto transforms = random_transforms<T>(n + 1, rng);
+        const auto single     = transforms[0];
+        const auto view       = [](auto& values) {
+            return simd::as_unaligned_view(
+                    const_cast<std::decay_t<decltype(values[0])>*>(
+                            values.data() + 1));
+        };
+
+        std::vector<vector2<T>> out(n + 2, vector2<T>{T(7), T(7)});
+        transform_n(single, view(in), view(out), n);
+        EXPECT_EQ(T(7), out[n + 1].x);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(single * in[i], out[i]);
+        }
+        transform_n(single.linear, view(in), view(out), n);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(single.linear * in[i], out[i]);
+        }
+        transform_n(view(transforms), view(in), view(out), n);
+        EXPECT_EQ(T(7), out[n + 1].x);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(transforms[i] * in[i], out[i]);
+        }
+
+        std::vector<T> x(n + 2, T(7)), y(n + 2, T(7));
+        std::vector<T> out_x(n + 2, T(7)), out_y(n + 2, T(7));
+        for (size_t i = 1; i <= n; ++i) {
+            x[i] = in[i].x;
+            y[i] = in[i].y;
+        }
+        const unaligned_soa_view<T> soa_in  = {view(x), view(y)};
+        const unaligned_soa_view<T> soa_out = {view(out_x), view(out_y)};
+        const auto check_soa                = [&](auto expected) {
+            EXPECT_EQ(T(7), out_x[n + 1]);
+            EXPECT_EQ(T(7), out_y[n + 1]);
+            for (size_t i = 1; i <= n; ++i) {
+                expect_near(expected(i), vector2<T>{out_x[i], out_y[i]});
+            }
+        };
+        transform_n(single, soa_in, soa_out, n);
+        check_soa([&](size_t i) { return single * in[i]; });
+        transform_n(single.linear, soa_in, soa_out, n);
+        check_soa([&](size_t i) { return single.linear * in[i]; });
+        transform_n(view(transforms), soa_in, soa_out, n);
+        check_soa([&](size_t i) { return transforms[i] * in[i]; });
+
+        // in place
+        auto points = in;
+        transform_n(view(transforms), view(points), view(points), n);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(transforms[i] * in[i], points[i]);
+        }
+    }
+}
+
+TEST(matrix2_batch, transform_float) {
+    test_transform<float>();
+}
+
+TEST(matrix2_batch, transform_double) {
+    test_transform<double>();
+}
+
+TEST(matrix2_batch, aligned_views) {
+    constexpr size_t n = 37;
+    simd::aligned_buffer<vector2f, 64> points{n}, out{n};
+    std::vector<affine2f> transforms(n);
+    vector2_soa<float> soa{n}, soa_out{n};
+    for (size_t i = 0; i < n; ++i) {
+        points[i]     = {float(i), 1.f};
+        transforms[i] = {
+                .linear      = matrix2f::scale(2.f, float(i)),
+                .translation = {1.f, 0.f}};
+        soa.set(i, points[i]);
+    }
+
+    // a quarter turn counterclockwise, then a move by (1, 0)
+    const affine2f transform = {
+            .linear      = {.x_axis = {0.f, 1.f}, .y_axis = {-1.f, 0.f}},
+            .translation = {1.f, 0.f}};
+    transform_n(transform, points.view(), out.view(), n);
+    transform_n(transform, soa.view(), soa_out.view(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(0.f, out[i].x);
+        EXPECT_EQ(float(i), out[i].y);
+        EXPECT_EQ(0.f, soa_out[i].x);
+        EXPECT_EQ(float(i), soa_out[i].y);
+    }
+
+    const auto each = simd::as_unaligned_view(transforms.data());
+    transform_n(each, points.view(), out.view(), n);
+    transform_n(each, soa.view(), soa_out.view(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(2.f * float(i) + 1.f, out[i].x);
+        EXPECT_EQ(float(i), out[i].y);
+        EXPECT_EQ(2.f * float(i) + 1.f, soa_out[i].x);
+        EXPECT_EQ(float(i), soa_out[i].y);
+    }
+}
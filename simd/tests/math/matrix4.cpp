@@ -0,0 +1,67 @@
+#include <simd/math/matrix4.h>
+
+#include <gtest/gtest.h>
+
+using namespace simd::math;
+
+namespace {
+
+// 1, 2, ..., 16 in column order
+constexpr matrix4f counting = {
+        .x_axis = {1.f, 2.f, 3.f, 4.f},
+        .y_axis = {5.f, 6.f, 7.f, 8.f},
+        .z_axis = {9.f, 10.f, 11.f, 12.f},
+        .w_axis = {13.f, 14.f, 15.f, 16.f}};
+
+}  // namespace
+
+TEST(matrix4, multiply_vector) {
+    constexpr vector4f v = counting * vector4f{1.f, 0.f, -1.f, 2.f};
+    EXPECT_EQ(1.f - 9.f + 26.f, v.x);
+    EXPECT_EQ(2.f - 10.f + 28.f, v.y);
+    EXPECT_EQ(3.f - 11.f + 30.f, v.z);
+    EXPECT_EQ(4.f - 12.f + 32.f, v.w);
+
+    constexpr vector4d p
+            = matrix4d::translation(1.0, 2.0, 3.0)
+              * (matrix4d::scale(2.0, 3.0, 4.0) * vector4d{1.0, 1.0, 1.0, 1.0});
+    EXPECT_EQ(3.0, p.x);
+    EXPECT_EQ(5.0, p.y);
+    EXPECT_EQ(7.0, p.z);
+    EXPECT_EQ(1.0, p.w);
+
+    // directions, with w = 0, are not translated
+    constexpr matrix4d move = matrix4d::translation(1.0, 2.0, 3.0);
+    constexpr vector4d d    = move * vector4d{1.0, 0.0, 0.0, 0.0};
+    EXPECT_EQ(1.0, d.x);
+    EXPECT_EQ(0.0, d.y);
+}
+
+TEST(matrix4, multiply_matrix) {
+    constexpr matrix4f b    = counting.transposed();
+    constexpr vector4f v    = {-1.f, 2.f, 0.5f, 3.f};
+    const vector4f composed = (counting * b) * v;
+    const vector4f nested   = counting * (b * v);
+    EXPECT_EQ(nested.x, composed.x);
+    EXPECT_EQ(nested.y, composed.y);
+    EXPECT_EQ(nested.z, composed.z);
+    EXPECT_EQ(nested.w, composed.w);
+
+    const matrix4f same = counting * matrix4f::identity();
+    EXPECT_EQ(counting.x_axis.x, same.x_axis.x);
+    EXPECT_EQ(counting.z_axis.y, same.z_axis.y);
+    EXPECT_EQ(counting.w_axis.w, same.w_axis.w);
+}
+
+TEST(matrix4, transposed) {
+    constexpr matrix4f t = counting.transposed();
+    EXPECT_EQ(1.f, t.x_axis.x);
+    EXPECT_EQ(5.f, t.x_axis.y);
+    EXPECT_EQ(13.f, t.x_axis.w);
+    EXPECT_EQ(4.f, t.w_axis.x);
+    EXPECT_EQ(16.f, t.w_axis.w);
+
+    constexpr matrix4f back = t.transposed();
+    EXPECT_EQ(counting.y_axis.z, back.y_axis.z);
+    EXPECT_EQ(counting.w_axis.x, back.w_axis.x);
+}
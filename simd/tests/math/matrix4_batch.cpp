@@ -0,0 +1,167 @@
+#include <simd/math/matrix4_batch.h>
+#include <simd/memory.h>
+
+#include "helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace simd::math;
+using namespace simd::math::test;
+
+namespace {
+
+template <typename T>
+std::vector<matrix4<T>> random_matrices(size_t n, std::mt19937& rng) {
+    std::vector<matrix4<T>> matrices(n);
+    for (auto& m : matrices) {
+        m = {random_vector<vector4<T>>(rng, 1.0),
+             random_vector<vector4<T>>(rng, 1.0),
+             random_vector<vector4<T>>(rng, 1.0),
+             random_vector<vector4<T>>(rng, 1.0)};
+    }
+    return matrices;
+}
+
+// the kernels fuse the multiply-adds, so they may differ from the scalar
+// operators in the last bits
+template <typename T>
+void expect_near(vector4<T> expected, vector4<T> actual) {
+    const T tolerance = std::is_same_v<T, float> ? 1e-5f : 1e-13;
+    test::expect_near(expected, actual, tolerance);
+}
+
+template <typename T>
+void expect_near(const matrix4<T>& expected, const matrix4<T>& actual) {
+    expect_near(expected.x_axis, actual.x_axis);
+    expect_near(expected.y_axis, actual.y_axis);
+    expect_near(expected.z_axis, actual.z_axis);
+    expect_near(expected.w_axis, actual.w_axis);
+}
+
+}  // namespace
+
+// every kernel against the scalar operators, for every tail length and with
+// the views shifted by one element
+template <typename T>
+void test_kernels() {
+    std::mt19937 rng{1};
+    for (size_t n = 0; n <= 20; ++n) {
+        auto a            = random_matrices<T>(n + 1, rng);
+        auto b            = random_matrices<T>(n + 1, rng);
+        auto in           = random_vectors<vector4<T>>(n + 1, rng, 1.0);
+        const auto single = a[0];
+        const auto view   = [](auto& values) {
+            return simd::as_unaligned_view(values.data() + 1);
+        };
+
+        const matrix4<T> unset = matrix4<T>::scale(T(7), T(7), T(7));
+        std::vector<matrix4<T>> out(n + 2, unset);
+        multiply_n(view(a), view(b), view(out), n);
+        EXPECT_EQ(T(7), out[n + 1].x_axis.x);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(a[i] * b[i], out[i]);
+        }
+        multiply_n(single, view(b), view(out), n);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(single * b[i], out[i]);
+        }
+        transpose_n(view(a), view(out), n);
+        EXPECT_EQ(T(7), out[n + 1].x_axis.x);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(a[i].transposed(), out[i]);
+        }
+
+        std::vector<vector4<T>> vectors(n + 2, unset.x_axis);
+        transform_n(single, view(in), view(vectors), n);
+        EXPECT_EQ(T(7), vectors[n + 1].x);
+        EXPECT_EQ(T(0), vectors[n + 1].w);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(single * in[i], vectors[i]);
+        }
+        transform_n(view(a), view(in), view(vectors), n);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(a[i] * in[i], vectors[i]);
+        }
+
+        // in place
+        const auto original = b;
+        multiply_n(view(a), view(b), view(b), n);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(a[i] * original[i], b[i]);
+        }
+        transpose_n(view(b), view(b), n);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near((a[i] * original[i]).transposed(), b[i]);
+        }
+        const auto original_in = in;
+        transform_n(single, view(in), view(in), n);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(single * original_in[i], in[i]);
+        }
+    }
+}
+
+TEST(matrix4_batch, float) {
+    test_kernels<float>();
+}
+
+TEST(matrix4_batch, double) {
+    test_kernels<double>();
+}
+
+TEST(matrix4_batch, aligned_views) {
+    constexpr size_t n = 13;
+    simd::aligned_buffer<matrix4f, 64> a{n}, out{n};
+    simd::aligned_buffer<vector4f, 64> points{n};
+    for (size_t i = 0; i < n; ++i) {
+        a[i]      = matrix4f::translation(float(i), 1.f, 2.f);
+        points[i] = {1.f, 1.f, 1.f, 1.f};
+    }
+
+    const matrix4f twice = matrix4f::scale(2.f, 2.f, 2.f);
+    multiply_n(twice, a.view(), out.view(), n);
+    multiply_n(out.view(), a.view(), out.view(), n);
+    transform_n(out.view(), points.view(), points.view(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(2.f + 4.f * float(i), points[i].x);
+        EXPECT_EQ(6.f, points[i].y);
+        EXPECT_EQ(10.f, points[i].z);
+        EXPECT_EQ(1.f, points[i].w);
+    }
+
+    transpose_n(out.view(), out.view(), n);
+    transform_n(twice, points.view(), points.view(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(4.f * float(i), out[i].x_axis.w);
+        EXPECT_EQ(12.f, points[i].y);
+    }
+}
+
+TEST(matrix4_batch, integral) {
+    using matrix4i = matrix4<int32_t>;
+    std::vector<matrix4i> a(5), out(5);
+    std::vector<vector4i> points(5);
+    for (int32_t i = 0; i < 5; ++i) {
+        a[i]      = matrix4i::translation(i, -i, 0);
+        points[i] = {1, 2, 3, 1};
+    }
+    multiply_n(
+            simd::as_unaligned_view(a.data()),
+            simd::as_unaligned_view(a.data()),
+            simd::as_unaligned_view(out.data()),
+            a.size());
+    transform_n(
+            simd::as_unaligned_view(out.data()),
+            simd::as_unaligned_view(points.data()),
+            simd::as_unaligned_view(points.data()),
+            points.size());
+    for (int32_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(1 + 2 * i, points[i].x);
+        EXPECT_EQ(2 - 2 * i, points[i].y);
+        EXPECT_EQ(3, points[i].z);
+    }
+}
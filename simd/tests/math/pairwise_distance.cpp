@@ -0,0 +1,174 @@
+#include <simd/math/pairwise_distance.h>
+#include <simd/memory.h>
+
+#include "helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace simd::math;
+using namespace simd::math::test;
+
+namespace {
+
+std::vector<std::pair<int32_t, int32_t>> sorted_pairs(
+        const std::vector<int32_t>& rows,
+        const std::vector<int32_t>& columns,
+        size_t count) {
+    std::vector<std::pair<int32_t, int32_t>> pairs;
+    for (size_t k = 0; k < count; ++k) {
+        pairs.emplace_back(rows[k], columns[k]);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+}  // namespace
+
+// sizes around the register width and across several row blocks and tiles,
+// with the views shifted off alignment by one element
+template <typename T>
+void test_pairwise() {
+    const T tolerance = std::is_same_v<T, float> ? 1e-5f : 1e-13;
+    const std::pair<size_t, size_t> sizes[] = {
+            {0, 5}, {5, 0}, {1, 1}, {3, 17}, {130, 1030}, {257, 2051}};
+    for (const auto& [m, n] : sizes) {
+        auto a = random_vectors<vector2<T>>(m + 1, 1, 10.0);
+        auto b = random_vectors<vector2<T>>(n + 1, 2, 10.0);
+        std::vector<T> out(m * n + 2, T(-1));
+        pairwise_distance_squared(
+                simd::as_unaligned_view(a.data() + 1),
+                m,
+                simd::as_unaligned_view(b.data() + 1),
+                n,
+                simd::as_unaligned_view(out.data() + 1));
+        EXPECT_EQ(T(-1), out[0]);
+        EXPECT_EQ(T(-1), out[m * n + 1]);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                const vector2<T> d = a[i + 1] - b[j + 1];
+                const T expected   = d.dot(d);
+                EXPECT_NEAR(expected, out[i * n + j + 1], tolerance * expected)
+                        << i << ", " << j;
+            }
+        }
+
+        // the streaming stores write the same matrix
+        std::vector<T> streamed(m * n + 2, T(-1));
+        pairwise_distance_squared(
+                simd::as_unaligned_view(a.data() + 1),
+                m,
+                simd::as_unaligned_view(b.data() + 1),
+                n,
+                simd::as_unaligned_view(streamed.data() + 1),
+                streaming);
+        EXPECT_EQ(out, streamed);
+
+        // the threshold mode finds the pairs the matrix has below the radius
+        const T radius_squared = T(4);
+        std::vector<std::pair<int32_t, int32_t>> expected;
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                if (out[i * n + j + 1] < radius_squared) {
+                    expected.emplace_back(int32_t(i), int32_t(j));
+                }
+            }
+        }
+        std::vector<int32_t> rows(expected.size() + 1, -1);
+        std::vector<int32_t> columns(expected.size() + 1, -1);
+        const size_t count = pairwise_distance_squared(
+                simd::as_unaligned_view(a.data() + 1),
+                m,
+                simd::as_unaligned_view(b.data() + 1),
+                n,
+                radius_squared,
+                simd::as_unaligned_view(rows.data()),
+                simd::as_unaligned_view(columns.data()),
+                expected.size());
+        ASSERT_EQ(expected.size(), count);
+        EXPECT_EQ(-1, rows[count]);
+        EXPECT_EQ(expected, sorted_pairs(rows, columns, count));
+    }
+}
+
+TEST(pairwise_distance, float) {
+    test_pairwise<float>();
+}
+
+TEST(pairwise_distance, double) {
+    test_pairwise<double>();
+}
+
+TEST(pairwise_distance, capacity) {
+    // every point of a grid with spacing 1 has itself and its direct, but not
+    // its diagonal, neighbours within a radius of 1.2
+    std::vector<vector2f> grid;
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            grid.push_back({float(x), float(y)});
+        }
+    }
+    const auto points = simd::as_unaligned_view(grid.data());
+    const size_t all  = 400 + 4 * 19 * 20;
+
+    std::vector<int32_t> rows(11, -1), columns(11, -1);
+    EXPECT_EQ(
+            all,
+            pairwise_distance_squared(
+                    points,
+                    grid.size(),
+                    points,
+                    grid.size(),
+                    1.2f * 1.2f,
+                    simd::as_unaligned_view(rows.data()),
+                    simd::as_unaligned_view(columns.data()),
+                    10));
+    EXPECT_EQ(-1, rows[10]);
+    EXPECT_EQ(-1, columns[10]);
+    for (size_t k = 0; k < 10; ++k) {
+        const vector2f d = grid[rows[k]] - grid[columns[k]];
+        EXPECT_LT(d.dot(d), 1.2f * 1.2f);
+    }
+}
+
+TEST(pairwise_distance, aligned_views) {
+    constexpr size_t m = 5;
+    constexpr size_t n = 33;
+    simd::aligned_buffer<vector2f, 64> a{m}, b{n};
+    simd::aligned_buffer<float, 64> out{m * n};
+    for (size_t i = 0; i < m; ++i) {
+        a[i] = {float(i), 0.f};
+    }
+    for (size_t j = 0; j < n; ++j) {
+        b[j] = {0.f, float(j)};
+    }
+    pairwise_distance_squared(a.view(), m, b.view(), n, out.view());
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            EXPECT_EQ(float(i * i + j * j), out[i * n + j]);
+        }
+    }
+
+    simd::aligned_buffer<int32_t, 64> rows{n}, columns{n};
+    const size_t count = pairwise_distance_squared(
+            a.view(), m, b.view(), n, 2.5f, rows.view(), columns.view(), n);
+    // (0, 0), (0, 1), (1, 0) and (1, 1)
+    EXPECT_EQ(4u, count);
+}
+
+TEST(pairwise_distance, integral) {
+    std::vector<vector2i> a = {{0, 0}, {3, 4}};
+    std::vector<vector2i> b = {{1, 1}, {0, 0}, {-3, -4}};
+    std::vector<int32_t> out(6);
+    pairwise_distance_squared(
+            simd::as_unaligned_view(a.data()),
+            a.size(),
+            simd::as_unaligned_view(b.data()),
+            b.size(),
+            simd::as_unaligned_view(out.data()));
+    EXPECT_EQ((std::vector<int32_t>{2, 0, 25, 13, 25, 100}), out);
+}
@@ -0,0 +1,248 @@
+#include <simd/math/transcendental.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace simd::math;
+
+namespace {
+
+// floats mapped onto the integers in order, so that the distance between
+// two of them counts the floats in between; both zeros map to 0
+int64_t ordered(float value) {
+    int32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits < 0 ? -int64_t(bits & 0x7fffffff) : int64_t(bits);
+}
+
+// the error of actual in ulp of the correctly rounded result
+int64_t ulp_error(double expected, float actual) {
+    const float rounded = float(expected);
+    if (std::isnan(rounded) || std::isnan(actual)) {
+        return std::isnan(rounded) == std::isnan(actual)
+                       ? 0
+                       : std::numeric_limits<int64_t>::max();
+    }
+    return std::abs(ordered(rounded) - ordered(actual));
+}
+
+float from_bits(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// every step-th bit pattern, which covers every exponent of both signs, and
+// the edges of the ranges
+std::vector<float> all_floats(uint32_t step) {
+    std::vector<float> values;
+    for (uint64_t bits = 0; bits <= 0xffffffff; bits += step) {
+        values.push_back(from_bits(uint32_t(bits)));
+    }
+    for (float value :
+         {0.f,
+          -0.f,
+          std::numeric_limits<float>::infinity(),
+          -std::numeric_limits<float>::infinity(),
+          std::numeric_limits<float>::quiet_NaN(),
+          std::numeric_limits<float>::denorm_min(),
+          std::numeric_limits<float>::min(),
+          std::numeric_limits<float>::max(),
+          88.72f,
+          89.f,
+          -87.33f,
+          -103.97f,
+          -104.f,
+          1.f,
+          -1.f,
+          1048576.f,
+          -1048576.f}) {
+        values.push_back(value);
+    }
+    // whole registers
+    while (values.size() % 8 != 0) {
+        values.push_back(1.f);
+    }
+    return values;
+}
+
+template <typename F, typename Vector, typename Scalar>
+int64_t max_ulp_error(Vector vector_function, Scalar scalar_function) {
+    const auto in = all_floats(4099);
+    std::vector<float> out(in.size());
+    for (size_t i = 0; i < in.size(); i += F::size) {
+        const F x = F::load(
+                simd::as_unaligned_view(const_cast<float*>(&in[i])));
+        vector_function(x).store(simd::as_unaligned_view(&out[i]));
+    }
+    int64_t max_error = 0;
+    for (size_t i = 0; i < in.size(); ++i) {
+        const int64_t error = ulp_error(scalar_function(in[i]), out[i]);
+        EXPECT_LE(error, 2) << "x = " << in[i] << " gave " << out[i];
+        max_error = std::max(max_error, error);
+    }
+    return max_error;
+}
+
+}  // namespace
+
+// against libm in double, which is correctly rounded to float for all but a
+// handful of inputs
+template <typename F>
+void test_unary() {
+    EXPECT_GE(
+            1,
+            max_ulp_error<F>(
+                    [](F x) { return exp(x); },
+                    [](double x) { return std::exp(x); }));
+    EXPECT_GE(
+            1,
+            max_ulp_error<F>(
+                    [](F x) { return log(x); },
+                    [](double x) { return std::log(x); }));
+    EXPECT_GE(
+            2,
+            max_ulp_error<F>(
+                    [](F x) { return sin(x); },
+                    [](double x) { return std::sin(x); }));
+    EXPECT_GE(
+            2,
+            max_ulp_error<F>(
+                    [](F x) { return cos(x); },
+                    [](double x) { return std::cos(x); }));
+    EXPECT_EQ(
+            0,
+            max_ulp_error<F>(
+                    [](F x) { return sqrt(x); },
+                    [](double x) { return std::sqrt(x); }));
+}
+
+TEST(transcendental, unary_f32x4) {
+    test_unary<simd::f32x4>();
+}
+
+TEST(transcendental, unary_f32x8) {
+    test_unary<simd::f32x8>();
+}
+
+// random bit patterns for both arguments, and the signed zeros and
+// infinities against each other
+template <typename F>
+void test_atan2() {
+    std::vector<float> y, x;
+    std::mt19937 rng{7};
+    for (int i = 0; i < 1 << 20; ++i) {
+        y.push_back(from_bits(rng()));
+        x.push_back(from_bits(rng()));
+    }
+    // the same exponent, where the octant reduction matters most
+    std::uniform_real_distribution<float> unit{-1.f, 1.f};
+    for (int i = 0; i < 1 << 20; ++i) {
+        y.push_back(unit(rng));
+        x.push_back(unit(rng));
+    }
+    const float inf = std::numeric_limits<float>::infinity();
+    const float specials[]
+            = {0.f, -0.f, 1.f, -1.f, inf, -inf, 1e-40f, -3e38f};
+    for (float a : specials) {
+        for (float b : specials) {
+            y.push_back(a);
+            x.push_back(b);
+        }
+    }
+    while (y.size() % 8 != 0) {
+        y.push_back(std::numeric_limits<float>::quiet_NaN());
+        x.push_back(1.f);
+    }
+
+    int64_t max_error = 0;
+    for (size_t i = 0; i < y.size(); i += F::size) {
+        float out[F::size];
+        atan2(F::load(simd::as_unaligned_view(&y[i])),
+              F::load(simd::as_unaligned_view(&x[i])))
+                .store(simd::as_unaligned_view(out));
+        for (size_t j = 0; j < F::size; ++j) {
+            const double expected = std::atan2(double(y[i + j]), x[i + j]);
+            const int64_t error   = ulp_error(expected, out[j]);
+            EXPECT_LE(error, 3) << "atan2(" << y[i + j] << ", " << x[i + j]
+                                << ") gave " << out[j];
+            max_error = std::max(max_error, error);
+            if (expected == 0) {
+                EXPECT_EQ(std::signbit(expected), std::signbit(out[j]));
+            }
+        }
+    }
+    EXPECT_GE(3, max_error);
+}
+
+TEST(transcendental, atan2_f32x4) {
+    test_atan2<simd::f32x4>();
+}
+
+TEST(transcendental, atan2_f32x8) {
+    test_atan2<simd::f32x8>();
+}
+
+TEST(transcendental, special_values) {
+    using simd::f32x8;
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    float out[8];
+
+    exp(f32x8::from(-inf, inf, nan, 0.f, -200.f, 200.f, 1.f, -1.f))
+            .store(simd::as_unaligned_view(out));
+    EXPECT_EQ(0.f, out[0]);
+    EXPECT_EQ(inf, out[1]);
+    EXPECT_TRUE(std::isnan(out[2]));
+    EXPECT_EQ(1.f, out[3]);
+    EXPECT_EQ(0.f, out[4]);
+    EXPECT_EQ(inf, out[5]);
+
+    log(f32x8::from(0.f, -0.f, -1.f, inf, -inf, nan, 1.f, 2.f))
+            .store(simd::as_unaligned_view(out));
+    EXPECT_EQ(-inf, out[0]);
+    EXPECT_EQ(-inf, out[1]);
+    EXPECT_TRUE(std::isnan(out[2]));
+    EXPECT_EQ(inf, out[3]);
+    EXPECT_TRUE(std::isnan(out[4]));
+    EXPECT_TRUE(std::isnan(out[5]));
+    EXPECT_EQ(0.f, out[6]);
+
+    sin(f32x8::from(inf, -inf, nan, 0.f, -0.f, 1e30f, 1.f, 2e6f))
+            .store(simd::as_unaligned_view(out));
+    EXPECT_TRUE(std::isnan(out[0]));
+    EXPECT_TRUE(std::isnan(out[1]));
+    EXPECT_TRUE(std::isnan(out[2]));
+    EXPECT_EQ(0.f, out[3]);
+    EXPECT_TRUE(std::signbit(out[4]));
+    EXPECT_EQ(std::sin(1e30f), out[5]);
+    EXPECT_EQ(std::sin(2e6f), out[7]);
+
+    cos(f32x8::from(inf, nan, 0.f, -0.f, 1e30f, 1.f, 2.f, 3.f))
+            .store(simd::as_unaligned_view(out));
+    EXPECT_TRUE(std::isnan(out[0]));
+    EXPECT_TRUE(std::isnan(out[1]));
+    EXPECT_EQ(1.f, out[2]);
+    EXPECT_EQ(1.f, out[3]);
+    EXPECT_EQ(std::cos(1e30f), out[4]);
+
+    atan2(f32x8::from(nan, 1.f, 0.f, -0.f, 0.f, -0.f, inf, -inf),
+          f32x8::from(1.f, nan, 0.f, 0.f, -0.f, -0.f, -inf, inf))
+            .store(simd::as_unaligned_view(out));
+    EXPECT_TRUE(std::isnan(out[0]));
+    EXPECT_TRUE(std::isnan(out[1]));
+    EXPECT_EQ(std::atan2(0.f, 0.f), out[2]);
+    EXPECT_EQ(std::atan2(-0.f, 0.f), out[3]);
+    EXPECT_TRUE(std::signbit(out[3]));
+    EXPECT_FLOAT_EQ(std::atan2(0.f, -0.f), out[4]);
+    EXPECT_FLOAT_EQ(std::atan2(-0.f, -0.f), out[5]);
+    EXPECT_FLOAT_EQ(std::atan2(inf, -inf), out[6]);
+    EXPECT_FLOAT_EQ(std::atan2(-inf, inf), out[7]);
+}
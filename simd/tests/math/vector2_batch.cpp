@@ -0,0 +1,179 @@
+#include <simd/math/vector2_batch.h>
+#include <simd/memory.h>
+
+#include "helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace simd::math;
+using namespace simd::math::test;
+
+namespace {
+
+template <typename T>
+void expect_relative_near(
+        vector2<T> expected, vector2<T> actual, T tolerance) {
+    EXPECT_NEAR(expected.x, actual.x, tolerance * std::fabs(expected.x));
+    EXPECT_NEAR(expected.y, actual.y, tolerance * std::fabs(expected.y));
+}
+
+}  // namespace
+
+// every kernel against the scalar operators, for every tail length and with
+// the views shifted off alignment by one element
+template <typename T>
+void test_elementwise() {
+    const T tolerance = std::is_same_v<T, float> ? 1e-6f : 1e-14;
+    for (size_t n = 0; n <= 40; ++n) {
+        auto a            = random_vectors<vector2<T>>(n + 1, 1);
+        auto b            = random_vectors<vector2<T>>(n + 1, 2);
+        const auto scales = random_vectors<vector2<T>>(n + 1, 3);
+        std::vector<T> s(n + 1);
+        for (size_t i = 0; i <= n; ++i) {
+            s[i] = scales[i].x;
+        }
+        const auto view = [](auto& values) {
+            return simd::as_unaligned_view(values.data() + 1);
+        };
+
+        std::vector<vector2<T>> out(n + 2, vector2<T>{T(7), T(7)});
+        const auto check = [&](auto expected) {
+            EXPECT_EQ(T(7), out[n + 1].x);
+            for (size_t i = 1; i <= n; ++i) {
+                expect_relative_near(expected(i), out[i], tolerance);
+            }
+        };
+
+        add_n(view(a), view(b), view(out), n);
+        check([&](size_t i) { return a[i] + b[i]; });
+        sub_n(view(a), view(b), view(out), n);
+        check([&](size_t i) { return a[i] - b[i]; });
+        scale_n(view(a), T(0.75), view(out), n);
+        check([&](size_t i) { return a[i] * T(0.75); });
+        scale_n(view(a), view(s), view(out), n);
+        check([&](size_t i) { return a[i] * s[i]; });
+        lerp_n(view(a), view(b), T(0.25), view(out), n);
+        check([&](size_t i) { return a[i] + (b[i] - a[i]) * T(0.25); });
+        perp_n(view(a), view(out), n);
+        check([&](size_t i) { return vector2<T>{-a[i].y, a[i].x}; });
+
+        std::vector<T> lengths(n + 2, T(7));
+        length_n(view(a), view(lengths), n);
+        EXPECT_EQ(T(7), lengths[n + 1]);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_NEAR(
+                    std::sqrt(a[i].dot(a[i])),
+                    lengths[i],
+                    tolerance * lengths[i]);
+        }
+        length_squared_n(view(a), view(lengths), n);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_NEAR(a[i].dot(a[i]), lengths[i], tolerance * lengths[i]);
+        }
+
+        // in place
+        const auto original = a;
+        add_n(view(a), view(b), view(a), n);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_EQ(original[i].x + b[i].x, a[i].x);
+            EXPECT_EQ(original[i].y + b[i].y, a[i].y);
+        }
+    }
+}
+
+TEST(vector2_batch, elementwise_float) {
+    test_elementwise<float>();
+}
+
+TEST(vector2_batch, elementwise_double) {
+    test_elementwise<double>();
+}
+
+template <typename T, typename... Mode>
+void test_normalize(T tolerance, Mode... mode) {
+    for (size_t n = 0; n <= 40; ++n) {
+        auto a = random_vectors<vector2<T>>(n + 1, 4);
+        if (n >= 3) {
+            a[3] = {T(0), T(0)};
+        }
+        // a float squared length below FLT_MIN, which the estimate takes as 0
+        if (n >= 5) {
+            a[5] = {T(1e-20), T(0)};
+        }
+        std::vector<vector2<T>> out(n + 2, vector2<T>{T(7), T(7)});
+        normalize_n(
+                simd::as_unaligned_view(a.data() + 1),
+                simd::as_unaligned_view(out.data() + 1),
+                n,
+                mode...);
+        EXPECT_EQ(T(7), out[n + 1].x);
+        for (size_t i = 1; i <= n; ++i) {
+            if (i == 3) {
+                EXPECT_EQ(T(0), out[i].x);
+                EXPECT_EQ(T(0), out[i].y);
+                continue;
+            }
+            const T length = std::sqrt(a[i].dot(a[i]));
+            expect_relative_near(a[i] / length, out[i], tolerance);
+        }
+    }
+}
+
+TEST(vector2_batch, normalize) {
+    test_normalize<float>(1e-6f);
+    test_normalize<double>(1e-14);
+}
+
+TEST(vector2_batch, normalize_approximate) {
+    // one Newton step from the 12 bit estimate
+    test_normalize<float>(1e-6f, approximate);
+    test_normalize<double>(1e-14, approximate);
+}
+
+TEST(vector2_batch, aligned_views) {
+    constexpr size_t n = 37;
+    simd::aligned_buffer<vector2f, 64> a{n}, b{n}, out{n};
+    simd::aligned_buffer<float, 64> lengths{n};
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = {float(i), 1.f};
+        b[i] = {1.f, float(i)};
+    }
+
+    add_n(a.view(), b.view(), out.view(), n);
+    lerp_n(out.view(), b.view(), 0.5f, out.view(), n);
+    scale_n(out.view(), 2.f, out.view(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(float(i) + 2.f, out[i].x);
+        EXPECT_EQ(2.f * float(i) + 1.f, out[i].y);
+    }
+
+    perp_n(a.view(), out.view(), n);
+    normalize_n(out.view(), out.view(), n);
+    length_n(out.view(), lengths.view(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(1.f, lengths[i], 1e-6f);
+    }
+}
+
+TEST(vector2_batch, integral) {
+    std::vector<vector2i> a(19), out(19);
+    std::vector<int32_t> s(19);
+    for (int32_t i = 0; i < 19; ++i) {
+        a[i] = {i, -i};
+        s[i] = i % 3;
+    }
+    const auto to = simd::as_unaligned_view(out.data());
+    scale_n(simd::as_unaligned_view(a.data()),
+            simd::as_unaligned_view(s.data()),
+            to,
+            a.size());
+    perp_n(to, to, out.size());
+    for (int32_t i = 0; i < 19; ++i) {
+        EXPECT_EQ(i * (i % 3), out[i].x);
+        EXPECT_EQ(i * (i % 3), out[i].y);
+    }
+}
@@ -0,0 +1,71 @@
+#include <simd/math/vector2_soa.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace simd::math;
+
+template <typename T>
+void test_container() {
+    vector2_soa<T> soa{37};
+    EXPECT_EQ(37u, soa.size());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(soa.x()) % soa.alignment);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(soa.y()) % soa.alignment);
+
+    for (size_t i = 0; i < soa.size(); ++i) {
+        EXPECT_EQ(T(0), soa[i].x);
+        EXPECT_EQ(T(0), soa[i].y);
+        soa.set(i, {T(i), T(2 * i)});
+    }
+    auto view = soa.view();
+    for (size_t i = 0; i < soa.size(); ++i) {
+        EXPECT_EQ(T(i), soa.x()[i]);
+        EXPECT_EQ(T(2 * i), soa.y()[i]);
+        EXPECT_EQ(T(i), view[i].x);
+        EXPECT_EQ(T(2 * i), view[i].y);
+    }
+
+    vector2_soa<T> moved = std::move(soa);
+    EXPECT_EQ(37u, moved.size());
+    EXPECT_EQ(T(36), moved[36].x);
+}
+
+TEST(vector2_soa, container) {
+    test_container<float>();
+    test_container<double>();
+    test_container<int32_t>();
+}
+
+template <typename T>
+void test_transpose() {
+    for (size_t n = 0; n <= 40; ++n) {
+        // one extra element so that the views are shifted off alignment
+        std::vector<vector2<T>> aos(n + 1);
+        for (size_t i = 0; i <= n; ++i) {
+            aos[i] = {T(i), T(100) - T(i)};
+        }
+
+        auto soa = to_soa(simd::as_unaligned_view(aos.data() + 1), n);
+        ASSERT_EQ(n, soa.size());
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(aos[i + 1].x, soa[i].x);
+            EXPECT_EQ(aos[i + 1].y, soa[i].y);
+        }
+
+        std::vector<vector2<T>> back(n + 1, vector2<T>{T(-1), T(-1)});
+        to_aos(soa, simd::as_unaligned_view(back.data() + 1));
+        EXPECT_EQ(T(-1), back[0].x);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_EQ(aos[i].x, back[i].x);
+            EXPECT_EQ(aos[i].y, back[i].y);
+        }
+    }
+}
+
+TEST(vector2_soa, transpose) {
+    test_transpose<float>();
+    test_transpose<double>();
+    test_transpose<int32_t>();
+}
@@ -0,0 +1,147 @@
+#include <simd/math/vector3.h>
+
+#include <gtest/gtest.h>
+
+template <typename T>
+void TestAddition() {
+    using C = decltype(T::x);
+
+    constexpr T v1 = {.x = C(1.0), .y = C(2.0), .z = C(3.0)};
+    constexpr T v2 = {.x = C(4.0), .y = C(5.0), .z = C(6.0)};
+    {
+        T vec = v1;
+        vec += v2;
+        EXPECT_EQ(vec.x, C(5.0));
+        EXPECT_EQ(vec.y, C(7.0));
+        EXPECT_EQ(vec.z, C(9.0));
+    }
+    {
+        const T vec = v1 + v2;
+        EXPECT_EQ(vec.x, C(5.0));
+        EXPECT_EQ(vec.y, C(7.0));
+        EXPECT_EQ(vec.z, C(9.0));
+    }
+}
+
+TEST(vector3, addition) {
+    TestAddition<simd::math::vector3i>();
+    TestAddition<simd::math::vector3l>();
+    TestAddition<simd::math::vector3f>();
+    TestAddition<simd::math::vector3d>();
+}
+
+template <typename T>
+void TestSubtraction() {
+    using C = decltype(T::x);
+
+    constexpr T v1 = {.x = C(1.0), .y = C(2.0), .z = C(3.0)};
+    constexpr T v2 = {.x = C(4.0), .y = C(6.0), .z = C(8.0)};
+    {
+        T vec = v2;
+        vec -= v1;
+        EXPECT_EQ(vec.x, 3.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 5.0);
+    }
+    {
+        const T vec = v2 - v1;
+        EXPECT_EQ(vec.x, 3.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 5.0);
+    }
+}
+
+TEST(vector3, subtraction) {
+    TestSubtraction<simd::math::vector3i>();
+    TestSubtraction<simd::math::vector3l>();
+    TestSubtraction<simd::math::vector3f>();
+    TestSubtraction<simd::math::vector3d>();
+}
+
+template <typename T>
+void TestMultiplicationByScalar() {
+    using C = decltype(T::x);
+
+    constexpr T v = {.x = C(1.0), .y = C(2.0), .z = C(3.0)};
+    {
+        T vec = v;
+        vec *= 2.0;
+        EXPECT_EQ(vec.x, 2.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 6.0);
+    }
+    {
+        const T vec = v * 2.0;
+        EXPECT_EQ(vec.x, 2.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 6.0);
+    }
+    {
+        const T vec = 2.0 * v;
+        EXPECT_EQ(vec.x, 2.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 6.0);
+    }
+}
+
+TEST(vector3, multiplication) {
+    TestMultiplicationByScalar<simd::math::vector3i>();
+    TestMultiplicationByScalar<simd::math::vector3l>();
+    TestMultiplicationByScalar<simd::math::vector3f>();
+    TestMultiplicationByScalar<simd::math::vector3d>();
+}
+
+template <typename T>
+void TestDivisionByScalar() {
+    using C = decltype(T::x);
+
+    constexpr T v = {.x = C(2.0), .y = C(4.0), .z = C(6.0)};
+    {
+        T vec = v;
+        vec /= 2.0;
+        EXPECT_EQ(vec.x, 1.0);
+        EXPECT_EQ(vec.y, 2.0);
+        EXPECT_EQ(vec.z, 3.0);
+    }
+    {
+        const T vec = v / 2.0;
+        EXPECT_EQ(vec.x, 1.0);
+        EXPECT_EQ(vec.y, 2.0);
+        EXPECT_EQ(vec.z, 3.0);
+    }
+}
+
+TEST(vector3, division) {
+    TestDivisionByScalar<simd::math::vector3i>();
+    TestDivisionByScalar<simd::math::vector3l>();
+    TestDivisionByScalar<simd::math::vector3f>();
+    TestDivisionByScalar<simd::math::vector3d>();
+}
+
+template <typename T>
+void TestProducts() {
+    using C = decltype(T::x);
+
+    constexpr T v1 = {.x = C(1.0), .y = C(2.0), .z = C(3.0)};
+    constexpr T v2 = {.x = C(4.0), .y = C(5.0), .z = C(6.0)};
+    static_assert(v1.dot(v2) == C(32.0));
+
+    constexpr T cross = v1.cross(v2);
+    EXPECT_EQ(cross.x, -3.0);
+    EXPECT_EQ(cross.y, 6.0);
+    EXPECT_EQ(cross.z, -3.0);
+    EXPECT_EQ(cross.dot(v1), 0.0);
+    EXPECT_EQ(cross.dot(v2), 0.0);
+
+    constexpr T x = {.x = C(1.0), .y = C(0.0), .z = C(0.0)};
+    constexpr T y = {.x = C(0.0), .y = C(1.0), .z = C(0.0)};
+    EXPECT_EQ(x.cross(y).z, 1.0);
+    EXPECT_EQ(y.cross(x).z, -1.0);
+}
+
+TEST(vector3, products) {
+    TestProducts<simd::math::vector3i>();
+    TestProducts<simd::math::vector3l>();
+    TestProducts<simd::math::vector3f>();
+    TestProducts<simd::math::vector3d>();
+}
@@ -0,0 +1,130 @@
+#include <simd/math/vector3_batch.h>
+
+#include "helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace simd::math;
+using namespace simd::math::test;
+
+// a block of the kernels spans three registers, so the components of a tail
+// end in the first, second or third of them. The views start one
+// vector3 in, putting every register at a 12 byte offset, and the components
+// right after the tail must keep their sentinels
+template <typename T>
+void test_tails() {
+    const T epsilon = std::is_same_v<T, float> ? 1e-6f : 1e-14;
+    for_each_tail<T>([&](size_t n) {
+        auto a          = random_vectors<vector3<T>>(n + 1, 1);
+        auto b          = random_vectors<vector3<T>>(n + 1, 2);
+        const auto view = [](auto& values) {
+            return simd::as_unaligned_view(values.data() + 1);
+        };
+
+        std::vector<T> products(n + 2, T(7));
+        dot_product_n(view(a), view(b), view(products), n);
+        EXPECT_EQ(T(7), products[n + 1]);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_NEAR(a[i].dot(b[i]), products[i], epsilon * 3e4);
+        }
+
+        std::vector<T> lengths(n + 2, T(7));
+        length_n(view(a), view(lengths), n);
+        EXPECT_EQ(T(7), lengths[n + 1]);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_NEAR(
+                    std::sqrt(a[i].dot(a[i])),
+                    lengths[i],
+                    epsilon * lengths[i]);
+        }
+        length_squared_n(view(a), view(lengths), n);
+        EXPECT_EQ(T(7), lengths[n + 1]);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_NEAR(a[i].dot(a[i]), lengths[i], epsilon * lengths[i]);
+        }
+
+        auto out = sentinels<vector3<T>>(n);
+        cross_n(view(a), view(b), view(out), n);
+        expect_near(vector3<T>{T(7), T(7), T(7)}, out[n + 1], T(0));
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(a[i].cross(b[i]), out[i], T(epsilon * 3e4));
+        }
+
+        // in place
+        const auto original = a;
+        cross_n(view(a), view(b), view(a), n);
+        for (size_t i = 1; i <= n; ++i) {
+            expect_near(original[i].cross(b[i]), a[i], T(epsilon * 3e4));
+        }
+    });
+}
+
+TEST(vector3_batch, tails_float) {
+    test_tails<float>();
+}
+
+TEST(vector3_batch, tails_double) {
+    test_tails<double>();
+}
+
+template <typename T, typename... Mode>
+void test_normalize(T tolerance, Mode... mode) {
+    for_each_tail<T>([&](size_t n) {
+        auto a = random_vectors<vector3<T>>(n + 1, 4);
+        if (n >= 3) {
+            a[3] = {T(0), T(0), T(0)};
+        }
+        auto out = sentinels<vector3<T>>(n);
+        normalize_n(
+                simd::as_unaligned_view(a.data() + 1),
+                simd::as_unaligned_view(out.data() + 1),
+                n,
+                mode...);
+        expect_near(vector3<T>{T(7), T(7), T(7)}, out[n + 1], T(0));
+        for (size_t i = 1; i <= n; ++i) {
+            const T length = std::sqrt(a[i].dot(a[i]));
+            expect_near(
+                    length > 0 ? a[i] / length : vector3<T>{},
+                    out[i],
+                    tolerance);
+        }
+    });
+}
+
+TEST(vector3_batch, normalize) {
+    test_normalize<float>(1e-6f);
+    test_normalize<double>(1e-15);
+}
+
+TEST(vector3_batch, normalize_approximate) {
+    test_normalize<float>(1e-6f, approximate);
+    test_normalize<double>(1e-15, approximate);
+}
+
+TEST(vector3_batch, integral) {
+    std::vector<vector3i> a(19), b(19), out(19);
+    std::vector<int32_t> products(19);
+    for (int32_t i = 0; i < 19; ++i) {
+        a[i] = {i, -i, 1};
+        b[i] = {1, i, i % 3};
+    }
+    dot_product_n(
+            simd::as_unaligned_view(a.data()),
+            simd::as_unaligned_view(b.data()),
+            simd::as_unaligned_view(products.data()),
+            a.size());
+    cross_n(simd::as_unaligned_view(a.data()),
+            simd::as_unaligned_view(b.data()),
+            simd::as_unaligned_view(out.data()),
+            a.size());
+    for (int32_t i = 0; i < 19; ++i) {
+        EXPECT_EQ(i - i * i + i % 3, products[i]);
+        EXPECT_EQ(a[i].cross(b[i]).x, out[i].x);
+        EXPECT_EQ(a[i].cross(b[i]).y, out[i].y);
+        EXPECT_EQ(a[i].cross(b[i]).z, out[i].z);
+    }
+}
@@ -0,0 +1,146 @@
+#include <simd/math/vector4.h>
+
+#include <gtest/gtest.h>
+
+template <typename T>
+void TestAddition() {
+    using C = decltype(T::x);
+
+    constexpr T v1 = {.x = C(1.0), .y = C(2.0), .z = C(3.0), .w = C(4.0)};
+    constexpr T v2 = {.x = C(5.0), .y = C(6.0), .z = C(7.0), .w = C(8.0)};
+    {
+        T vec = v1;
+        vec += v2;
+        EXPECT_EQ(vec.x, C(6.0));
+        EXPECT_EQ(vec.y, C(8.0));
+        EXPECT_EQ(vec.z, C(10.0));
+        EXPECT_EQ(vec.w, C(12.0));
+    }
+    {
+        const T vec = v1 + v2;
+        EXPECT_EQ(vec.x, C(6.0));
+        EXPECT_EQ(vec.y, C(8.0));
+        EXPECT_EQ(vec.z, C(10.0));
+        EXPECT_EQ(vec.w, C(12.0));
+    }
+}
+
+TEST(vector4, addition) {
+    TestAddition<simd::math::vector4i>();
+    TestAddition<simd::math::vector4l>();
+    TestAddition<simd::math::vector4f>();
+    TestAddition<simd::math::vector4d>();
+}
+
+template <typename T>
+void TestSubtraction() {
+    using C = decltype(T::x);
+
+    constexpr T v1 = {.x = C(1.0), .y = C(2.0), .z = C(3.0), .w = C(4.0)};
+    constexpr T v2 = {.x = C(4.0), .y = C(6.0), .z = C(8.0), .w = C(10.0)};
+    {
+        T vec = v2;
+        vec -= v1;
+        EXPECT_EQ(vec.x, 3.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 5.0);
+        EXPECT_EQ(vec.w, 6.0);
+    }
+    {
+        const T vec = v2 - v1;
+        EXPECT_EQ(vec.x, 3.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 5.0);
+        EXPECT_EQ(vec.w, 6.0);
+    }
+}
+
+TEST(vector4, subtraction) {
+    TestSubtraction<simd::math::vector4i>();
+    TestSubtraction<simd::math::vector4l>();
+    TestSubtraction<simd::math::vector4f>();
+    TestSubtraction<simd::math::vector4d>();
+}
+
+template <typename T>
+void TestMultiplicationByScalar() {
+    using C = decltype(T::x);
+
+    constexpr T v = {.x = C(1.0), .y = C(2.0), .z = C(3.0), .w = C(4.0)};
+    {
+        T vec = v;
+        vec *= 2.0;
+        EXPECT_EQ(vec.x, 2.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 6.0);
+        EXPECT_EQ(vec.w, 8.0);
+    }
+    {
+        const T vec = v * 2.0;
+        EXPECT_EQ(vec.x, 2.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 6.0);
+        EXPECT_EQ(vec.w, 8.0);
+    }
+    {
+        const T vec = 2.0 * v;
+        EXPECT_EQ(vec.x, 2.0);
+        EXPECT_EQ(vec.y, 4.0);
+        EXPECT_EQ(vec.z, 6.0);
+        EXPECT_EQ(vec.w, 8.0);
+    }
+}
+
+TEST(vector4, multiplication) {
+    TestMultiplicationByScalar<simd::math::vector4i>();
+    TestMultiplicationByScalar<simd::math::vector4l>();
+    TestMultiplicationByScalar<simd::math::vector4f>();
+    TestMultiplicationByScalar<simd::math::vector4d>();
+}
+
+template <typename T>
+void TestDivisionByScalar() {
+    using C = decltype(T::x);
+
+    constexpr T v = {.x = C(2.0), .y = C(4.0), .z = C(6.0), .w = C(8.0)};
+    {
+        T vec = v;
+        vec /= 2.0;
+        EXPECT_EQ(vec.x, 1.0);
+        EXPECT_EQ(vec.y, 2.0);
+        EXPECT_EQ(vec.z, 3.0);
+        EXPECT_EQ(vec.w, 4.0);
+    }
+    {
+        const T vec = v / 2.0;
+        EXPECT_EQ(vec.x, 1.0);
+        EXPECT_EQ(vec.y, 2.0);
+        EXPECT_EQ(vec.z, 3.0);
+        EXPECT_EQ(vec.w, 4.0);
+    }
+}
+
+TEST(vector4, division) {
+    TestDivisionByScalar<simd::math::vector4i>();
+    TestDivisionByScalar<simd::math::vector4l>();
+    TestDivisionByScalar<simd::math::vector4f>();
+    TestDivisionByScalar<simd::math::vector4d>();
+}
+
+
+template <typename T>
+void TestDotProduct() {
+    using C = decltype(T::x);
+
+    constexpr T v1 = {.x = C(1.0), .y = C(2.0), .z = C(3.0), .w = C(4.0)};
+    constexpr T v2 = {.x = C(5.0), .y = C(6.0), .z = C(7.0), .w = C(8.0)};
+    static_assert(v1.dot(v2) == C(70.0));
+    EXPECT_EQ(v1.dot(v1), 30.0);
+}
+
+TEST(vector4, dot_product) {
+    TestDotProduct<simd::math::vector4i>();
+    TestDotProduct<simd::math::vector4l>();
+    TestDotProduct<simd::math::vector4f>();
+    TestDotProduct<simd::math::vector4d>();
+}
@@ -0,0 +1,128 @@
+#include <simd/math/vector4_batch.h>
+#include <simd/memory.h>
+
+#include "helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace simd::math;
+using namespace simd::math::test;
+
+// a block of the dot products spans four registers of whole vector4, so the
+// components of a tail end in any of them; normalize_n goes two vector4 per
+// register instead. The views start one vector4 in and the elements right
+// after the tail must keep their sentinels
+template <typename T>
+void test_tails() {
+    const T epsilon = std::is_same_v<T, float> ? 1e-6f : 1e-14;
+    for_each_tail<T>([&](size_t n) {
+        auto a          = random_vectors<vector4<T>>(n + 1, 1);
+        auto b          = random_vectors<vector4<T>>(n + 1, 2);
+        const auto view = [](auto& values) {
+            return simd::as_unaligned_view(values.data() + 1);
+        };
+
+        std::vector<T> products(n + 2, T(7));
+        dot_product_n(view(a), view(b), view(products), n);
+        EXPECT_EQ(T(7), products[n + 1]);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_NEAR(a[i].dot(b[i]), products[i], epsilon * 4e4);
+        }
+
+        std::vector<T> lengths(n + 2, T(7));
+        length_n(view(a), view(lengths), n);
+        EXPECT_EQ(T(7), lengths[n + 1]);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_NEAR(
+                    std::sqrt(a[i].dot(a[i])),
+                    lengths[i],
+                    epsilon * lengths[i]);
+        }
+        length_squared_n(view(a), view(lengths), n);
+        EXPECT_EQ(T(7), lengths[n + 1]);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_NEAR(a[i].dot(a[i]), lengths[i], epsilon * lengths[i]);
+        }
+    });
+}
+
+TEST(vector4_batch, tails_float) {
+    test_tails<float>();
+}
+
+TEST(vector4_batch, tails_double) {
+    test_tails<double>();
+}
+
+template <typename T, typename... Mode>
+void test_normalize(T tolerance, Mode... mode) {
+    for_each_tail<T>([&](size_t n) {
+        auto a = random_vectors<vector4<T>>(n + 1, 4);
+        if (n >= 3) {
+            a[3] = {T(0), T(0), T(0), T(0)};
+        }
+        auto out = sentinels<vector4<T>>(n);
+        normalize_n(
+                simd::as_unaligned_view(a.data() + 1),
+                simd::as_unaligned_view(out.data() + 1),
+                n,
+                mode...);
+        expect_near(vector4<T>{T(7), T(7), T(7), T(7)}, out[n + 1], T(0));
+        for (size_t i = 1; i <= n; ++i) {
+            const T length = std::sqrt(a[i].dot(a[i]));
+            expect_near(
+                    length > 0 ? a[i] / length : vector4<T>{},
+                    out[i],
+                    tolerance);
+        }
+    });
+}
+
+TEST(vector4_batch, normalize) {
+    test_normalize<float>(1e-6f);
+    test_normalize<double>(1e-15);
+}
+
+TEST(vector4_batch, normalize_approximate) {
+    test_normalize<float>(1e-6f, approximate);
+    test_normalize<double>(1e-15, approximate);
+}
+
+TEST(vector4_batch, aligned_views) {
+    constexpr size_t n = 37;
+    simd::aligned_buffer<vector4f, 64> a{n}, out{n};
+    simd::aligned_buffer<float, 64> lengths{n};
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = {float(i), 1.f, -float(i), 2.f};
+    }
+
+    dot_product_n(a.view(), a.view(), lengths.view(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(2.f * float(i * i) + 5.f, lengths[i]);
+    }
+
+    normalize_n(a.view(), out.view(), n);
+    length_n(out.view(), lengths.view(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(1.f, lengths[i], 1e-6f);
+    }
+}
+
+TEST(vector4_batch, integral) {
+    std::vector<vector4i> a(19);
+    std::vector<int32_t> products(19);
+    for (int32_t i = 0; i < 19; ++i) {
+        a[i] = {i, -i, 1, i % 3};
+    }
+    length_squared_n(
+            simd::as_unaligned_view(a.data()),
+            simd::as_unaligned_view(products.data()),
+            a.size());
+    for (int32_t i = 0; i < 19; ++i) {
+        EXPECT_EQ(2 * i * i + 1 + (i % 3) * (i % 3), products[i]);
+    }
+}
@@ -0,0 +1,226 @@
+#include <simd/memory.h>
+#include <simd/math/vector2.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <new>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+template <typename T, size_t Alignment>
+bool is_aligned(const T* ptr) {
+    return reinterpret_cast<uintptr_t>(ptr) % Alignment == 0;
+}
+
+TEST(aligned_alloc, throws_on_failure) {
+    EXPECT_THROW(simd::aligned_alloc<char>(64, SIZE_MAX / 2), std::bad_alloc);
+}
+
+TEST(aligned_buffer, basics) {
+    simd::aligned_buffer<float, 32> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(0u, empty.size());
+    EXPECT_EQ(nullptr, empty.data());
+
+    simd::aligned_buffer<float, 32> buffer{13};
+    EXPECT_EQ(13u, buffer.size());
+    EXPECT_EQ(16u, buffer.capacity());
+    EXPECT_TRUE((is_aligned<float, 32>(buffer.data())));
+
+    std::iota(buffer.begin(), buffer.end(), 0.f);
+    EXPECT_EQ(12.f, buffer[12]);
+    EXPECT_EQ(13, buffer.end() - buffer.begin());
+}
+
+TEST(aligned_buffer, padding) {
+    for (size_t n = 0; n <= 20; ++n) {
+        simd::aligned_buffer<int32_t, 64> padded{n, simd::zero_padding};
+        EXPECT_EQ((n + 15) / 16 * 16, padded.capacity());
+        for (size_t i = n; i < padded.capacity(); ++i) {
+            EXPECT_EQ(0, padded.data()[i]);
+        }
+
+        simd::aligned_buffer<int32_t, 64> zeroed{n, simd::zero_fill};
+        for (size_t i = 0; i < zeroed.capacity(); ++i) {
+            EXPECT_EQ(0, zeroed.data()[i]);
+        }
+    }
+}
+
+TEST(aligned_buffer, move) {
+    simd::aligned_buffer<double, 32> buffer{5, simd::zero_fill};
+    buffer[4]       = 3.0;
+    const auto* ptr = buffer.data();
+
+    simd::aligned_buffer<double, 32> moved{std::move(buffer)};
+    EXPECT_EQ(ptr, moved.data());
+    EXPECT_EQ(5u, moved.size());
+    EXPECT_EQ(3.0, moved[4]);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(nullptr, buffer.data());
+
+    simd::aligned_buffer<double, 32> assigned{1};
+    assigned = std::move(moved);
+    EXPECT_EQ(ptr, assigned.data());
+    EXPECT_TRUE(moved.empty());
+
+    static_assert(
+            !std::is_copy_constructible_v<simd::aligned_buffer<double, 32>>);
+}
+
+TEST(aligned_buffer, views) {
+    simd::aligned_buffer<simd::math::vector2f, 64> buffer{4};
+
+    using vector2f = simd::math::vector2f;
+
+    simd::aligned_view<vector2f, 64> view     = buffer.view();
+    simd::aligned_view<vector2f, 32> narrower = buffer;
+    auto unaligned = static_cast<simd::unaligned_view<vector2f>>(buffer);
+    EXPECT_EQ(buffer.data(), view.get());
+    EXPECT_EQ(buffer.data(), narrower.get());
+    EXPECT_EQ(buffer.data(), unaligned.get());
+}
+
+TEST(aligned_allocator, vector) {
+    std::vector<float, simd::aligned_allocator<float, 32>> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(float(i));
+        ASSERT_TRUE((is_aligned<float, 32>(values.data())));
+    }
+    EXPECT_EQ(999.f, values.back());
+
+    std::vector<double, simd::aligned_allocator<double>> wide(7, 1.0);
+    EXPECT_TRUE((is_aligned<double, 64>(wide.data())));
+    EXPECT_EQ(7.0, std::accumulate(wide.begin(), wide.end(), 0.0));
+}
+
+TEST(map_pages, falls_back) {
+    const size_t size = 3 << 20;
+    for (auto pages :
+         {simd::page_size::standard,
+          simd::page_size::transparent,
+          simd::page_size::huge_2m,
+          simd::page_size::huge_1g}) {
+        auto mapping = simd::map_pages(size, {pages});
+        ASSERT_NE(nullptr, mapping.data);
+        EXPECT_GE(mapping.size, size);
+        EXPECT_LE(mapping.pages, pages);
+        EXPECT_TRUE((is_aligned<char, 4096>(
+                static_cast<char*>(mapping.data))));
+
+        auto* bytes = static_cast<char*>(mapping.data);
+        EXPECT_EQ(0, bytes[0]);
+        EXPECT_EQ(0, bytes[size - 1]);
+        bytes[size - 1] = 1;
+        simd::unmap_pages(mapping.data, mapping.size);
+    }
+}
+
+TEST(map_pages, numa_node) {
+    auto bound = simd::map_pages(1 << 16, {simd::page_size::standard, 0});
+    ASSERT_NE(nullptr, bound.data);
+    simd::unmap_pages(bound.data, bound.size);
+
+    // a node that does not exist still maps, just without a binding
+    auto missing = simd::map_pages(
+            1 << 16, {simd::page_size::standard, simd::numa_node_count()});
+    ASSERT_NE(nullptr, missing.data);
+    EXPECT_FALSE(missing.numa_bound);
+    simd::unmap_pages(missing.data, missing.size);
+}
+
+TEST(aligned_buffer, mapped) {
+    simd::aligned_buffer<float, 64> buffer{
+            1000, simd::page_options{simd::page_size::huge_2m}};
+    EXPECT_EQ(1000u, buffer.size());
+    EXPECT_TRUE((is_aligned<float, 64>(buffer.data())));
+
+    simd::first_touch(simd::unaligned_view<float>(buffer), buffer.size(), 4);
+    EXPECT_EQ(0.f, buffer[999]);
+    std::iota(buffer.begin(), buffer.end(), 0.f);
+
+    auto moved = std::move(buffer);
+    EXPECT_EQ(999.f, moved[999]);
+    EXPECT_EQ(simd::page_size::standard,
+              simd::aligned_buffer<float>{4}.pages());
+}
+
+TEST(first_touch, slices) {
+    std::vector<int> values(100000, 7);
+    simd::first_touch(
+            simd::unaligned_view<int>{values.data()}, values.size() - 1, 3);
+    EXPECT_EQ(0, values[0]);
+    EXPECT_EQ(0, values[values.size() - 2]);
+    EXPECT_EQ(7, values.back());
+
+    // more threads than pages
+    std::vector<int> small(8, 7);
+    simd::first_touch(simd::unaligned_view<int>{small.data()}, 5, 64);
+    EXPECT_EQ(0, small[4]);
+    EXPECT_EQ(7, small[5]);
+}
+
+TEST(arena, bump_allocation) {
+    simd::arena scratch{1024};
+
+    auto floats = scratch.allocate<float, 32>(10);
+    auto bytes  = scratch.allocate<char, 1>(3);
+    auto wide   = scratch.allocate<double, 128>(4);
+    EXPECT_TRUE((is_aligned<float, 32>(floats.get())));
+    EXPECT_TRUE((is_aligned<double, 128>(wide.get())));
+    EXPECT_GE(reinterpret_cast<char*>(bytes.get()),
+              reinterpret_cast<char*>(floats.get() + 10));
+    EXPECT_GE(reinterpret_cast<char*>(wide.get()), bytes.get() + 3);
+    EXPECT_EQ(1u, scratch.block_count());
+
+    for (int i = 0; i < 10; ++i) {
+        floats[i] = float(i);
+    }
+    EXPECT_EQ(9.f, floats[9]);
+}
+
+TEST(arena, grows_and_reuses_blocks) {
+    simd::arena scratch{1024};
+
+    // larger than a block
+    auto big = scratch.allocate<float>(1000);
+    EXPECT_TRUE((is_aligned<float, 64>(big.get())));
+    scratch.allocate<float>(100);
+    const size_t blocks = scratch.block_count();
+    EXPECT_GE(blocks, 2u);
+
+    scratch.reset();
+    EXPECT_EQ(big.get(), scratch.allocate<float>(1000).get());
+    scratch.allocate<float>(100);
+    EXPECT_EQ(blocks, scratch.block_count());
+
+    scratch.release();
+    EXPECT_EQ(0u, scratch.block_count());
+}
+
+TEST(arena, marks) {
+    simd::arena scratch{4096};
+    scratch.allocate<float>(3);
+
+    const auto mark = scratch.get_mark();
+    auto first      = scratch.allocate<float>(8);
+    {
+        simd::arena_scope scope{scratch};
+        auto nested = scratch.allocate<float>(8);
+        EXPECT_NE(first.get(), nested.get());
+    }
+    EXPECT_NE(first.get(), scratch.allocate<float>(8).get());
+
+    scratch.rewind(mark);
+    EXPECT_EQ(first.get(), scratch.allocate<float>(8).get());
+}
+
+TEST(arena, thread_local) {
+    auto* main_arena   = &simd::thread_arena();
+    simd::arena* other = nullptr;
+    std::thread([&] { other = &simd::thread_arena(); }).join();
+    EXPECT_NE(main_arena, other);
+    EXPECT_EQ(main_arena, &simd::thread_arena());
+}
@@ -0,0 +1,84 @@
+#include <simd/thread_pool.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(thread_pool, covers_every_index_once) {
+    simd::thread_pool pool{4};
+    EXPECT_EQ(4u, pool.concurrency());
+
+    for (size_t n : {0, 1, 63, 64, 65, 1000, 100000}) {
+        std::vector<std::atomic<int>> visits(n);
+        std::atomic<bool> misaligned{false};
+        pool.parallel_for(n, 64, [&](size_t begin, size_t end) {
+            if (begin % 64 != 0 || (end != n && end % 64 != 0)) {
+                misaligned = true;
+            }
+            for (size_t i = begin; i < end; ++i) {
+                ++visits[i];
+            }
+        });
+        EXPECT_FALSE(misaligned) << "n=" << n;
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(1, visits[i]) << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+TEST(thread_pool, uses_several_threads) {
+    simd::thread_pool pool{4};
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    pool.parallel_for(64, 1, [&](size_t, size_t) {
+        {
+            std::lock_guard lock{mutex};
+            threads.insert(std::this_thread::get_id());
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    EXPECT_GT(threads.size(), 1u);
+}
+
+TEST(thread_pool, nested_calls_run_serially) {
+    simd::thread_pool pool{3};
+    std::atomic<size_t> total{0};
+    pool.parallel_for(8, 1, [&](size_t, size_t) {
+        pool.parallel_for(100, 10, [&](size_t begin, size_t end) {
+            total += end - begin;
+        });
+    });
+    EXPECT_EQ(800u, total);
+}
+
+TEST(thread_pool, concurrent_callers) {
+    simd::thread_pool pool{4};
+    std::atomic<size_t> total{0};
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 4; ++t) {
+        callers.emplace_back([&] {
+            for (int repeat = 0; repeat < 50; ++repeat) {
+                pool.parallel_for(1000, 16, [&](size_t begin, size_t end) {
+                    total += end - begin;
+                });
+            }
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(4u * 50u * 1000u, total);
+}
+
+TEST(thread_pool, single_thread) {
+    simd::thread_pool pool{1};
+    std::vector<size_t> calls;
+    pool.parallel_for(
+            1000, 10, [&](size_t, size_t end) { calls.push_back(end); });
+    EXPECT_EQ(std::vector<size_t>{1000}, calls);
+}
@@ -165,3 +165,44 @@ TEST(unaligned_view, addition_subtraction) {
         EXPECT_EQ(simd::as_unaligned_view(&i + 8).get(), (ptr + 8).get());
     }
 }
+
+TEST(view, prefetch) {
+    alignas(64) int32_t values[64] = {};
+    simd::prefetch(simd::as_aligned_view<64>(values), 16);
+    simd::prefetch<simd::prefetch_hint::nta>(
+            simd::as_unaligned_view(values), 1 << 20);
+
+    const size_t distance = simd::prefetch_distance();
+    simd::set_prefetch_distance(256);
+    EXPECT_EQ(256u, simd::prefetch_distance());
+    simd::set_prefetch_distance(distance);
+}
+
+TEST(strided_view, records) {
+    struct record {
+        int32_t id;
+        float weight;
+        double value;
+    };
+    record records[4] = {{0, 0.5f, 1.0}, {1, 1.5f, 2.0}, {2, 2.5f, 3.0}};
+
+    auto values = simd::as_strided_view(records, &record::value);
+    EXPECT_EQ(sizeof(record), values.stride);
+    EXPECT_EQ(2.0, values[1]);
+    EXPECT_EQ(3.0, (values + 2)[0]);
+    values[3] = 4.0;
+    EXPECT_EQ(4.0, records[3].value);
+
+    auto weights = simd::as_strided_view(&records[0].weight, sizeof(record));
+    EXPECT_EQ(2.5f, weights[2]);
+}
+
+TEST(indexed_view, indices) {
+    int32_t values[]        = {10, 11, 12, 13};
+    const int32_t indices[] = {3, 0, 0, 2};
+
+    auto view = simd::as_indexed_view(values, indices);
+    EXPECT_EQ(13, view[0]);
+    EXPECT_EQ(10, view[2]);
+    EXPECT_EQ(12, (view + 3)[0]);
+}